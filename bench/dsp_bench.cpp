@@ -0,0 +1,178 @@
+// dsp/ filters against straightforward float versions of the same filter.
+// Every iteration filters one 32-sample block, so cycles per sample = median / 32.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "dsp/biquad.hpp"
+#include "dsp/exponential.hpp"
+#include "dsp/fir.hpp"
+#include "dsp/fixed_point.hpp"
+#include "dsp/moving_median.hpp"
+#include "dsp/pid.hpp"
+#include "util/benchmark.hpp"
+
+static constexpr std::size_t kBlock = 32;
+
+static std::uint16_t adc_block[kBlock];
+static dsp::q15_t q15_in[kBlock];
+static dsp::q15_t q15_out[kBlock];
+static dsp::q31_t q31_in[kBlock];
+static dsp::q31_t q31_out[kBlock];
+static float float_in[kBlock];
+static float float_out[kBlock];
+
+// A noisy ramp in ADC counts, shared by every benchmark
+static void FillInputs() {
+    std::uint32_t noise = 0x1234'5678;
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        noise = noise * 1664525U + 1013904223U;
+        adc_block[i] = static_cast<std::uint16_t>((1000U + i * 64U + (noise >> 26)) & 0x0FFFU);
+    }
+    dsp::AdcToQ15(adc_block, q15_in, kBlock);
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        q31_in[i] = static_cast<dsp::q31_t>(static_cast<std::uint32_t>(q15_in[i]) << 16) >> 1;  // 1 bit headroom
+        float_in[i] = dsp::Q15ToFloat(q15_in[i]);
+    }
+}
+
+static constexpr awb::BenchFixture kInputs = {FillInputs, nullptr, nullptr};
+
+// -----------------------------------------------------------------------------
+// Conversion
+// -----------------------------------------------------------------------------
+AWB_BENCHMARK_F(AdcToQ15_32, kInputs) {
+    dsp::AdcToQ15(adc_block, q15_out, kBlock);
+    awb::DoNotOptimize(q15_out);
+}
+
+// -----------------------------------------------------------------------------
+// FIR, 16 taps
+// -----------------------------------------------------------------------------
+static constexpr std::array<float, 16> kFirTaps = {0.0078f, 0.0156f, 0.0313f, 0.0469f, 0.0625f, 0.0781f,
+                                                   0.0938f, 0.1094f, 0.1094f, 0.0938f, 0.0781f, 0.0625f,
+                                                   0.0469f, 0.0313f, 0.0156f, 0.0078f};
+
+static constexpr std::array<dsp::q15_t, 16> ToQ15(const std::array<float, 16>& taps) {
+    std::array<dsp::q15_t, 16> q{};
+    for (std::size_t k = 0; k < taps.size(); ++k) {
+        q[k] = dsp::FloatToQ15(taps[k]);
+    }
+    return q;
+}
+
+static dsp::FirQ15<16> fir_q15(ToQ15(kFirTaps));
+
+AWB_BENCHMARK_F(FirQ15x16_32, kInputs) {
+    fir_q15.Process(q15_in, q15_out, kBlock);
+    awb::DoNotOptimize(q15_out);
+}
+
+static float fir_float_state[16];
+
+AWB_BENCHMARK_F(FirFloatx16_32, kInputs) {
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        for (std::size_t k = 15; k > 0; --k) {
+            fir_float_state[k] = fir_float_state[k - 1];
+        }
+        fir_float_state[0] = float_in[i];
+
+        float acc = 0.0f;
+        for (std::size_t k = 0; k < 16; ++k) {
+            acc += kFirTaps[k] * fir_float_state[k];
+        }
+        float_out[i] = acc;
+    }
+    awb::DoNotOptimize(float_out);
+}
+
+// -----------------------------------------------------------------------------
+// Biquad, 4th-order Butterworth low-pass at fs/20 (two sections)
+// -----------------------------------------------------------------------------
+static constexpr dsp::BiquadCoefficients kLowPass[2] = {
+    {0.00482434f, 0.00964869f, 0.00482434f, -1.04859958f, 0.29614036f},
+    {1.0f, 2.0f, 1.0f, -1.32091343f, 0.63273879f},
+};
+
+static dsp::BiquadQ15<2> biquad_q15(kLowPass);
+static dsp::BiquadQ31<2> biquad_q31(kLowPass);
+
+AWB_BENCHMARK_F(BiquadQ15x2_32, kInputs) {
+    biquad_q15.Process(q15_in, q15_out, kBlock);
+    awb::DoNotOptimize(q15_out);
+}
+
+AWB_BENCHMARK_F(BiquadQ31x2_32, kInputs) {
+    biquad_q31.Process(q31_in, q31_out, kBlock);
+    awb::DoNotOptimize(q31_out);
+}
+
+static float biquad_float_state[2][4];
+
+AWB_BENCHMARK_F(BiquadFloatx2_32, kInputs) {
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        float x = float_in[i];
+        for (std::size_t s = 0; s < 2; ++s) {
+            const dsp::BiquadCoefficients& c = kLowPass[s];
+            float* z = biquad_float_state[s];
+            const float y = c.b0 * x + c.b1 * z[0] + c.b2 * z[1] - c.a1 * z[2] - c.a2 * z[3];
+            z[1] = z[0];
+            z[0] = x;
+            z[3] = z[2];
+            z[2] = y;
+            x = y;
+        }
+        float_out[i] = x;
+    }
+    awb::DoNotOptimize(float_out);
+}
+
+// -----------------------------------------------------------------------------
+// Exponential and median
+// -----------------------------------------------------------------------------
+static dsp::Exponential<dsp::q15_t> ema_q15(0.05f);
+
+AWB_BENCHMARK_F(ExponentialQ15_32, kInputs) {
+    ema_q15.Process(q15_in, q15_out, kBlock);
+    awb::DoNotOptimize(q15_out);
+}
+
+static float ema_float = 0.0f;
+
+AWB_BENCHMARK_F(ExponentialFloat_32, kInputs) {
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        ema_float += 0.05f * (float_in[i] - ema_float);
+        float_out[i] = ema_float;
+    }
+    awb::DoNotOptimize(float_out);
+}
+
+static dsp::MovingMedian<dsp::q15_t, 5> median_q15;
+
+AWB_BENCHMARK_F(MovingMedian5_32, kInputs) {
+    median_q15.Process(q15_in, q15_out, kBlock);
+    awb::DoNotOptimize(q15_out);
+}
+
+// -----------------------------------------------------------------------------
+// PID, all terms on, the noisy ramp as the measurement (one Update() per sample)
+// -----------------------------------------------------------------------------
+static constexpr dsp::PidGains kPidGains = {.kp = 0.8f, .ki = 20.0f, .kd = 0.002f, .derivative_hz = 200.0f};
+
+static dsp::Pid<dsp::q31_t> pid_q31(kPidGains, 1000.0f, INT32_MIN, INT32_MAX);
+static dsp::Pid<float> pid_float(kPidGains, 1000.0f, -1.0f, 1.0f);
+
+AWB_BENCHMARK_F(PidQ31_32, kInputs) {
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        q31_out[i] = pid_q31.Update(0, q31_in[i]);
+    }
+    awb::DoNotOptimize(q31_out);
+}
+
+AWB_BENCHMARK_F(PidFloat_32, kInputs) {
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        float_out[i] = pid_float.Update(0.0f, float_in[i]);
+    }
+    awb::DoNotOptimize(float_out);
+}
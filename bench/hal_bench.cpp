@@ -0,0 +1,99 @@
+// Starter benchmarks for hal/. Run with env:native_bench or env:nucleo_l476rg_bench.
+// Expects the CubeMX peripherals (hadc1) initialized and not yet started by the application.
+
+#include <cstdint>
+
+#include "adc.h"
+#include "board_defs.hpp"
+#include "hal/adc.hpp"
+#include "hal/exti.hpp"
+#include "util/benchmark.hpp"
+
+#ifdef AWB_SIM_HAL
+#include "sim_hal.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+// GPIO
+// -----------------------------------------------------------------------------
+AWB_BENCHMARK(FastGpioToggle) {
+    board::pins::StatusLed::Toggle();
+}
+
+AWB_BENCHMARK(HalGpioToggle) {
+    HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5);
+}
+
+// -----------------------------------------------------------------------------
+// EXTI
+// -----------------------------------------------------------------------------
+// EXTI line 0 is unused by the application and its NVIC vector is disabled, so a
+// software-raised pending bit is only serviced by the dispatch under test.
+using BenchLine = hal::FastGpio<GPIOA_BASE, GPIO_PIN_0>;
+
+static volatile std::uint32_t exti_hits = 0;
+
+static void OnBenchLine() {
+    exti_hits = exti_hits + 1;
+}
+
+static void RaiseBenchLine() {
+#ifdef AWB_SIM_HAL
+    sim::exti.PR1.Raise(BenchLine::kPin);
+#else
+    EXTI->SWIER1 = BenchLine::kPin;
+#endif
+}
+
+static void UnmaskBenchLine() {
+    EXTI->IMR1 |= BenchLine::kPin;
+    BenchLine::AttachInterrupt(OnBenchLine);
+}
+
+static void MaskBenchLine() {
+    EXTI->IMR1 &= ~BenchLine::kPin;
+    EXTI->PR1 = BenchLine::kPin;
+    BenchLine::AttachInterrupt(nullptr);
+}
+
+static constexpr awb::BenchFixture kExtiFixture = {UnmaskBenchLine, RaiseBenchLine, MaskBenchLine};
+
+// AWB_EXTI_DISPATCH() path: one PR1 read, one clear, direct call
+AWB_BENCHMARK_F(ExtiDispatchInline, kExtiFixture) {
+    hal::ExtiDispatcher<BenchLine::Interrupt<OnBenchLine>>::Dispatch<GPIO_PIN_0>();
+}
+
+// HAL path: HAL_GPIO_EXTI_IRQHandler -> HAL_GPIO_EXTI_Callback -> callback table
+AWB_BENCHMARK_F(ExtiDispatchHal, kExtiFixture) {
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
+}
+
+// -----------------------------------------------------------------------------
+// ADC
+// -----------------------------------------------------------------------------
+static hal::Adc<std::uint16_t> bench_adc(hadc1);
+static std::uint16_t bench_adc_data[16];
+
+static void StartBenchAdc() {
+    bench_adc.StartStreaming(bench_adc_data, 16);
+#ifdef AWB_SIM_HAL
+    sim::SetAdcWaveform(hadc1, [](std::uint32_t n) { return 2000U + (n % 16U); });
+    sim::RunAdc(hadc1, 32);
+#else
+    HAL_Delay(5);  // Let a few DMA blocks publish a snapshot
+#endif
+}
+
+static void StopBenchAdc() {
+    bench_adc.Stop();
+}
+
+static constexpr awb::BenchFixture kAdcFixture = {StartBenchAdc, nullptr, StopBenchAdc};
+
+AWB_BENCHMARK_F(AdcRead, kAdcFixture) {
+    awb::DoNotOptimize(bench_adc.Read());
+}
+
+AWB_BENCHMARK_F(AdcReadAverage, kAdcFixture) {
+    awb::DoNotOptimize(bench_adc.ReadAverage());
+}
@@ -0,0 +1,38 @@
+// Host entry point for env:native_bench: runs every registered benchmark against
+// the simulated HAL and prints the report to stdout.
+
+#include <cstdio>
+
+#include "adc.h"
+#include "gpio.h"
+#include "hal/uart.hpp"
+#include "sim_hal.hpp"
+#include "usart.h"
+#include "util/benchmark.hpp"
+#include "util/logger.hpp"
+
+int main() {
+    sim::Reset();
+    MX_GPIO_Init();
+    MX_ADC1_Init();
+    MX_USART2_UART_Init();
+
+    hal::Uart console_uart(huart2, hal::UartMode::Dma);
+    Logger& logger = Logger::GetInstance();
+    logger.Init(&console_uart);
+
+    awb::RunBenchmarks(logger);
+    console_uart.Flush(10);
+
+    // Only the report; benchmark bodies that log would otherwise interleave with it. Deferred
+    // log frames carry no newline, so a report line can follow one on the same line.
+    const std::string& output = sim::UartOutput(huart2);
+    std::size_t start = output.find("BENCH,");
+    while (start != std::string::npos) {
+        std::size_t end = output.find('\n', start);
+        end = (end == std::string::npos) ? output.size() : end + 1;
+        std::fwrite(output.data() + start, 1, end - start, stdout);
+        start = output.find("BENCH,", end);
+    }
+    return 0;
+}
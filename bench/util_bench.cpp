@@ -0,0 +1,74 @@
+// Starter benchmarks for util/. Run with env:native_bench or env:nucleo_l476rg_bench.
+
+#include <cinttypes>
+#include <cstdint>
+
+#include "util/benchmark.hpp"
+#include "util/deferred_log.hpp"
+#include "util/logger.hpp"
+#include "util/motion_profile.hpp"
+#include "util/ring_buffer.hpp"
+
+// Lets the console drain so every iteration sees an empty TX ring (and no drops)
+static void DrainConsole() {
+    if (hal::Uart* uart = Logger::GetInstance().GetTransport()) {
+        uart->Flush(10);
+    }
+}
+
+static constexpr awb::BenchFixture kConsoleFixture = {nullptr, DrainConsole, DrainConsole};
+
+static volatile std::uint32_t bench_counter = 12345;
+
+// Formats on the CPU, then queues the text
+AWB_BENCHMARK_F(LoggerLogf, kConsoleFixture) {
+    Logger::GetInstance().Logf("bench %" PRIu32 " %d\r\n", bench_counter, -42);
+}
+
+// Same record through AWB_LOGF(); only differs from LoggerLogf with AWB_LOG_DEFERRED (the *_bench_deferred envs)
+AWB_BENCHMARK_F(AwbLogf, kConsoleFixture) {
+    AWB_LOGF("bench %" PRIu32 " %d\r\n", bench_counter, -42);
+}
+
+static awb::RingBuffer<std::uint8_t, 256> ring;
+static std::uint8_t ring_block[16];
+
+static void EmptyRing() {
+    std::uint8_t sink[16];
+    while (ring.Pop(sink, sizeof(sink)) != 0) {
+    }
+}
+
+static constexpr awb::BenchFixture kRingFixture = {EmptyRing, EmptyRing, nullptr};
+
+AWB_BENCHMARK_F(RingBufferPush16, kRingFixture) {
+    awb::DoNotOptimize(ring.Push(ring_block, sizeof(ring_block)));
+}
+
+// An S-curve move long enough that every iteration steps it mid-travel (1 kHz, 2000 counts/s)
+static constexpr awb::MotionLimits kBenchLimits = {.velocity = 2000, .acceleration = 4000, .jerk = 40000};
+static awb::MotionProfile profile(1000, kBenchLimits);
+
+static void StartMove() {
+    profile.Reset(0);
+    (void)profile.MoveTo(1'000'000);
+}
+
+static void KeepMoving() {
+    if (profile.IsDone()) {
+        StartMove();
+    }
+}
+
+static constexpr awb::BenchFixture kMoveFixture = {StartMove, KeepMoving, nullptr};
+
+// One control tick: the per-tick cost
+AWB_BENCHMARK_F(MotionProfileStep, kMoveFixture) {
+    awb::DoNotOptimize(profile.Step());
+}
+
+// Planning a move from rest
+AWB_BENCHMARK_F(MotionProfileMoveTo, kMoveFixture) {
+    profile.Reset(0);
+    awb::DoNotOptimize(profile.MoveTo(12345));
+}
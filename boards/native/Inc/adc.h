@@ -0,0 +1,12 @@
+#pragma once
+
+// Host simulation (env:native): the handles CubeMX generates in adc.h.
+
+#include <stm32l4xx_hal.h>
+
+extern "C" {
+extern ADC_HandleTypeDef hadc1;
+extern DMA_HandleTypeDef hdma_adc1;
+
+void MX_ADC1_Init(void);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// Host simulation (env:native): the pin setup CubeMX generates in gpio.h.
+
+#include <stm32l4xx_hal.h>
+
+extern "C" {
+void MX_GPIO_Init(void);
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Control surface of the simulated HAL (env:native).
+ *
+ * Interrupts are modelled as synchronous callbacks. UART DMA completions are
+ * delivered at "interrupt points" (HAL_GetTick(), HAL_Delay(), __WFI(), and
+ * unmasking with __enable_irq()/__set_PRIMASK()), so driver code that spins on
+ * the tick while waiting for DMA behaves as it does on target. ADC conversions
+ * and GPIO edges only happen when a test asks for them.
+ */
+namespace sim {
+
+/**
+ * @brief Produces the raw ADC result for the n-th conversion since the waveform was set.
+ */
+using Waveform = std::function<uint32_t(uint32_t sample_index)>;
+
+/**
+ * @brief Returns every simulated peripheral, the tick and the cycle counter to power-on state.
+ */
+void Reset();
+
+/**
+ * @brief Returns the whole of flash to the erased state (0xFF).
+ * @note Flash survives Reset(), as it does a power cycle.
+ */
+void EraseFlash();
+
+/**
+ * @brief Advances simulated time; HAL_GetTick() and DWT->CYCCNT move together.
+ * @param ms Milliseconds to advance.
+ */
+void AdvanceTime(uint32_t ms);
+
+/**
+ * @brief Delivers pending interrupts (UART DMA completions) unless masked.
+ * @return true if anything was delivered.
+ */
+bool ServiceInterrupts();
+
+/**
+ * @brief Drives external input levels onto GPIO pins.
+ * @param port GPIO port (e.g., GPIOC).
+ * @param pins Pin mask to drive.
+ * @param high Level to drive.
+ * @note Edges on pins configured with an EXTI mode set EXTI_PR1 and call the EXTI
+ *       IRQ handler. EXTI line n is pin n of whichever port changes (SYSCFG routing
+ *       is not modelled).
+ */
+void SetInput(GPIO_TypeDef* port, uint16_t pins, bool high);
+
+/**
+ * @brief Raises EXTI lines and runs their IRQ handlers, as if edges had been detected.
+ * @param lines EXTI line mask.
+ */
+void TriggerExti(uint16_t lines);
+
+/**
+ * @brief Sets the signal sampled by an ADC.
+ * @param hadc ADC handle.
+ * @param wave Sample generator; unset reads as 0.
+ */
+void SetAdcWaveform(ADC_HandleTypeDef& hadc, Waveform wave);
+
+/**
+ * @brief Sets the signal sampled on one channel, overriding SetAdcWaveform() for it.
+ * @param hadc    ADC handle.
+ * @param channel HAL channel constant (regular or injected).
+ * @param wave    Sample generator, called with the n-th conversion of this channel.
+ */
+void SetAdcChannelWaveform(ADC_HandleTypeDef& hadc, uint32_t channel, Waveform wave);
+
+/**
+ * @brief Performs ADC conversions as if the ADC clock had run.
+ * @param hadc        ADC handle (must be started).
+ * @param conversions Number of conversions.
+ *
+ * Each conversion samples the next rank of the regular sequence (see
+ * HAL_ADC_ConfigChannel()). In DMA mode results are written to the buffer (element
+ * width from the DMA handle's MemDataAlignment), and half/full-transfer callbacks
+ * fire at the buffer midpoint and end. The analog watchdog is evaluated on every
+ * conversion of its channel. With Init.OversamplingMode enabled, each conversion
+ * sums Init.Oversampling.Ratio waveform samples and applies the right shift.
+ */
+void RunAdc(ADC_HandleTypeDef& hadc, std::size_t conversions);
+
+/**
+ * @brief Fires DAC triggers as if the trigger timer had overflowed.
+ * @param hdac     DAC handle.
+ * @param triggers Number of trigger events; each one updates every enabled channel.
+ *
+ * On each trigger a channel in DMA mode loads the next buffer element (firing the
+ * half/full-transfer callbacks at the midpoint and end, and wrapping), then the
+ * output (HAL_DAC_GetValue()) becomes the held value plus the triangle or noise
+ * generator, if enabled.
+ */
+void RunDac(DAC_HandleTypeDef& hdac, std::size_t triggers);
+
+/**
+ * @brief Gets every byte transmitted on a UART so far (blocking and DMA).
+ */
+std::string& UartOutput(UART_HandleTypeDef& huart);
+
+/**
+ * @brief Controls when UART TX DMA transfers complete.
+ * @param huart   UART handle.
+ * @param enabled true (default): complete at the next interrupt point;
+ *                false: only when CompleteUartDma() is called.
+ */
+void SetUartDmaAutoComplete(UART_HandleTypeDef& huart, bool enabled);
+
+/**
+ * @brief Moves the in-flight UART TX DMA transfer to its midpoint and fires the half-transfer callback.
+ * @return false if no transfer was in flight or it was already past its midpoint.
+ */
+bool HalfCompleteUartDma(UART_HandleTypeDef& huart);
+
+/**
+ * @brief Finishes the in-flight UART TX DMA transfer and fires its callbacks.
+ * @return false if no transfer was in flight.
+ * @note The half-transfer callback fires first unless HalfCompleteUartDma() already fired it.
+ */
+bool CompleteUartDma(UART_HandleTypeDef& huart);
+
+/**
+ * @brief Queues bytes to be returned by HAL_UART_Receive().
+ */
+void InjectUartRx(UART_HandleTypeDef& huart, std::string_view bytes);
+
+/**
+ * @brief Receives bytes on a UART in DMA reception (HAL_UARTEx_ReceiveToIdle_DMA()), then idles the line.
+ * @param huart UART handle; bytes are lost if it is not receiving.
+ * @param bytes Bytes, written into the DMA buffer one by one.
+ * @param idle  false to keep the line busy, so the next call continues the same frame.
+ *
+ * The RX event callback fires at the buffer's half and end (wrapping, as circular
+ * DMA does) and once more for the idle line, unless the bytes ended exactly at the
+ * end of the buffer: the HAL reports no idle event there.
+ */
+void ReceiveUart(UART_HandleTypeDef& huart, std::string_view bytes, bool idle = true);
+
+/**
+ * @brief Raises receive errors and runs HAL_UART_ErrorCallback().
+ * @param huart  UART handle.
+ * @param errors HAL_UART_ERROR_* mask. Any error during DMA reception (and an overrun in any
+ *               mode) aborts reception first, as the HAL does.
+ */
+void RaiseUartError(UART_HandleTypeDef& huart, uint32_t errors);
+
+}  // namespace sim
@@ -0,0 +1,814 @@
+#pragma once
+
+// Host simulation (env:native): stand-in for the STM32Cube HAL.
+//
+// Provides the subset of types, constants and functions used by include/hal and
+// src/hal, backed by a simulated register file (boards/native/Src/sim_hal.cpp).
+// Peripheral base addresses and GPIO register offsets match RM0351, so code that
+// folds addresses at compile time (FastGpio, board_defs.hpp) builds unchanged.
+// Drive the simulation from tests and benchmarks through sim_hal.hpp.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "stm32l4xx_hal_def.h"
+
+// Lets the few places that touch raw addresses route through the simulator
+#define AWB_SIM_HAL 1
+
+// -----------------------------------------------------------------------------
+// Memory map (RM0351 section 2.2.2)
+// -----------------------------------------------------------------------------
+#define FLASH_BASE      (0x08000000UL)
+#define PERIPH_BASE     (0x40000000UL)
+#define APB1PERIPH_BASE PERIPH_BASE
+#define APB2PERIPH_BASE (PERIPH_BASE + 0x00010000UL)
+#define AHB2PERIPH_BASE (PERIPH_BASE + 0x08000000UL)
+
+#define TIM2_BASE   (APB1PERIPH_BASE + 0x0000UL)
+#define TIM6_BASE   (APB1PERIPH_BASE + 0x1000UL)
+#define USART2_BASE (APB1PERIPH_BASE + 0x4400UL)
+#define DAC1_BASE   (APB1PERIPH_BASE + 0x7400UL)
+#define TIM1_BASE   (APB2PERIPH_BASE + 0x2C00UL)
+#define USART1_BASE (APB2PERIPH_BASE + 0x3800UL)
+
+#define GPIOA_BASE (AHB2PERIPH_BASE + 0x0000UL)
+#define GPIOB_BASE (AHB2PERIPH_BASE + 0x0400UL)
+#define GPIOC_BASE (AHB2PERIPH_BASE + 0x0800UL)
+#define GPIOD_BASE (AHB2PERIPH_BASE + 0x0C00UL)
+#define GPIOE_BASE (AHB2PERIPH_BASE + 0x1000UL)
+#define GPIOF_BASE (AHB2PERIPH_BASE + 0x1400UL)
+#define GPIOG_BASE (AHB2PERIPH_BASE + 0x1800UL)
+#define GPIOH_BASE (AHB2PERIPH_BASE + 0x1C00UL)
+
+// -----------------------------------------------------------------------------
+// Register blocks. Plain (non-volatile) fields: the simulator is single-threaded.
+// -----------------------------------------------------------------------------
+typedef struct {
+    uint32_t MODER;
+    uint32_t OTYPER;
+    uint32_t OSPEEDR;
+    uint32_t PUPDR;
+    uint32_t IDR;
+    uint32_t ODR;
+    uint32_t BSRR;
+    uint32_t LCKR;
+    uint32_t AFR[2];
+    uint32_t BRR;
+    uint32_t ASCR;
+} GPIO_TypeDef;
+
+typedef struct {
+    uint32_t ISR;
+    uint32_t IER;
+    uint32_t CR;
+    uint32_t CFGR;
+    uint32_t TR1;
+    uint32_t DR;
+} ADC_TypeDef;
+
+typedef struct {
+    uint32_t CR1;
+    uint32_t CR2;
+    uint32_t CR3;
+    uint32_t BRR;
+    uint32_t ISR;
+    uint32_t RDR;
+    uint32_t TDR;
+} USART_TypeDef;
+
+typedef struct {
+    uint32_t CR1;
+    uint32_t CR2;
+    uint32_t SMCR;
+    uint32_t DIER;
+    uint32_t SR;
+    uint32_t EGR;
+    uint32_t CCMR1;
+    uint32_t CCMR2;
+    uint32_t CCER;
+    uint32_t CNT;
+    uint32_t PSC;
+    uint32_t ARR;
+    uint32_t RCR;
+    uint32_t CCR1;
+    uint32_t CCR2;
+    uint32_t CCR3;
+    uint32_t CCR4;
+    uint32_t BDTR;
+} TIM_TypeDef;
+
+typedef struct {
+    uint32_t CR;
+    uint32_t SWTRIGR;
+    uint32_t DHR12R1;
+    uint32_t DHR12R2;
+    uint32_t DOR1;
+    uint32_t DOR2;
+    uint32_t SR;
+} DAC_TypeDef;
+
+typedef struct {
+    uint32_t MEMRMP;
+    uint32_t CFGR1;
+    uint32_t EXTICR[4];
+    uint32_t SCSR;
+    uint32_t CFGR2;
+    uint32_t SWPR;
+    uint32_t SKR;
+} SYSCFG_TypeDef;
+
+typedef struct {
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+    uint32_t CTRL;
+    uint32_t LOAD;
+    uint32_t VAL;
+    uint32_t CALIB;
+} SysTick_Type;
+
+#define GPIO_ASCR_ASC0             (1UL << 0)  // L47x/L48x: GPIOx_ASCR exists
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+namespace sim {
+
+/**
+ * @brief Write-1-to-clear register (e.g. EXTI_PR1).
+ */
+class W1CRegister {
+public:
+    W1CRegister& operator=(uint32_t bits) {
+        value_ &= ~bits;
+        return *this;
+    }
+    operator uint32_t() const { return value_; }
+
+    /**
+     * @brief Sets pending bits, as the hardware would.
+     */
+    void Raise(uint32_t bits) { value_ |= bits; }
+
+private:
+    uint32_t value_ = 0;
+};
+
+typedef struct {
+    uint32_t IMR1;
+    uint32_t EMR1;
+    uint32_t RTSR1;
+    uint32_t FTSR1;
+    uint32_t SWIER1;
+    W1CRegister PR1;
+} ExtiRegisters;
+
+uint32_t ReadRegister(std::uintptr_t address);
+void WriteRegister(std::uintptr_t address, uint32_t value);
+
+/**
+ * @brief Reference to a simulated register at an absolute address.
+ *
+ * Stands in for `*reinterpret_cast<volatile uint32_t*>(address)` so stores to
+ * BSRR/BRR update ODR and IDR the way the hardware does.
+ */
+class RegisterRef {
+public:
+    explicit RegisterRef(std::uintptr_t address) : address_(address) {}
+
+    RegisterRef& operator=(uint32_t value) {
+        WriteRegister(address_, value);
+        return *this;
+    }
+    operator uint32_t() const { return ReadRegister(address_); }
+
+private:
+    std::uintptr_t address_;
+};
+
+GPIO_TypeDef* GpioPort(std::uintptr_t base);
+
+/**
+ * @brief Maps a main-flash address to the simulated flash array.
+ */
+const uint8_t* FlashMemory(std::uintptr_t address);
+
+extern DWT_Type dwt;
+extern CoreDebug_Type core_debug;
+extern SysTick_Type systick;
+extern ExtiRegisters exti;
+extern SYSCFG_TypeDef syscfg;
+extern ADC_TypeDef adc_registers[3];
+extern USART_TypeDef usart_registers[2];
+extern TIM_TypeDef tim_registers[3];
+extern DAC_TypeDef dac_registers[1];
+
+}  // namespace sim
+
+typedef sim::ExtiRegisters EXTI_TypeDef;
+
+#define DWT       (&::sim::dwt)
+#define CoreDebug (&::sim::core_debug)
+#define SysTick   (&::sim::systick)
+#define EXTI      (&::sim::exti)
+#define SYSCFG    (&::sim::syscfg)
+
+#define GPIOA (::sim::GpioPort(GPIOA_BASE))
+#define GPIOB (::sim::GpioPort(GPIOB_BASE))
+#define GPIOC (::sim::GpioPort(GPIOC_BASE))
+#define GPIOD (::sim::GpioPort(GPIOD_BASE))
+#define GPIOE (::sim::GpioPort(GPIOE_BASE))
+#define GPIOF (::sim::GpioPort(GPIOF_BASE))
+#define GPIOG (::sim::GpioPort(GPIOG_BASE))
+#define GPIOH (::sim::GpioPort(GPIOH_BASE))
+
+#define ADC1 (&::sim::adc_registers[0])
+#define ADC2 (&::sim::adc_registers[1])
+#define ADC3 (&::sim::adc_registers[2])
+
+#define USART1 (&::sim::usart_registers[0])
+#define USART2 (&::sim::usart_registers[1])
+
+#define TIM1 (&::sim::tim_registers[0])
+#define TIM2 (&::sim::tim_registers[1])
+#define TIM6 (&::sim::tim_registers[2])
+
+#define DAC1 (&::sim::dac_registers[0])
+
+// -----------------------------------------------------------------------------
+// Core / tick
+// -----------------------------------------------------------------------------
+extern "C" {
+extern uint32_t SystemCoreClock;
+extern __IO uint32_t uwTick;
+
+uint32_t HAL_GetTick(void);
+uint32_t HAL_GetTickFreq(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_IncTick(void);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __WFI(void);
+}
+
+// -----------------------------------------------------------------------------
+// GPIO / EXTI
+// -----------------------------------------------------------------------------
+#define GPIO_PIN_0   ((uint16_t)0x0001)
+#define GPIO_PIN_1   ((uint16_t)0x0002)
+#define GPIO_PIN_2   ((uint16_t)0x0004)
+#define GPIO_PIN_3   ((uint16_t)0x0008)
+#define GPIO_PIN_4   ((uint16_t)0x0010)
+#define GPIO_PIN_5   ((uint16_t)0x0020)
+#define GPIO_PIN_6   ((uint16_t)0x0040)
+#define GPIO_PIN_7   ((uint16_t)0x0080)
+#define GPIO_PIN_8   ((uint16_t)0x0100)
+#define GPIO_PIN_9   ((uint16_t)0x0200)
+#define GPIO_PIN_10  ((uint16_t)0x0400)
+#define GPIO_PIN_11  ((uint16_t)0x0800)
+#define GPIO_PIN_12  ((uint16_t)0x1000)
+#define GPIO_PIN_13  ((uint16_t)0x2000)
+#define GPIO_PIN_14  ((uint16_t)0x4000)
+#define GPIO_PIN_15  ((uint16_t)0x8000)
+#define GPIO_PIN_All ((uint16_t)0xFFFF)
+
+#define GPIO_MODE_INPUT              (0x00000000U)
+#define GPIO_MODE_OUTPUT_PP          (0x00000001U)
+#define GPIO_MODE_OUTPUT_OD          (0x00000011U)
+#define GPIO_MODE_AF_PP              (0x00000002U)
+#define GPIO_MODE_AF_OD              (0x00000012U)
+#define GPIO_MODE_ANALOG             (0x00000003U)
+#define GPIO_MODE_ANALOG_ADC_CONTROL (0x0000000BU)
+#define GPIO_MODE_IT_RISING          (0x10110000U)
+#define GPIO_MODE_IT_FALLING         (0x10210000U)
+#define GPIO_MODE_IT_RISING_FALLING  (0x10310000U)
+
+#define GPIO_SPEED_FREQ_LOW       (0x00000000U)
+#define GPIO_SPEED_FREQ_MEDIUM    (0x00000001U)
+#define GPIO_SPEED_FREQ_HIGH      (0x00000002U)
+#define GPIO_SPEED_FREQ_VERY_HIGH (0x00000003U)
+
+#define GPIO_NOPULL   (0x00000000U)
+#define GPIO_PULLUP   (0x00000001U)
+#define GPIO_PULLDOWN (0x00000002U)
+
+#define GPIO_AF0_SWJ    ((uint8_t)0x00)
+#define GPIO_AF1_TIM1   ((uint8_t)0x01)
+#define GPIO_AF1_TIM2   ((uint8_t)0x01)
+#define GPIO_AF7_USART2 ((uint8_t)0x07)
+
+#define __HAL_RCC_GPIOA_CLK_ENABLE() \
+    do {                             \
+    } while (0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() __HAL_RCC_GPIOA_CLK_ENABLE()
+#define __HAL_RCC_GPIOC_CLK_ENABLE() __HAL_RCC_GPIOA_CLK_ENABLE()
+#define __HAL_RCC_GPIOD_CLK_ENABLE() __HAL_RCC_GPIOA_CLK_ENABLE()
+#define __HAL_RCC_GPIOE_CLK_ENABLE() __HAL_RCC_GPIOA_CLK_ENABLE()
+#define __HAL_RCC_GPIOH_CLK_ENABLE() __HAL_RCC_GPIOA_CLK_ENABLE()
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET,
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+extern "C" {
+void HAL_GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_Init);
+void HAL_GPIO_DeInit(GPIO_TypeDef* GPIOx, uint32_t GPIO_Pin);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+HAL_StatusTypeDef HAL_GPIO_LockPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_IRQHandler(uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+}
+
+// -----------------------------------------------------------------------------
+// DMA
+// -----------------------------------------------------------------------------
+#define DMA_MDATAALIGN_BYTE     (0x00000000U)
+#define DMA_MDATAALIGN_HALFWORD (0x00000400U)
+#define DMA_MDATAALIGN_WORD     (0x00000800U)
+#define DMA_NORMAL              (0x00000000U)
+#define DMA_CIRCULAR            (0x00000020U)
+
+typedef struct {
+    uint32_t Request;
+    uint32_t Direction;
+    uint32_t PeriphInc;
+    uint32_t MemInc;
+    uint32_t PeriphDataAlignment;
+    uint32_t MemDataAlignment;
+    uint32_t Mode;
+    uint32_t Priority;
+} DMA_InitTypeDef;
+
+typedef struct {
+    void* Instance;
+    DMA_InitTypeDef Init;
+} DMA_HandleTypeDef;
+
+// -----------------------------------------------------------------------------
+// ADC
+// -----------------------------------------------------------------------------
+// Channel numbers are plain indices here; the target encodes them differently,
+// but drivers only pass them through.
+#define ADC_CHANNEL_0  (0U)
+#define ADC_CHANNEL_1  (1U)
+#define ADC_CHANNEL_2  (2U)
+#define ADC_CHANNEL_3  (3U)
+#define ADC_CHANNEL_4  (4U)
+#define ADC_CHANNEL_5  (5U)
+#define ADC_CHANNEL_6  (6U)
+#define ADC_CHANNEL_7  (7U)
+#define ADC_CHANNEL_8  (8U)
+#define ADC_CHANNEL_9  (9U)
+#define ADC_CHANNEL_10 (10U)
+#define ADC_CHANNEL_11 (11U)
+#define ADC_CHANNEL_12 (12U)
+#define ADC_CHANNEL_13 (13U)
+#define ADC_CHANNEL_14 (14U)
+#define ADC_CHANNEL_15 (15U)
+#define ADC_CHANNEL_16 (16U)
+#define ADC_CHANNEL_17 (17U)
+#define ADC_CHANNEL_18 (18U)
+#define ADC_CHANNEL_VREFINT    (0x80000000U | 0U)
+#define ADC_CHANNEL_TEMPSENSOR (0x80000000U | 17U)
+#define ADC_CHANNEL_VBAT       (0x80000000U | 18U)
+
+#define ADC_SCAN_DISABLE (0x00000000U)
+#define ADC_SCAN_ENABLE  (0x00000001U)
+
+// Ranks are plain 1-based positions here
+#define ADC_REGULAR_RANK_1  (1U)
+#define ADC_REGULAR_RANK_2  (2U)
+#define ADC_REGULAR_RANK_3  (3U)
+#define ADC_REGULAR_RANK_4  (4U)
+#define ADC_REGULAR_RANK_5  (5U)
+#define ADC_REGULAR_RANK_6  (6U)
+#define ADC_REGULAR_RANK_7  (7U)
+#define ADC_REGULAR_RANK_8  (8U)
+#define ADC_INJECTED_RANK_1 (1U)
+
+#define ADC_SAMPLETIME_2CYCLES_5   (0U)
+#define ADC_SAMPLETIME_6CYCLES_5   (1U)
+#define ADC_SAMPLETIME_12CYCLES_5  (2U)
+#define ADC_SAMPLETIME_24CYCLES_5  (3U)
+#define ADC_SAMPLETIME_47CYCLES_5  (4U)
+#define ADC_SAMPLETIME_92CYCLES_5  (5U)
+#define ADC_SAMPLETIME_247CYCLES_5 (6U)
+#define ADC_SAMPLETIME_640CYCLES_5 (7U)
+
+// Oversampling settings are the plain ratio and shift here
+#define ADC_OVERSAMPLING_RATIO_2   (2U)
+#define ADC_OVERSAMPLING_RATIO_4   (4U)
+#define ADC_OVERSAMPLING_RATIO_8   (8U)
+#define ADC_OVERSAMPLING_RATIO_16  (16U)
+#define ADC_OVERSAMPLING_RATIO_32  (32U)
+#define ADC_OVERSAMPLING_RATIO_64  (64U)
+#define ADC_OVERSAMPLING_RATIO_128 (128U)
+#define ADC_OVERSAMPLING_RATIO_256 (256U)
+#define ADC_RIGHTBITSHIFT_NONE (0U)
+#define ADC_RIGHTBITSHIFT_1    (1U)
+#define ADC_RIGHTBITSHIFT_2    (2U)
+#define ADC_RIGHTBITSHIFT_3    (3U)
+#define ADC_RIGHTBITSHIFT_4    (4U)
+#define ADC_RIGHTBITSHIFT_5    (5U)
+#define ADC_RIGHTBITSHIFT_6    (6U)
+#define ADC_RIGHTBITSHIFT_7    (7U)
+#define ADC_RIGHTBITSHIFT_8    (8U)
+#define ADC_TRIGGEREDMODE_SINGLE_TRIGGER   (0x00000000U)
+#define ADC_TRIGGEREDMODE_MULTI_TRIGGER    (0x00000200U)
+#define ADC_REGOVERSAMPLING_CONTINUED_MODE (0x00000000U)
+
+#define ADC_SOFTWARE_START               (0x00000001U)
+#define ADC_EXTERNALTRIG_T1_CC1          (0x00000000U)
+#define ADC_EXTERNALTRIG_T1_TRGO         (0x00000240U)
+#define ADC_EXTERNALTRIG_T1_TRGO2        (0x00000280U)
+#define ADC_EXTERNALTRIGCONVEDGE_NONE    (0x00000000U)
+#define ADC_EXTERNALTRIGCONVEDGE_RISING  (0x00000400U)
+#define ADC_EXTERNALTRIGCONVEDGE_FALLING (0x00000800U)
+
+#define ADC_OFFSET_NONE                     (0x00000004U)
+#define ADC_INJECTED_SOFTWARE_START         (0x00000001U)
+#define ADC_EXTERNALTRIGINJECCONV_EDGE_NONE (0x00000000U)
+
+#define ADC_SINGLE_ENDED       (0x0000007FU)
+#define ADC_DIFFERENTIAL_ENDED (0x0000007EU)
+
+#define ADC_RESOLUTION_12B (0x00000000U)
+#define ADC_RESOLUTION_10B (0x00000008U)
+#define ADC_RESOLUTION_8B  (0x00000010U)
+#define ADC_RESOLUTION_6B  (0x00000018U)
+
+#define ADC_ANALOGWATCHDOG_1            (0x7CF00000U)
+#define ADC_ANALOGWATCHDOG_NONE         (0x00000000U)
+#define ADC_ANALOGWATCHDOG_SINGLE_REG   (0x00C00000U)
+#define ADC_ANALOGWATCHDOG_ALL_REG      (0x00800000U)
+
+#define ADC_FLAG_EOC  (1UL << 2)
+#define ADC_FLAG_EOS  (1UL << 3)
+#define ADC_FLAG_OVR  (1UL << 4)
+#define ADC_FLAG_JEOC (1UL << 5)
+#define ADC_FLAG_AWD1 (1UL << 7)
+#define ADC_IT_EOC    ADC_FLAG_EOC
+#define ADC_IT_EOS    ADC_FLAG_EOS
+#define ADC_IT_OVR    ADC_FLAG_OVR
+#define ADC_IT_AWD1   ADC_FLAG_AWD1
+
+#define __HAL_ADC_ENABLE_IT(__HANDLE__, __INTERRUPT__)  ((__HANDLE__)->Instance->IER |= (__INTERRUPT__))
+#define __HAL_ADC_DISABLE_IT(__HANDLE__, __INTERRUPT__) ((__HANDLE__)->Instance->IER &= ~(__INTERRUPT__))
+#define __HAL_ADC_GET_FLAG(__HANDLE__, __FLAG__)        ((((__HANDLE__)->Instance->ISR) & (__FLAG__)) == (__FLAG__))
+#define __HAL_ADC_CLEAR_FLAG(__HANDLE__, __FLAG__)      ((__HANDLE__)->Instance->ISR &= ~(__FLAG__))
+
+typedef struct {
+    uint32_t Ratio;
+    uint32_t RightBitShift;
+    uint32_t TriggeredMode;
+    uint32_t OversamplingStopReset;
+} ADC_OversamplingTypeDef;
+
+typedef struct {
+    uint32_t ClockPrescaler;
+    uint32_t Resolution;
+    uint32_t DataAlign;
+    uint32_t ScanConvMode;
+    uint32_t EOCSelection;
+    FunctionalState ContinuousConvMode;
+    uint32_t NbrOfConversion;
+    uint32_t ExternalTrigConv;
+    uint32_t ExternalTrigConvEdge;
+    FunctionalState DMAContinuousRequests;
+    uint32_t Overrun;
+    FunctionalState OversamplingMode;
+    ADC_OversamplingTypeDef Oversampling;
+} ADC_InitTypeDef;
+
+typedef struct {
+    ADC_TypeDef* Instance;
+    ADC_InitTypeDef Init;
+    DMA_HandleTypeDef* DMA_Handle;
+    __IO uint32_t State;
+    __IO uint32_t ErrorCode;
+} ADC_HandleTypeDef;
+
+typedef struct {
+    uint32_t WatchdogNumber;
+    uint32_t WatchdogMode;
+    uint32_t Channel;
+    FunctionalState ITMode;
+    uint32_t HighThreshold;
+    uint32_t LowThreshold;
+} ADC_AnalogWDGConfTypeDef;
+
+typedef struct {
+    uint32_t Channel;
+    uint32_t Rank;
+    uint32_t SamplingTime;
+    uint32_t SingleDiff;
+    uint32_t OffsetNumber;
+    uint32_t Offset;
+} ADC_ChannelConfTypeDef;
+
+typedef struct {
+    uint32_t InjectedChannel;
+    uint32_t InjectedRank;
+    uint32_t InjectedSamplingTime;
+    uint32_t InjectedSingleDiff;
+    uint32_t InjectedOffsetNumber;
+    uint32_t InjectedOffset;
+    uint32_t InjectedNbrOfConversion;
+    FunctionalState InjectedDiscontinuousConvMode;
+    FunctionalState AutoInjectedConv;
+    FunctionalState QueueInjectedContext;
+    uint32_t ExternalTrigInjecConv;
+    uint32_t ExternalTrigInjecConvEdge;
+    FunctionalState InjecOversamplingMode;
+} ADC_InjectionConfTypeDef;
+
+extern "C" {
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef* hadc, ADC_ChannelConfTypeDef* sConfig);
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t SingleDiff);
+HAL_StatusTypeDef HAL_ADCEx_InjectedConfigChannel(ADC_HandleTypeDef* hadc, ADC_InjectionConfTypeDef* sConfigInjected);
+HAL_StatusTypeDef HAL_ADCEx_InjectedStart(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADCEx_InjectedPollForConversion(ADC_HandleTypeDef* hadc, uint32_t Timeout);
+uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef* hadc, uint32_t InjectedRank);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc, uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef* hadc, ADC_AnalogWDGConfTypeDef* AnalogWDGConfig);
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc);
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef* hadc);
+}
+
+// -----------------------------------------------------------------------------
+// FLASH (1 MB, dual bank)
+// -----------------------------------------------------------------------------
+#define FLASH_SIZE      (0x00100000UL)
+#define FLASH_BANK_SIZE (FLASH_SIZE >> 1)
+#define FLASH_PAGE_SIZE (0x00000800UL)
+
+#define FLASH_TYPEERASE_PAGES        (0x00000000U)
+#define FLASH_BANK_1                 (0x00000001U)
+#define FLASH_BANK_2                 (0x00000002U)
+#define FLASH_TYPEPROGRAM_DOUBLEWORD (0x00000000U)
+#define FLASH_FLAG_ALL_ERRORS        (0x0000C3FAU)
+
+#define __HAL_FLASH_CLEAR_FLAG(__FLAG__) \
+    do {                                 \
+    } while (0)
+
+typedef struct {
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t Page;
+    uint32_t NbPages;
+} FLASH_EraseInitTypeDef;
+
+extern "C" {
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* PageError);
+}
+
+// -----------------------------------------------------------------------------
+// DAC
+// -----------------------------------------------------------------------------
+#define DAC_CHANNEL_1 (0x00000000U)
+#define DAC_CHANNEL_2 (0x00000010U)
+
+#define DAC_ALIGN_12B_R (0x00000000U)
+
+#define DAC_CR_EN1       (0x1UL << 0)
+#define DAC_CR_TEN1      (0x1UL << 2)
+#define DAC_CR_WAVE1     (0x3UL << 6)
+#define DAC_CR_MAMP1     (0xFUL << 8)
+#define DAC_CR_DMAEN1    (0x1UL << 12)
+#define DAC_CR_WAVE1_0   (0x1UL << 6)  // Noise
+#define DAC_CR_WAVE1_1   (0x2UL << 6)  // Triangle
+#define DAC_CR_MAMP1_Pos (8U)
+
+#define DAC_TRIANGLEAMPLITUDE_1    (0x0UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_3    (0x1UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_7    (0x2UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_15   (0x3UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_31   (0x4UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_63   (0x5UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_127  (0x6UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_255  (0x7UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_511  (0x8UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_1023 (0x9UL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_2047 (0xAUL << DAC_CR_MAMP1_Pos)
+#define DAC_TRIANGLEAMPLITUDE_4095 (0xBUL << DAC_CR_MAMP1_Pos)
+
+#define DAC_LFSRUNMASK_BIT0     (0x0UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS1_0  (0x1UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS2_0  (0x2UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS3_0  (0x3UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS4_0  (0x4UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS5_0  (0x5UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS6_0  (0x6UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS7_0  (0x7UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS8_0  (0x8UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS9_0  (0x9UL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS10_0 (0xAUL << DAC_CR_MAMP1_Pos)
+#define DAC_LFSRUNMASK_BITS11_0 (0xBUL << DAC_CR_MAMP1_Pos)
+
+typedef struct {
+    DAC_TypeDef* Instance;
+    __IO uint32_t State;
+    DMA_HandleTypeDef* DMA_Handle1;
+    DMA_HandleTypeDef* DMA_Handle2;
+    __IO uint32_t ErrorCode;
+} DAC_HandleTypeDef;
+
+extern "C" {
+HAL_StatusTypeDef HAL_DAC_Start(DAC_HandleTypeDef* hdac, uint32_t Channel);
+HAL_StatusTypeDef HAL_DAC_Stop(DAC_HandleTypeDef* hdac, uint32_t Channel);
+HAL_StatusTypeDef HAL_DAC_Start_DMA(DAC_HandleTypeDef* hdac, uint32_t Channel, const uint32_t* pData, uint32_t Length,
+                                    uint32_t Alignment);
+HAL_StatusTypeDef HAL_DAC_Stop_DMA(DAC_HandleTypeDef* hdac, uint32_t Channel);
+HAL_StatusTypeDef HAL_DAC_SetValue(DAC_HandleTypeDef* hdac, uint32_t Channel, uint32_t Alignment, uint32_t Data);
+uint32_t HAL_DAC_GetValue(const DAC_HandleTypeDef* hdac, uint32_t Channel);
+HAL_StatusTypeDef HAL_DACEx_TriangleWaveGenerate(DAC_HandleTypeDef* hdac, uint32_t Channel, uint32_t Amplitude);
+HAL_StatusTypeDef HAL_DACEx_NoiseWaveGenerate(DAC_HandleTypeDef* hdac, uint32_t Channel, uint32_t Amplitude);
+void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef* hdac);
+void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef* hdac);
+void HAL_DACEx_ConvHalfCpltCallbackCh2(DAC_HandleTypeDef* hdac);
+void HAL_DACEx_ConvCpltCallbackCh2(DAC_HandleTypeDef* hdac);
+}
+
+// -----------------------------------------------------------------------------
+// UART
+// -----------------------------------------------------------------------------
+#define HAL_UART_STATE_RESET   (0x00000000U)
+#define HAL_UART_STATE_READY   (0x00000020U)
+#define HAL_UART_STATE_BUSY_RX (0x00000022U)
+
+#define HAL_UART_ERROR_NONE (0x00000000U)
+#define HAL_UART_ERROR_PE   (0x00000001U)
+#define HAL_UART_ERROR_NE   (0x00000002U)
+#define HAL_UART_ERROR_FE   (0x00000004U)
+#define HAL_UART_ERROR_ORE  (0x00000008U)
+#define HAL_UART_ERROR_DMA  (0x00000010U)
+
+#define HAL_UART_RXEVENT_TC   (0x00000000U)
+#define HAL_UART_RXEVENT_HT   (0x00000001U)
+#define HAL_UART_RXEVENT_IDLE (0x00000002U)
+
+typedef uint32_t HAL_UART_RxEventTypeTypeDef;
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct __UART_HandleTypeDef {
+    USART_TypeDef* Instance;
+    UART_InitTypeDef Init;
+    DMA_HandleTypeDef* hdmatx;
+    DMA_HandleTypeDef* hdmarx;
+    volatile uint32_t RxState;
+    volatile uint32_t ErrorCode;
+} UART_HandleTypeDef;
+
+extern "C" {
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* huart);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef* huart);
+HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(UART_HandleTypeDef* huart);
+void HAL_UART_TxHalfCpltCallback(UART_HandleTypeDef* huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t Size);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart);
+}
+
+// -----------------------------------------------------------------------------
+// TIM
+// -----------------------------------------------------------------------------
+#define TIM_CHANNEL_1   (0x00000000U)
+#define TIM_CHANNEL_2   (0x00000004U)
+#define TIM_CHANNEL_3   (0x00000008U)
+#define TIM_CHANNEL_4   (0x0000000CU)
+#define TIM_CHANNEL_ALL (0x0000003CU)
+
+#define TIM_COUNTERMODE_UP             (0x00000000U)
+#define TIM_COUNTERMODE_DOWN           (0x00000010U)
+#define TIM_COUNTERMODE_CENTERALIGNED1 (0x00000020U)
+#define TIM_COUNTERMODE_CENTERALIGNED2 (0x00000040U)
+#define TIM_COUNTERMODE_CENTERALIGNED3 (0x00000060U)
+
+#define TIM_CLOCKDIVISION_DIV1 (0x00000000U)
+#define TIM_CLOCKDIVISION_DIV2 (0x00000100U)
+#define TIM_CLOCKDIVISION_DIV4 (0x00000200U)
+
+#define TIM_CR1_CEN  (0x00000001U)
+#define TIM_CR1_UDIS (0x00000002U)
+
+#define TIM_CR2_OIS1  (0x00000100U)
+#define TIM_CR2_OIS1N (0x00000200U)
+#define TIM_CR2_OIS2  (0x00000400U)
+#define TIM_CR2_OIS2N (0x00000800U)
+#define TIM_CR2_OIS3  (0x00001000U)
+#define TIM_CR2_OIS3N (0x00002000U)
+
+#define TIM_EGR_UG (0x00000001U)
+
+#define TIM_CCMR1_CC1S    (0x00000003U)
+#define TIM_CCMR1_OC1PE   (0x00000008U)
+#define TIM_CCMR1_OC1M    (0x00010070U)
+#define TIM_CCMR1_OC1M_1  (0x00000020U)
+#define TIM_CCMR1_OC1M_2  (0x00000040U)
+#define TIM_CCMR1_CC2S    (0x00000300U)
+#define TIM_CCMR1_OC2PE   (0x00000800U)
+#define TIM_CCMR1_OC2M    (0x01007000U)
+#define TIM_CCMR1_OC2M_1  (0x00002000U)
+#define TIM_CCMR1_OC2M_2  (0x00004000U)
+#define TIM_CCMR2_CC3S    (0x00000003U)
+#define TIM_CCMR2_OC3PE   (0x00000008U)
+#define TIM_CCMR2_OC3M    (0x00010070U)
+#define TIM_CCMR2_OC3M_1  (0x00000020U)
+#define TIM_CCMR2_OC3M_2  (0x00000040U)
+
+#define TIM_CCER_CC1E  (0x00000001U)
+#define TIM_CCER_CC1P  (0x00000002U)
+#define TIM_CCER_CC1NE (0x00000004U)
+#define TIM_CCER_CC1NP (0x00000008U)
+#define TIM_CCER_CC2E  (0x00000010U)
+#define TIM_CCER_CC2P  (0x00000020U)
+#define TIM_CCER_CC2NE (0x00000040U)
+#define TIM_CCER_CC2NP (0x00000080U)
+#define TIM_CCER_CC3E  (0x00000100U)
+#define TIM_CCER_CC3P  (0x00000200U)
+#define TIM_CCER_CC3NE (0x00000400U)
+#define TIM_CCER_CC3NP (0x00000800U)
+
+#define TIM_BDTR_DTG_Pos (0U)
+#define TIM_BDTR_DTG     (0x000000FFU)
+#define TIM_BDTR_OSSI    (0x00000400U)
+#define TIM_BDTR_OSSR    (0x00000800U)
+#define TIM_BDTR_BKE     (0x00001000U)
+#define TIM_BDTR_AOE     (0x00004000U)
+#define TIM_BDTR_MOE     (0x00008000U)
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef* Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__) ((__HANDLE__)->Instance->ARR = (__AUTORELOAD__))
+#define __HAL_TIM_SET_COUNTER(__HANDLE__, __COUNTER__)       ((__HANDLE__)->Instance->CNT = (__COUNTER__))
+#define __HAL_TIM_SET_PRESCALER(__HANDLE__, __PRESC__)       ((__HANDLE__)->Instance->PSC = (__PRESC__))
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) \
+    (*(&(__HANDLE__)->Instance->CCR1 + ((__CHANNEL__) >> 2U)) = (__COMPARE__))
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) (*(&(__HANDLE__)->Instance->CCR1 + ((__CHANNEL__) >> 2U)))
+
+extern "C" {
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_Encoder_Start(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_Encoder_Stop(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef* htim, uint32_t Channel);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Host simulation (env:native): common HAL definitions.
+// Mirrors the names and values of the STM32Cube HAL that the drivers rely on.
+
+#include <cstdint>
+
+#define __IO volatile
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U,
+} HAL_StatusTypeDef;
+
+typedef enum {
+    DISABLE = 0U,
+    ENABLE = !DISABLE,
+} FunctionalState;
+
+typedef enum {
+    RESET = 0U,
+    SET = !RESET,
+} FlagStatus;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
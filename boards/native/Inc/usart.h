@@ -0,0 +1,12 @@
+#pragma once
+
+// Host simulation (env:native): the handles CubeMX generates in usart.h.
+
+#include <stm32l4xx_hal.h>
+
+extern "C" {
+extern UART_HandleTypeDef huart2;
+extern DMA_HandleTypeDef hdma_usart2_tx;
+
+void MX_USART2_UART_Init(void);
+}
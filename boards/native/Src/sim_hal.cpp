@@ -0,0 +1,1021 @@
+#include "sim_hal.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+// Defined (weakly) by src/hal/exti_registry.cpp or by AWB_EXTI_DISPATCH()
+extern "C" void EXTI0_IRQHandler(void);
+extern "C" void EXTI1_IRQHandler(void);
+extern "C" void EXTI2_IRQHandler(void);
+extern "C" void EXTI3_IRQHandler(void);
+extern "C" void EXTI4_IRQHandler(void);
+extern "C" void EXTI9_5_IRQHandler(void);
+extern "C" void EXTI15_10_IRQHandler(void);
+
+uint32_t SystemCoreClock = 80'000'000;
+__IO uint32_t uwTick = 0;
+
+namespace sim {
+
+DWT_Type dwt{};
+CoreDebug_Type core_debug{};
+SysTick_Type systick{};
+ExtiRegisters exti{};
+SYSCFG_TypeDef syscfg{};
+ADC_TypeDef adc_registers[3]{};
+USART_TypeDef usart_registers[2]{};
+TIM_TypeDef tim_registers[3]{};
+DAC_TypeDef dac_registers[1]{};
+
+namespace {
+
+constexpr std::size_t kGpioPorts = 8;
+constexpr std::uintptr_t kGpioStride = GPIOB_BASE - GPIOA_BASE;
+constexpr uint32_t kModerReset = 0xFFFFFFFF;  // Every pin analog
+
+GPIO_TypeDef gpio_ports[kGpioPorts]{};
+uint16_t gpio_inputs[kGpioPorts]{};
+
+struct AdcState {
+    Waveform waveform;
+    uint32_t sample_index = 0;
+    std::map<uint32_t, Waveform> channel_waveforms;
+    std::map<uint32_t, uint32_t> channel_sample_index;
+    std::vector<uint32_t> sequence;  // Regular ranks; empty until HAL_ADC_ConfigChannel()
+    uint32_t rank = 0;               // Index of the next conversion in sequence
+    bool injected = false;
+    uint32_t injected_channel = 0;
+    uint32_t injected_value = 0;
+    bool running = false;
+    bool dma = false;
+    void* buffer = nullptr;
+    uint32_t length = 0;
+    uint32_t position = 0;
+    bool watchdog = false;
+    bool watchdog_all = false;
+    uint32_t watchdog_channel = 0;
+    uint32_t watchdog_low = 0;
+    uint32_t watchdog_high = 0;
+};
+
+struct DacChannelState {
+    bool dma = false;
+    const uint16_t* buffer = nullptr;
+    uint32_t length = 0;
+    uint32_t position = 0;
+    uint32_t triangle = 0;  // Triangle counter
+    bool falling = false;
+    uint32_t lfsr = 0xAAA;  // Reset value of the noise LFSR
+};
+
+struct DacState {
+    DacChannelState channels[2];
+};
+
+struct UartState {
+    std::string output;
+    std::deque<uint8_t> rx;
+    uint8_t* rx_dma_data = nullptr;
+    uint16_t rx_dma_length = 0;
+    uint16_t rx_dma_position = 0;
+    uint32_t rx_event = HAL_UART_RXEVENT_TC;
+    const uint8_t* dma_data = nullptr;
+    uint16_t dma_length = 0;
+    bool dma_busy = false;
+    bool dma_half_done = false;  // Half-transfer interrupt already delivered
+    bool auto_complete = true;
+};
+
+// std::map: callbacks may add entries while we iterate
+std::map<const ADC_HandleTypeDef*, AdcState> adcs;
+std::map<UART_HandleTypeDef*, UartState> uarts;
+std::map<const DAC_HandleTypeDef*, DacState> dacs;
+
+// Programming needs an unlocked controller and an erased (all-ones) double word, as on target
+std::vector<uint8_t> flash(FLASH_SIZE, 0xFF);
+bool flash_locked = true;
+
+uint32_t primask = 0;
+bool servicing = false;
+
+[[noreturn]] void Fail(const char* what, std::uintptr_t address) {
+    std::fprintf(stderr, "sim: %s (0x%08lX)\n", what, static_cast<unsigned long>(address));
+    std::abort();
+}
+
+std::size_t PortIndex(std::uintptr_t address) {
+    if (address < GPIOA_BASE || address >= GPIOA_BASE + kGpioPorts * kGpioStride) {
+        Fail("address is not a simulated GPIO register", address);
+    }
+    return (address - GPIOA_BASE) / kGpioStride;
+}
+
+std::size_t PortIndex(const GPIO_TypeDef* port) {
+    return static_cast<std::size_t>(port - gpio_ports);
+}
+
+// IDR follows ODR on output pins and the externally driven level everywhere else
+void RefreshIdr(std::size_t index) {
+    GPIO_TypeDef& port = gpio_ports[index];
+    uint32_t output_mask = 0;
+    for (uint32_t pin = 0; pin < 16; ++pin) {
+        if (((port.MODER >> (pin * 2)) & 0x3U) == GPIO_MODE_OUTPUT_PP) {
+            output_mask |= 1U << pin;
+        }
+    }
+    port.IDR = (port.ODR & output_mask) | (gpio_inputs[index] & ~output_mask & 0xFFFFU);
+}
+
+void DispatchExtiVectors(uint16_t lines) {
+    if (lines & GPIO_PIN_0) EXTI0_IRQHandler();
+    if (lines & GPIO_PIN_1) EXTI1_IRQHandler();
+    if (lines & GPIO_PIN_2) EXTI2_IRQHandler();
+    if (lines & GPIO_PIN_3) EXTI3_IRQHandler();
+    if (lines & GPIO_PIN_4) EXTI4_IRQHandler();
+    if (lines & 0x03E0U) EXTI9_5_IRQHandler();
+    if (lines & 0xFC00U) EXTI15_10_IRQHandler();
+}
+
+// A channel with its own waveform counts its own conversions; everything else shares the ADC's waveform
+uint32_t Convert(AdcState& state, uint32_t channel) {
+    const auto wave = state.channel_waveforms.find(channel);
+    if (wave != state.channel_waveforms.end()) {
+        return wave->second(state.channel_sample_index[channel]++);
+    }
+    return state.waveform ? state.waveform(state.sample_index++) : 0;
+}
+
+void StoreSample(const ADC_HandleTypeDef& hadc, AdcState& state, uint32_t value) {
+    const uint32_t align = (hadc.DMA_Handle != nullptr) ? hadc.DMA_Handle->Init.MemDataAlignment : DMA_MDATAALIGN_WORD;
+    switch (align) {
+        case DMA_MDATAALIGN_BYTE:
+            static_cast<uint8_t*>(state.buffer)[state.position] = static_cast<uint8_t>(value);
+            break;
+        case DMA_MDATAALIGN_HALFWORD:
+            static_cast<uint16_t*>(state.buffer)[state.position] = static_cast<uint16_t>(value);
+            break;
+        default: static_cast<uint32_t*>(state.buffer)[state.position] = value; break;
+    }
+}
+
+// Shifts CR bit fields of channel 1 to the given channel
+uint32_t DacShift(uint32_t channel) {
+    return channel & 0x10U;
+}
+
+DacChannelState& DacChannel(const DAC_HandleTypeDef* hdac, uint32_t channel) {
+    return dacs[hdac].channels[DacShift(channel) != 0 ? 1 : 0];
+}
+
+// One trigger: the DMA (if running) loads DHR, then DOR = DHR plus the wave generator
+void TriggerDacChannel(DAC_HandleTypeDef& hdac, uint32_t channel) {
+    const uint32_t cr = hdac.Instance->CR >> DacShift(channel);
+    if (!(cr & DAC_CR_EN1)) {
+        return;
+    }
+    DacChannelState& state = DacChannel(&hdac, channel);
+    uint32_t& dhr = (channel == DAC_CHANNEL_1) ? hdac.Instance->DHR12R1 : hdac.Instance->DHR12R2;
+    uint32_t& dor = (channel == DAC_CHANNEL_1) ? hdac.Instance->DOR1 : hdac.Instance->DOR2;
+
+    if (state.dma && (cr & DAC_CR_DMAEN1)) {
+        dhr = state.buffer[state.position++] & 0xFFFU;
+        const bool ch1 = (channel == DAC_CHANNEL_1);
+        if (state.position == state.length / 2) {
+            ch1 ? HAL_DAC_ConvHalfCpltCallbackCh1(&hdac) : HAL_DACEx_ConvHalfCpltCallbackCh2(&hdac);
+        }
+        if (state.position == state.length) {
+            state.position = 0;
+            ch1 ? HAL_DAC_ConvCpltCallbackCh1(&hdac) : HAL_DACEx_ConvCpltCallbackCh2(&hdac);
+        }
+    }
+
+    const uint32_t mamp = (cr & DAC_CR_MAMP1) >> DAC_CR_MAMP1_Pos;
+    const uint32_t mask = (2U << mamp) - 1U;  // MAMP = n selects 2^(n+1) - 1
+    uint32_t wave = 0;
+    switch (cr & DAC_CR_WAVE1) {
+        case DAC_CR_WAVE1_0: {
+            // RM0351: X^12 + X^6 + X^4 + X + 1, unmasked bits added to DHR
+            const uint32_t lfsr = state.lfsr;
+            const uint32_t feedback = ((lfsr >> 11) ^ (lfsr >> 5) ^ (lfsr >> 3) ^ lfsr) & 0x1U;
+            state.lfsr = ((lfsr << 1) | feedback) & 0xFFFU;
+            wave = state.lfsr & mask;
+            break;
+        }
+        case DAC_CR_WAVE1_1:
+            // Counts up to the amplitude and back down to 0, one step per trigger
+            if (!state.falling) {
+                state.falling = (++state.triangle >= mask);
+            } else {
+                state.falling = (--state.triangle != 0);
+            }
+            wave = state.triangle;
+            break;
+        default: break;
+    }
+    dor = (dhr + wave) & 0xFFFU;
+}
+
+// HAL_UARTEx_GetRxEventType() reports the event while its callback runs
+void RaiseRxEvent(UART_HandleTypeDef& huart, uint32_t event, uint16_t position) {
+    uarts[&huart].rx_event = event;
+    HAL_UARTEx_RxEventCallback(&huart, position);
+}
+
+}  // namespace
+
+GPIO_TypeDef* GpioPort(std::uintptr_t base) {
+    return &gpio_ports[PortIndex(base)];
+}
+
+uint32_t ReadRegister(std::uintptr_t address) {
+    const std::size_t index = PortIndex(address);
+    const std::uintptr_t offset = address - (GPIOA_BASE + index * kGpioStride);
+    if (offset == offsetof(GPIO_TypeDef, BSRR) || offset == offsetof(GPIO_TypeDef, BRR)) {
+        return 0;  // Write-only
+    }
+    uint32_t value;
+    std::memcpy(&value, reinterpret_cast<const uint8_t*>(&gpio_ports[index]) + offset, sizeof(value));
+    return value;
+}
+
+void WriteRegister(std::uintptr_t address, uint32_t value) {
+    const std::size_t index = PortIndex(address);
+    const std::uintptr_t offset = address - (GPIOA_BASE + index * kGpioStride);
+    GPIO_TypeDef& port = gpio_ports[index];
+
+    switch (offset) {
+        case offsetof(GPIO_TypeDef, BSRR):
+            // Set has priority over reset when both bits are written
+            port.ODR = (port.ODR & ~(value >> 16)) | (value & 0xFFFFU);
+            break;
+        case offsetof(GPIO_TypeDef, BRR): port.ODR &= ~(value & 0xFFFFU); break;
+        case offsetof(GPIO_TypeDef, IDR): return;  // Read-only
+        default: std::memcpy(reinterpret_cast<uint8_t*>(&port) + offset, &value, sizeof(value)); break;
+    }
+    RefreshIdr(index);
+}
+
+const uint8_t* FlashMemory(std::uintptr_t address) {
+    if (address < FLASH_BASE || address >= FLASH_BASE + FLASH_SIZE) {
+        Fail("address is not in simulated flash", address);
+    }
+    return flash.data() + (address - FLASH_BASE);
+}
+
+void EraseFlash() {
+    std::fill(flash.begin(), flash.end(), 0xFF);
+}
+
+void Reset() {
+    for (std::size_t i = 0; i < kGpioPorts; ++i) {
+        gpio_ports[i] = {};
+        gpio_ports[i].MODER = kModerReset;
+        gpio_inputs[i] = 0;
+    }
+    exti = {};
+    syscfg = {};
+    dwt = {};
+    core_debug = {};
+    // Time advances in whole ticks, so the down-counter always reads as a tick just begun
+    systick = {.CTRL = 0x7, .LOAD = 80'000 - 1, .VAL = 80'000 - 1, .CALIB = 0};
+    for (ADC_TypeDef& adc : adc_registers) adc = {};
+    for (USART_TypeDef& usart : usart_registers) usart = {};
+    for (TIM_TypeDef& tim : tim_registers) tim = {};
+    for (DAC_TypeDef& dac : dac_registers) dac = {};
+    adcs.clear();
+    uarts.clear();
+    dacs.clear();
+    uwTick = 0;
+    primask = 0;
+    servicing = false;
+    flash_locked = true;
+    SystemCoreClock = 80'000'000;
+}
+
+void AdvanceTime(uint32_t ms) {
+    uwTick = uwTick + ms;
+    if ((core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        dwt.CYCCNT += ms * (SystemCoreClock / 1000U);
+    }
+    ServiceInterrupts();
+}
+
+bool ServiceInterrupts() {
+    if (primask != 0 || servicing) {
+        return false;
+    }
+
+    servicing = true;
+    bool serviced = false;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (auto& [huart, state] : uarts) {
+            if (state.dma_busy && state.auto_complete) {
+                CompleteUartDma(*huart);
+                progress = serviced = true;
+            }
+        }
+    }
+    servicing = false;
+    return serviced;
+}
+
+void SetInput(GPIO_TypeDef* port, uint16_t pins, bool high) {
+    const std::size_t index = PortIndex(port);
+    const uint16_t before = static_cast<uint16_t>(gpio_ports[index].IDR);
+    gpio_inputs[index] = high ? (gpio_inputs[index] | pins) : (gpio_inputs[index] & ~pins);
+    RefreshIdr(index);
+    const uint16_t after = static_cast<uint16_t>(gpio_ports[index].IDR);
+
+    const uint16_t rising = ~before & after & exti.RTSR1;
+    const uint16_t falling = before & ~after & exti.FTSR1;
+    const uint16_t lines = (rising | falling) & exti.IMR1;
+    if (lines != 0) {
+        TriggerExti(lines);
+    }
+}
+
+void TriggerExti(uint16_t lines) {
+    exti.PR1.Raise(lines);
+    DispatchExtiVectors(lines);
+}
+
+void SetAdcWaveform(ADC_HandleTypeDef& hadc, Waveform wave) {
+    AdcState& state = adcs[&hadc];
+    state.waveform = std::move(wave);
+    state.sample_index = 0;
+}
+
+void SetAdcChannelWaveform(ADC_HandleTypeDef& hadc, uint32_t channel, Waveform wave) {
+    AdcState& state = adcs[&hadc];
+    state.channel_waveforms[channel] = std::move(wave);
+    state.channel_sample_index[channel] = 0;
+}
+
+void RunAdc(ADC_HandleTypeDef& hadc, std::size_t conversions) {
+    AdcState& state = adcs[&hadc];
+    for (std::size_t n = 0; n < conversions && state.running; ++n) {
+        // Without a configured sequence, the one channel is whichever the watchdog watches
+        const bool sequenced = !state.sequence.empty();
+        const uint32_t channel = sequenced ? state.sequence[state.rank] : state.watchdog_channel;
+        if (sequenced && ++state.rank == state.sequence.size()) {
+            state.rank = 0;
+        }
+
+        uint32_t value = Convert(state, channel);
+        if (hadc.Init.OversamplingMode == ENABLE) {
+            // The accumulator sums Ratio conversions; DR keeps the low 16 bits of the shifted sum
+            for (uint32_t i = 1; i < hadc.Init.Oversampling.Ratio; ++i) {
+                value += Convert(state, channel);
+            }
+            value = (value >> hadc.Init.Oversampling.RightBitShift) & 0xFFFFU;
+        }
+        hadc.Instance->DR = value;
+        hadc.Instance->ISR |= ADC_FLAG_EOC;
+
+        const bool watched = state.watchdog && (state.watchdog_all || channel == state.watchdog_channel);
+        if (watched && (value < state.watchdog_low || value > state.watchdog_high)) {
+            hadc.Instance->ISR |= ADC_FLAG_AWD1;
+            if (hadc.Instance->IER & ADC_IT_AWD1) {
+                HAL_ADC_LevelOutOfWindowCallback(&hadc);
+                hadc.Instance->ISR &= ~ADC_FLAG_AWD1;
+            }
+        }
+
+        if (!state.dma) {
+            continue;
+        }
+        StoreSample(hadc, state, value);
+        state.position++;
+        if (state.position == state.length / 2) {
+            HAL_ADC_ConvHalfCpltCallback(&hadc);
+        }
+        if (state.position == state.length) {
+            state.position = 0;
+            HAL_ADC_ConvCpltCallback(&hadc);
+            if (hadc.DMA_Handle != nullptr && hadc.DMA_Handle->Init.Mode != DMA_CIRCULAR) {
+                state.running = false;
+            }
+        }
+    }
+}
+
+void RunDac(DAC_HandleTypeDef& hdac, std::size_t triggers) {
+    for (std::size_t n = 0; n < triggers; ++n) {
+        TriggerDacChannel(hdac, DAC_CHANNEL_1);
+        TriggerDacChannel(hdac, DAC_CHANNEL_2);
+    }
+}
+
+std::string& UartOutput(UART_HandleTypeDef& huart) {
+    return uarts[&huart].output;
+}
+
+void SetUartDmaAutoComplete(UART_HandleTypeDef& huart, bool enabled) {
+    uarts[&huart].auto_complete = enabled;
+}
+
+bool HalfCompleteUartDma(UART_HandleTypeDef& huart) {
+    UartState& state = uarts[&huart];
+    if (!state.dma_busy || state.dma_half_done) {
+        return false;
+    }
+
+    // The DMA has read the first half; the callback may let the producer overwrite it
+    state.output.append(reinterpret_cast<const char*>(state.dma_data), state.dma_length / 2);
+    state.dma_half_done = true;
+    HAL_UART_TxHalfCpltCallback(&huart);
+    return true;
+}
+
+bool CompleteUartDma(UART_HandleTypeDef& huart) {
+    UartState& state = uarts[&huart];
+    if (!state.dma_busy) {
+        return false;
+    }
+
+    HalfCompleteUartDma(huart);
+    const uint16_t half = state.dma_length / 2;
+    state.output.append(reinterpret_cast<const char*>(state.dma_data) + half, state.dma_length - half);
+    // The handle is ready again before the complete callback, so it may start the next transfer
+    state.dma_busy = false;
+    HAL_UART_TxCpltCallback(&huart);
+    return true;
+}
+
+void InjectUartRx(UART_HandleTypeDef& huart, std::string_view bytes) {
+    UartState& state = uarts[&huart];
+    state.rx.insert(state.rx.end(), bytes.begin(), bytes.end());
+}
+
+void ReceiveUart(UART_HandleTypeDef& huart, std::string_view bytes, bool idle) {
+    UartState& state = uarts[&huart];
+    for (const char byte : bytes) {
+        // The callbacks may stop or restart reception
+        if (huart.RxState != HAL_UART_STATE_BUSY_RX) {
+            return;
+        }
+        state.rx_dma_data[state.rx_dma_position++] = static_cast<uint8_t>(byte);
+        if (state.rx_dma_position == state.rx_dma_length / 2) {
+            RaiseRxEvent(huart, HAL_UART_RXEVENT_HT, state.rx_dma_position);
+        } else if (state.rx_dma_position == state.rx_dma_length) {
+            state.rx_dma_position = 0;
+            RaiseRxEvent(huart, HAL_UART_RXEVENT_TC, state.rx_dma_length);
+        }
+    }
+    if (idle && huart.RxState == HAL_UART_STATE_BUSY_RX && state.rx_dma_position != 0) {
+        RaiseRxEvent(huart, HAL_UART_RXEVENT_IDLE, state.rx_dma_position);
+    }
+}
+
+void RaiseUartError(UART_HandleTypeDef& huart, uint32_t errors) {
+    huart.ErrorCode = errors;
+    // With DMAR set the HAL treats every error as blocking; without it, only an overrun
+    if ((errors & HAL_UART_ERROR_ORE) != 0 || uarts[&huart].rx_dma_data != nullptr) {
+        HAL_UART_AbortReceive(&huart);
+    }
+    HAL_UART_ErrorCallback(&huart);
+    huart.ErrorCode = HAL_UART_ERROR_NONE;
+}
+
+}  // namespace sim
+
+// -----------------------------------------------------------------------------
+// Core / tick
+// -----------------------------------------------------------------------------
+extern "C" uint32_t HAL_GetTick(void) {
+    sim::ServiceInterrupts();
+    return uwTick;
+}
+
+extern "C" uint32_t HAL_GetTickFreq(void) {
+    return 1U;  // HAL_TICK_FREQ_1KHZ
+}
+
+extern "C" void HAL_Delay(uint32_t Delay) {
+    sim::AdvanceTime(Delay);
+}
+
+extern "C" void HAL_IncTick(void) {
+    sim::AdvanceTime(1);
+}
+
+extern "C" void HAL_SuspendTick(void) {
+}
+
+extern "C" void HAL_ResumeTick(void) {
+}
+
+extern "C" void __disable_irq(void) {
+    sim::primask = 1;
+}
+
+extern "C" void __enable_irq(void) {
+    sim::primask = 0;
+    sim::ServiceInterrupts();
+}
+
+extern "C" uint32_t __get_PRIMASK(void) {
+    return sim::primask;
+}
+
+extern "C" void __set_PRIMASK(uint32_t priMask) {
+    sim::primask = priMask;
+    sim::ServiceInterrupts();
+}
+
+extern "C" void __WFI(void) {
+    // Something pending wakes the core at once; otherwise the next SysTick does
+    if (!sim::ServiceInterrupts()) {
+        sim::AdvanceTime(1);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// GPIO / EXTI
+// -----------------------------------------------------------------------------
+// Writes the same fields as the L4 HAL for each mode (e.g. speed only for outputs)
+extern "C" void HAL_GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_Init) {
+    const uint32_t mode = GPIO_Init->Mode & 0x3U;
+    for (uint32_t pin = 0; pin < 16; ++pin) {
+        const uint32_t bit = 1U << pin;
+        if ((GPIO_Init->Pin & bit) == 0) {
+            continue;
+        }
+
+        const uint32_t shift = pin * 2;
+        if (mode == GPIO_MODE_OUTPUT_PP || mode == GPIO_MODE_AF_PP) {
+            GPIOx->OSPEEDR = (GPIOx->OSPEEDR & ~(0x3U << shift)) | (GPIO_Init->Speed << shift);
+            GPIOx->OTYPER = (GPIOx->OTYPER & ~bit) | (((GPIO_Init->Mode >> 4) & 0x1U) << pin);
+        }
+        if (mode == GPIO_MODE_ANALOG) {
+            GPIOx->ASCR = (GPIOx->ASCR & ~bit) | (((GPIO_Init->Mode >> 3) & 0x1U) << pin);
+        }
+        if (mode != GPIO_MODE_ANALOG || GPIO_Init->Pull != GPIO_PULLUP) {
+            GPIOx->PUPDR = (GPIOx->PUPDR & ~(0x3U << shift)) | (GPIO_Init->Pull << shift);
+        }
+        if (mode == GPIO_MODE_AF_PP) {
+            const uint32_t af_shift = (pin % 8) * 4;
+            GPIOx->AFR[pin / 8] = (GPIOx->AFR[pin / 8] & ~(0xFU << af_shift)) | (GPIO_Init->Alternate << af_shift);
+        }
+        GPIOx->MODER = (GPIOx->MODER & ~(0x3U << shift)) | (mode << shift);
+
+        // EXTI_MODE (bit 28), EXTI_IT (bit 16), EXTI_EVT (bit 17), RISING_EDGE (bit 20), FALLING_EDGE (bit 21)
+        if (GPIO_Init->Mode & 0x10000000U) {
+            const uint32_t cr_shift = (pin % 4) * 4;
+            sim::syscfg.EXTICR[pin / 4] = (sim::syscfg.EXTICR[pin / 4] & ~(0xFU << cr_shift)) |
+                                          (static_cast<uint32_t>(sim::PortIndex(GPIOx)) << cr_shift);
+            sim::exti.RTSR1 = (GPIO_Init->Mode & 0x00100000U) ? (sim::exti.RTSR1 | bit) : (sim::exti.RTSR1 & ~bit);
+            sim::exti.FTSR1 = (GPIO_Init->Mode & 0x00200000U) ? (sim::exti.FTSR1 | bit) : (sim::exti.FTSR1 & ~bit);
+            sim::exti.EMR1 = (GPIO_Init->Mode & 0x00020000U) ? (sim::exti.EMR1 | bit) : (sim::exti.EMR1 & ~bit);
+            sim::exti.IMR1 = (GPIO_Init->Mode & 0x00010000U) ? (sim::exti.IMR1 | bit) : (sim::exti.IMR1 & ~bit);
+        }
+    }
+    sim::RefreshIdr(sim::PortIndex(GPIOx));
+}
+
+extern "C" void HAL_GPIO_DeInit(GPIO_TypeDef* GPIOx, uint32_t GPIO_Pin) {
+    for (uint32_t pin = 0; pin < 16; ++pin) {
+        const uint32_t bit = 1U << pin;
+        if ((GPIO_Pin & bit) == 0) {
+            continue;
+        }
+
+        const uint32_t shift = pin * 2;
+        GPIOx->MODER |= 0x3U << shift;
+        GPIOx->PUPDR &= ~(0x3U << shift);
+        GPIOx->OSPEEDR &= ~(0x3U << shift);
+        GPIOx->OTYPER &= ~bit;
+        GPIOx->AFR[pin / 8] &= ~(0xFU << ((pin % 8) * 4));
+        sim::exti.IMR1 &= ~bit;
+        sim::exti.RTSR1 &= ~bit;
+        sim::exti.FTSR1 &= ~bit;
+    }
+    sim::RefreshIdr(sim::PortIndex(GPIOx));
+}
+
+extern "C" GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+extern "C" void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    const std::uintptr_t base = GPIOA_BASE + sim::PortIndex(GPIOx) * sim::kGpioStride;
+    if (PinState != GPIO_PIN_RESET) {
+        sim::WriteRegister(base + offsetof(GPIO_TypeDef, BSRR), GPIO_Pin);
+    } else {
+        sim::WriteRegister(base + offsetof(GPIO_TypeDef, BRR), GPIO_Pin);
+    }
+}
+
+extern "C" void HAL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+    const std::uintptr_t base = GPIOA_BASE + sim::PortIndex(GPIOx) * sim::kGpioStride;
+    const uint32_t odr = GPIOx->ODR;
+    sim::WriteRegister(base + offsetof(GPIO_TypeDef, BSRR), ((odr & GPIO_Pin) << 16) | (~odr & GPIO_Pin));
+}
+
+extern "C" HAL_StatusTypeDef HAL_GPIO_LockPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+    GPIOx->LCKR |= (1U << 16) | GPIO_Pin;
+    return HAL_OK;
+}
+
+extern "C" void HAL_GPIO_EXTI_IRQHandler(uint16_t GPIO_Pin) {
+    if (sim::exti.PR1 & GPIO_Pin) {
+        sim::exti.PR1 = GPIO_Pin;
+        HAL_GPIO_EXTI_Callback(GPIO_Pin);
+    }
+}
+
+extern "C" [[gnu::weak]] void HAL_GPIO_EXTI_Callback(uint16_t /*GPIO_Pin*/) {
+}
+
+// -----------------------------------------------------------------------------
+// ADC
+// -----------------------------------------------------------------------------
+extern "C" HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef* hadc) {
+    sim::AdcState& state = sim::adcs[hadc];
+    if (state.running || hadc->Init.NbrOfConversion == 0) {
+        return HAL_ERROR;
+    }
+    state.sequence.assign(hadc->Init.NbrOfConversion, ADC_CHANNEL_0);
+    state.rank = 0;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef* hadc, ADC_ChannelConfTypeDef* sConfig) {
+    sim::AdcState& state = sim::adcs[hadc];
+    if (state.running) {
+        return HAL_ERROR;
+    }
+    if (state.sequence.empty()) {
+        state.sequence.assign(hadc->Init.NbrOfConversion == 0 ? 1 : hadc->Init.NbrOfConversion, ADC_CHANNEL_0);
+    }
+    if (sConfig->Rank == 0 || sConfig->Rank > state.sequence.size()) {
+        return HAL_ERROR;
+    }
+    state.sequence[sConfig->Rank - 1] = sConfig->Channel;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADCEx_InjectedConfigChannel(ADC_HandleTypeDef* hadc,
+                                                            ADC_InjectionConfTypeDef* sConfigInjected) {
+    sim::AdcState& state = sim::adcs[hadc];
+    if (state.running || sConfigInjected->InjectedRank != ADC_INJECTED_RANK_1) {
+        return HAL_ERROR;
+    }
+    state.injected = true;
+    state.injected_channel = sConfigInjected->InjectedChannel;
+    return HAL_OK;
+}
+
+// Injected conversions complete immediately and do not disturb the regular sequence
+extern "C" HAL_StatusTypeDef HAL_ADCEx_InjectedStart(ADC_HandleTypeDef* hadc) {
+    sim::AdcState& state = sim::adcs[hadc];
+    if (!state.injected) {
+        return HAL_ERROR;
+    }
+    state.injected_value = sim::Convert(state, state.injected_channel);
+    hadc->Instance->ISR |= ADC_FLAG_JEOC;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADCEx_InjectedPollForConversion(ADC_HandleTypeDef* hadc, uint32_t /*Timeout*/) {
+    return (hadc->Instance->ISR & ADC_FLAG_JEOC) ? HAL_OK : HAL_TIMEOUT;
+}
+
+extern "C" uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef* hadc, uint32_t /*InjectedRank*/) {
+    hadc->Instance->ISR &= ~ADC_FLAG_JEOC;
+    return sim::adcs[hadc].injected_value;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t /*SingleDiff*/) {
+    return sim::adcs[hadc].running ? HAL_ERROR : HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc) {
+    sim::AdcState& state = sim::adcs[hadc];
+    state.running = true;
+    state.dma = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc) {
+    sim::adcs[hadc].running = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length) {
+    if (pData == nullptr || Length == 0) {
+        return HAL_ERROR;
+    }
+
+    sim::AdcState& state = sim::adcs[hadc];
+    state.running = true;
+    state.dma = true;
+    state.buffer = pData;
+    state.length = Length;
+    state.position = 0;
+    state.rank = 0;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef* hadc) {
+    sim::AdcState& state = sim::adcs[hadc];
+    state.running = false;
+    state.dma = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc, uint32_t /*Timeout*/) {
+    if (!sim::adcs[hadc].running) {
+        return HAL_ERROR;
+    }
+    if ((hadc->Instance->ISR & ADC_FLAG_EOC) == 0) {
+        sim::RunAdc(*hadc, 1);
+    }
+    return HAL_OK;
+}
+
+extern "C" uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef* hadc) {
+    hadc->Instance->ISR &= ~ADC_FLAG_EOC;
+    return hadc->Instance->DR;
+}
+
+extern "C" HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef* hadc,
+                                                     ADC_AnalogWDGConfTypeDef* AnalogWDGConfig) {
+    sim::AdcState& state = sim::adcs[hadc];
+
+    // Like the L4 HAL, refuse to reconfigure while conversions are running
+    if (state.running) {
+        return HAL_ERROR;
+    }
+
+    state.watchdog = AnalogWDGConfig->WatchdogMode != ADC_ANALOGWATCHDOG_NONE;
+    state.watchdog_all = AnalogWDGConfig->WatchdogMode == ADC_ANALOGWATCHDOG_ALL_REG;
+    state.watchdog_channel = AnalogWDGConfig->Channel;
+    state.watchdog_low = AnalogWDGConfig->LowThreshold;
+    state.watchdog_high = AnalogWDGConfig->HighThreshold;
+    hadc->Instance->ISR &= ~ADC_FLAG_AWD1;
+    if (AnalogWDGConfig->ITMode == ENABLE) {
+        hadc->Instance->IER |= ADC_IT_AWD1;
+    } else {
+        hadc->Instance->IER &= ~ADC_IT_AWD1;
+    }
+    return HAL_OK;
+}
+
+extern "C" [[gnu::weak]] void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* /*hadc*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* /*hadc*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef* /*hadc*/) {
+}
+
+// -----------------------------------------------------------------------------
+// FLASH
+// -----------------------------------------------------------------------------
+extern "C" HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+    sim::flash_locked = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+    sim::flash_locked = true;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Program(uint32_t /*TypeProgram*/, uint32_t Address, uint64_t Data) {
+    if (sim::flash_locked || (Address % 8) != 0 || Address < FLASH_BASE || Address + 8 > FLASH_BASE + FLASH_SIZE) {
+        return HAL_ERROR;
+    }
+    uint8_t* target = sim::flash.data() + (Address - FLASH_BASE);
+    if (std::any_of(target, target + 8, [](uint8_t byte) { return byte != 0xFF; })) {
+        return HAL_ERROR;  // PROGERR: double word not erased
+    }
+    std::memcpy(target, &Data, sizeof(Data));
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* PageError) {
+    *PageError = 0xFFFFFFFFU;
+    const uint32_t bank_offset = (pEraseInit->Banks == FLASH_BANK_2) ? FLASH_BANK_SIZE : 0;
+    if (sim::flash_locked || pEraseInit->Page + pEraseInit->NbPages > FLASH_BANK_SIZE / FLASH_PAGE_SIZE) {
+        *PageError = pEraseInit->Page;
+        return HAL_ERROR;
+    }
+    uint8_t* first = sim::flash.data() + bank_offset + pEraseInit->Page * FLASH_PAGE_SIZE;
+    std::fill(first, first + pEraseInit->NbPages * FLASH_PAGE_SIZE, 0xFF);
+    return HAL_OK;
+}
+
+// -----------------------------------------------------------------------------
+// DAC
+// -----------------------------------------------------------------------------
+// Only the triggered mode is modelled: DOR updates in sim::RunDac()
+extern "C" HAL_StatusTypeDef HAL_DAC_Start(DAC_HandleTypeDef* hdac, uint32_t Channel) {
+    hdac->Instance->CR |= (DAC_CR_EN1 | DAC_CR_TEN1) << sim::DacShift(Channel);
+    sim::DacChannel(hdac, Channel).dma = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_DAC_Stop(DAC_HandleTypeDef* hdac, uint32_t Channel) {
+    hdac->Instance->CR &= ~(DAC_CR_EN1 << sim::DacShift(Channel));
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_DAC_Start_DMA(DAC_HandleTypeDef* hdac, uint32_t Channel, const uint32_t* pData,
+                                               uint32_t Length, uint32_t /*Alignment*/) {
+    if (pData == nullptr || Length == 0) {
+        return HAL_ERROR;
+    }
+
+    sim::DacChannelState& state = sim::DacChannel(hdac, Channel);
+    hdac->Instance->CR |= (DAC_CR_EN1 | DAC_CR_TEN1 | DAC_CR_DMAEN1) << sim::DacShift(Channel);
+    state.dma = true;
+    state.buffer = reinterpret_cast<const uint16_t*>(pData);
+    state.length = Length;
+    state.position = 0;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_DAC_Stop_DMA(DAC_HandleTypeDef* hdac, uint32_t Channel) {
+    sim::DacChannel(hdac, Channel).dma = false;
+    hdac->Instance->CR &= ~(DAC_CR_DMAEN1 << sim::DacShift(Channel));
+    return HAL_DAC_Stop(hdac, Channel);
+}
+
+extern "C" HAL_StatusTypeDef HAL_DAC_SetValue(DAC_HandleTypeDef* hdac, uint32_t Channel, uint32_t /*Alignment*/,
+                                              uint32_t Data) {
+    ((Channel == DAC_CHANNEL_1) ? hdac->Instance->DHR12R1 : hdac->Instance->DHR12R2) = Data & 0xFFFU;
+    return HAL_OK;
+}
+
+extern "C" uint32_t HAL_DAC_GetValue(const DAC_HandleTypeDef* hdac, uint32_t Channel) {
+    return (Channel == DAC_CHANNEL_1) ? hdac->Instance->DOR1 : hdac->Instance->DOR2;
+}
+
+extern "C" HAL_StatusTypeDef HAL_DACEx_TriangleWaveGenerate(DAC_HandleTypeDef* hdac, uint32_t Channel,
+                                                            uint32_t Amplitude) {
+    const uint32_t shift = sim::DacShift(Channel);
+    hdac->Instance->CR = (hdac->Instance->CR & ~((DAC_CR_WAVE1 | DAC_CR_MAMP1) << shift)) |
+                         ((DAC_CR_WAVE1_1 | Amplitude) << shift);
+    sim::DacChannelState& state = sim::DacChannel(hdac, Channel);
+    state.triangle = 0;
+    state.falling = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_DACEx_NoiseWaveGenerate(DAC_HandleTypeDef* hdac, uint32_t Channel,
+                                                         uint32_t Amplitude) {
+    const uint32_t shift = sim::DacShift(Channel);
+    hdac->Instance->CR = (hdac->Instance->CR & ~((DAC_CR_WAVE1 | DAC_CR_MAMP1) << shift)) |
+                         ((DAC_CR_WAVE1_0 | Amplitude) << shift);
+    return HAL_OK;
+}
+
+extern "C" [[gnu::weak]] void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef* /*hdac*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef* /*hdac*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_DACEx_ConvHalfCpltCallbackCh2(DAC_HandleTypeDef* /*hdac*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_DACEx_ConvCpltCallbackCh2(DAC_HandleTypeDef* /*hdac*/) {
+}
+
+// -----------------------------------------------------------------------------
+// UART
+// -----------------------------------------------------------------------------
+extern "C" HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size,
+                                               uint32_t /*Timeout*/) {
+    if (pData == nullptr || Size == 0) {
+        return HAL_ERROR;
+    }
+
+    sim::uarts[huart].output.append(reinterpret_cast<const char*>(pData), Size);
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size) {
+    if (pData == nullptr || Size == 0 || huart->hdmatx == nullptr) {
+        return HAL_ERROR;
+    }
+
+    sim::UartState& state = sim::uarts[huart];
+    if (state.dma_busy) {
+        return HAL_BUSY;
+    }
+    state.dma_data = pData;
+    state.dma_length = Size;
+    state.dma_busy = true;
+    state.dma_half_done = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size,
+                                              uint32_t Timeout) {
+    if (huart->RxState == HAL_UART_STATE_BUSY_RX) {
+        return HAL_BUSY;
+    }
+    sim::UartState& state = sim::uarts[huart];
+    if (state.rx.size() < Size) {
+        sim::AdvanceTime(Timeout);
+        return HAL_TIMEOUT;
+    }
+
+    for (uint16_t i = 0; i < Size; ++i) {
+        pData[i] = state.rx.front();
+        state.rx.pop_front();
+    }
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size) {
+    if (pData == nullptr || Size == 0 || huart->hdmarx == nullptr) {
+        return HAL_ERROR;
+    }
+    if (huart->RxState == HAL_UART_STATE_BUSY_RX) {
+        return HAL_BUSY;
+    }
+
+    sim::UartState& state = sim::uarts[huart];
+    state.rx_dma_data = pData;
+    state.rx_dma_length = Size;
+    state.rx_dma_position = 0;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* huart) {
+    sim::uarts[huart].dma_busy = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef* huart) {
+    sim::UartState& state = sim::uarts[huart];
+    state.rx_dma_data = nullptr;
+    state.rx_dma_length = 0;
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+extern "C" HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(UART_HandleTypeDef* huart) {
+    return sim::uarts[huart].rx_event;
+}
+
+extern "C" [[gnu::weak]] void HAL_UART_TxHalfCpltCallback(UART_HandleTypeDef* /*huart*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_UART_TxCpltCallback(UART_HandleTypeDef* /*huart*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* /*huart*/, uint16_t /*Size*/) {
+}
+
+extern "C" [[gnu::weak]] void HAL_UART_ErrorCallback(UART_HandleTypeDef* /*huart*/) {
+}
+
+// -----------------------------------------------------------------------------
+// TIM
+// -----------------------------------------------------------------------------
+extern "C" HAL_StatusTypeDef HAL_TIM_Encoder_Start(TIM_HandleTypeDef* /*htim*/, uint32_t /*Channel*/) {
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_TIM_Encoder_Stop(TIM_HandleTypeDef* /*htim*/, uint32_t /*Channel*/) {
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef* htim) {
+    htim->Instance->CR1 |= 0x1U;  // CEN
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef* htim) {
+    htim->Instance->CR1 &= ~0x1U;
+    return HAL_OK;
+}
+
+// PWM outputs are not modelled; starting a channel enables the counter and, on
+// TIM1 (a break instance), the main output enable like the real HAL
+extern "C" HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t /*Channel*/) {
+    if (htim->Instance == TIM1) {
+        htim->Instance->BDTR |= TIM_BDTR_MOE;
+    }
+    htim->Instance->CR1 |= 0x1U;  // CEN
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef* htim, uint32_t /*Channel*/) {
+    htim->Instance->CR1 &= ~0x1U;
+    return HAL_OK;
+}
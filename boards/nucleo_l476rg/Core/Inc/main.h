@@ -53,6 +53,7 @@ extern "C" {
 void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
+void BoardInit(void);
 int Entry(void);
 /* USER CODE END EFP */
 
@@ -60,16 +61,24 @@ int Entry(void);
 #define B1_Pin GPIO_PIN_13
 #define B1_GPIO_Port GPIOC
 #define B1_EXTI_IRQn EXTI15_10_IRQn
+#define LIGHT_SENSE_Pin GPIO_PIN_0
+#define LIGHT_SENSE_GPIO_Port GPIOC
+#define VSUPPLY_SENSE_Pin GPIO_PIN_1
+#define VSUPPLY_SENSE_GPIO_Port GPIOC
 #define USART_TX_Pin GPIO_PIN_2
 #define USART_TX_GPIO_Port GPIOA
 #define USART_RX_Pin GPIO_PIN_3
 #define USART_RX_GPIO_Port GPIOA
+#define ENC_B_Pin GPIO_PIN_1
+#define ENC_B_GPIO_Port GPIOA
 #define LD2_Pin GPIO_PIN_5
 #define LD2_GPIO_Port GPIOA
 #define TMS_Pin GPIO_PIN_13
 #define TMS_GPIO_Port GPIOA
 #define TCK_Pin GPIO_PIN_14
 #define TCK_GPIO_Port GPIOA
+#define ENC_A_Pin GPIO_PIN_15
+#define ENC_A_GPIO_Port GPIOA
 #define SWO_Pin GPIO_PIN_3
 #define SWO_GPIO_Port GPIOB
 
@@ -43,7 +43,7 @@ void MX_ADC1_Init(void) {
     /** Common config
      */
     hadc1.Instance = ADC1;
-    hadc1.Init.ClockPrescaler = ADC_CLOCK_ASYNC_DIV256;
+    hadc1.Init.ClockPrescaler = ADC_CLOCK_ASYNC_DIV16;
     hadc1.Init.Resolution = ADC_RESOLUTION_12B;
     hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
     hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
@@ -85,7 +85,6 @@ void MX_ADC1_Init(void) {
 }
 
 void HAL_ADC_MspInit(ADC_HandleTypeDef* adcHandle) {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
     RCC_PeriphCLKInitTypeDef PeriphClkInit = {0};
     if (adcHandle->Instance == ADC1) {
         /* USER CODE BEGIN ADC1_MspInit 0 */
@@ -110,14 +109,7 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* adcHandle) {
         /* ADC1 clock enable */
         __HAL_RCC_ADC_CLK_ENABLE();
 
-        __HAL_RCC_GPIOA_CLK_ENABLE();
-        /**ADC1 GPIO Configuration
-        PA0     ------> ADC1_IN5
-        */
-        GPIO_InitStruct.Pin = GPIO_PIN_0;
-        GPIO_InitStruct.Mode = GPIO_MODE_ANALOG_ADC_CONTROL;
-        GPIO_InitStruct.Pull = GPIO_NOPULL;
-        HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+        /* Pins: board::pins::kPinMap, applied by BoardInit() before any MX_*_Init() */
 
         /* ADC1 DMA Init */
         /* ADC1 Init */
@@ -136,6 +128,10 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* adcHandle) {
 
         __HAL_LINKDMA(adcHandle, DMA_Handle, hdma_adc1);
 
+        /* ADC1 interrupt Init */
+        HAL_NVIC_SetPriority(ADC1_2_IRQn, 0, 0);
+        HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
+
         /* USER CODE BEGIN ADC1_MspInit 1 */
 
         /* USER CODE END ADC1_MspInit 1 */
@@ -151,12 +147,19 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef* adcHandle) {
         __HAL_RCC_ADC_CLK_DISABLE();
 
         /**ADC1 GPIO Configuration
+        PC0     ------> ADC1_IN1
+        PC1     ------> ADC1_IN2
         PA0     ------> ADC1_IN5
         */
+        HAL_GPIO_DeInit(GPIOC, LIGHT_SENSE_Pin | VSUPPLY_SENSE_Pin);
+
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_0);
 
         /* ADC1 DMA DeInit */
         HAL_DMA_DeInit(adcHandle->DMA_Handle);
+
+        /* ADC1 interrupt Deinit */
+        HAL_NVIC_DisableIRQ(ADC1_2_IRQn);
         /* USER CODE BEGIN ADC1_MspDeInit 1 */
 
         /* USER CODE END ADC1_MspDeInit 1 */
@@ -25,6 +25,7 @@
 /* USER CODE END 0 */
 
 DAC_HandleTypeDef hdac1;
+DMA_HandleTypeDef hdma_dac_ch1;
 
 /* DAC1 init function */
 void MX_DAC1_Init(void) {
@@ -48,7 +49,7 @@ void MX_DAC1_Init(void) {
     /** DAC channel OUT1 config
      */
     sConfig.DAC_SampleAndHold = DAC_SAMPLEANDHOLD_DISABLE;
-    sConfig.DAC_Trigger = DAC_TRIGGER_NONE;
+    sConfig.DAC_Trigger = DAC_TRIGGER_T6_TRGO;
     sConfig.DAC_OutputBuffer = DAC_OUTPUTBUFFER_ENABLE;
     sConfig.DAC_ConnectOnChipPeripheral = DAC_CHIPCONNECT_DISABLE;
     sConfig.DAC_UserTrimming = DAC_TRIMMING_FACTORY;
@@ -61,7 +62,6 @@ void MX_DAC1_Init(void) {
 }
 
 void HAL_DAC_MspInit(DAC_HandleTypeDef* dacHandle) {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
     if (dacHandle->Instance == DAC1) {
         /* USER CODE BEGIN DAC1_MspInit 0 */
 
@@ -69,14 +69,24 @@ void HAL_DAC_MspInit(DAC_HandleTypeDef* dacHandle) {
         /* DAC1 clock enable */
         __HAL_RCC_DAC1_CLK_ENABLE();
 
-        __HAL_RCC_GPIOA_CLK_ENABLE();
-        /**DAC1 GPIO Configuration
-        PA4     ------> DAC1_OUT1
-        */
-        GPIO_InitStruct.Pin = GPIO_PIN_4;
-        GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
-        GPIO_InitStruct.Pull = GPIO_NOPULL;
-        HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+        /* Pins: board::pins::kPinMap, applied by BoardInit() before any MX_*_Init() */
+
+        /* DAC1 DMA Init */
+        /* DAC_CH1 Init */
+        hdma_dac_ch1.Instance = DMA1_Channel3;
+        hdma_dac_ch1.Init.Request = DMA_REQUEST_6;
+        hdma_dac_ch1.Init.Direction = DMA_MEMORY_TO_PERIPH;
+        hdma_dac_ch1.Init.PeriphInc = DMA_PINC_DISABLE;
+        hdma_dac_ch1.Init.MemInc = DMA_MINC_ENABLE;
+        hdma_dac_ch1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_dac_ch1.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+        hdma_dac_ch1.Init.Mode = DMA_CIRCULAR;
+        hdma_dac_ch1.Init.Priority = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_dac_ch1) != HAL_OK) {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(dacHandle, DMA_Handle1, hdma_dac_ch1);
 
         /* USER CODE BEGIN DAC1_MspInit 1 */
 
@@ -97,6 +107,8 @@ void HAL_DAC_MspDeInit(DAC_HandleTypeDef* dacHandle) {
         */
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_4);
 
+        /* DAC1 DMA DeInit */
+        HAL_DMA_DeInit(dacHandle->DMA_Handle1);
         /* USER CODE BEGIN DAC1_MspDeInit 1 */
 
         /* USER CODE END DAC1_MspDeInit 1 */
@@ -65,7 +65,7 @@ void MX_GPIO_Init(void) {
     HAL_GPIO_Init(LD2_GPIO_Port, &GPIO_InitStruct);
 
     /* EXTI interrupt init*/
-    HAL_NVIC_SetPriority(EXTI15_10_IRQn, 0, 0);
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, 3, 0);
     HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
 }
 
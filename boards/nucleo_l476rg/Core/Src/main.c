@@ -23,6 +23,8 @@
 #include "dac.h"
 #include "dma.h"
 #include "gpio.h"
+#include "rtc.h"
+#include "tim.h"
 #include "usart.h"
 
 /* Private includes ----------------------------------------------------------*/
@@ -85,14 +87,19 @@ int main(void) {
 
     /* USER CODE BEGIN SysInit */
 
+    BoardInit();
+
     /* USER CODE END SysInit */
 
     /* Initialize all configured peripherals */
-    MX_GPIO_Init();
     MX_DMA_Init();
     MX_USART2_UART_Init();
     MX_ADC1_Init();
     MX_DAC1_Init();
+    MX_TIM2_Init();
+    MX_RTC_Init();
+    MX_TIM1_Init();
+    MX_TIM6_Init();
     /* USER CODE BEGIN 2 */
 
     Entry();
@@ -123,10 +130,16 @@ void SystemClock_Config(void) {
         Error_Handler();
     }
 
+    /** Configure LSE Drive Capability
+     */
+    HAL_PWR_EnableBkUpAccess();
+    __HAL_RCC_LSEDRIVE_CONFIG(RCC_LSEDRIVE_LOW);
+
     /** Initializes the RCC Oscillators according to the specified parameters
      * in the RCC_OscInitTypeDef structure.
      */
-    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI | RCC_OSCILLATORTYPE_LSE;
+    RCC_OscInitStruct.LSEState = RCC_LSE_ON;
     RCC_OscInitStruct.HSIState = RCC_HSI_ON;
     RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
     RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
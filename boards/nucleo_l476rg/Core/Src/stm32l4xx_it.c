@@ -57,6 +57,12 @@
 
 /* External variables --------------------------------------------------------*/
 extern DMA_HandleTypeDef hdma_adc1;
+extern ADC_HandleTypeDef hadc1;
+extern DMA_HandleTypeDef hdma_dac_ch1;
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern DMA_HandleTypeDef hdma_usart2_tx;
+extern RTC_HandleTypeDef hrtc;
+extern UART_HandleTypeDef huart2;
 /* USER CODE BEGIN EV */
 
 /* USER CODE END EV */
@@ -185,6 +191,19 @@ void SysTick_Handler(void) {
 /* please refer to the startup file (startup_stm32l4xx.s).                    */
 /******************************************************************************/
 
+/**
+ * @brief This function handles RTC wake-up interrupt through EXTI line 20.
+ */
+void RTC_WKUP_IRQHandler(void) {
+    /* USER CODE BEGIN RTC_WKUP_IRQn 0 */
+
+    /* USER CODE END RTC_WKUP_IRQn 0 */
+    HAL_RTCEx_WakeUpTimerIRQHandler(&hrtc);
+    /* USER CODE BEGIN RTC_WKUP_IRQn 1 */
+
+    /* USER CODE END RTC_WKUP_IRQn 1 */
+}
+
 /**
  * @brief This function handles DMA1 channel1 global interrupt.
  */
@@ -199,16 +218,81 @@ void DMA1_Channel1_IRQHandler(void) {
 }
 
 /**
- * @brief This function handles EXTI line[15:10] interrupts.
+ * @brief This function handles DMA1 channel3 global interrupt.
+ */
+void DMA1_Channel3_IRQHandler(void) {
+    /* USER CODE BEGIN DMA1_Channel3_IRQn 0 */
+
+    /* USER CODE END DMA1_Channel3_IRQn 0 */
+    HAL_DMA_IRQHandler(&hdma_dac_ch1);
+    /* USER CODE BEGIN DMA1_Channel3_IRQn 1 */
+
+    /* USER CODE END DMA1_Channel3_IRQn 1 */
+}
+
+/**
+ * @brief This function handles DMA1 channel6 global interrupt.
+ */
+void DMA1_Channel6_IRQHandler(void) {
+    /* USER CODE BEGIN DMA1_Channel6_IRQn 0 */
+
+    /* USER CODE END DMA1_Channel6_IRQn 0 */
+    HAL_DMA_IRQHandler(&hdma_usart2_rx);
+    /* USER CODE BEGIN DMA1_Channel6_IRQn 1 */
+
+    /* USER CODE END DMA1_Channel6_IRQn 1 */
+}
+
+/**
+ * @brief This function handles DMA1 channel7 global interrupt.
+ */
+void DMA1_Channel7_IRQHandler(void) {
+    /* USER CODE BEGIN DMA1_Channel7_IRQn 0 */
+
+    /* USER CODE END DMA1_Channel7_IRQn 0 */
+    HAL_DMA_IRQHandler(&hdma_usart2_tx);
+    /* USER CODE BEGIN DMA1_Channel7_IRQn 1 */
+
+    /* USER CODE END DMA1_Channel7_IRQn 1 */
+}
+
+/**
+ * @brief This function handles ADC1 and ADC2 interrupts.
+ */
+void ADC1_2_IRQHandler(void) {
+    /* USER CODE BEGIN ADC1_2_IRQn 0 */
+
+    /* USER CODE END ADC1_2_IRQn 0 */
+    HAL_ADC_IRQHandler(&hadc1);
+    /* USER CODE BEGIN ADC1_2_IRQn 1 */
+
+    /* USER CODE END ADC1_2_IRQn 1 */
+}
+
+/**
+ * @brief This function handles USART2 global interrupt.
+ */
+void USART2_IRQHandler(void) {
+    /* USER CODE BEGIN USART2_IRQn 0 */
+
+    /* USER CODE END USART2_IRQn 0 */
+    HAL_UART_IRQHandler(&huart2);
+    /* USER CODE BEGIN USART2_IRQn 1 */
+
+    /* USER CODE END USART2_IRQn 1 */
+}
+
+/**
+ * @brief This function handles RTC alarm interrupt through EXTI line 18.
  */
-void EXTI15_10_IRQHandler(void) {
-    /* USER CODE BEGIN EXTI15_10_IRQn 0 */
+void RTC_Alarm_IRQHandler(void) {
+    /* USER CODE BEGIN RTC_Alarm_IRQn 0 */
 
-    /* USER CODE END EXTI15_10_IRQn 0 */
-    HAL_GPIO_EXTI_IRQHandler(B1_Pin);
-    /* USER CODE BEGIN EXTI15_10_IRQn 1 */
+    /* USER CODE END RTC_Alarm_IRQn 0 */
+    HAL_RTC_AlarmIRQHandler(&hrtc);
+    /* USER CODE BEGIN RTC_Alarm_IRQn 1 */
 
-    /* USER CODE END EXTI15_10_IRQn 1 */
+    /* USER CODE END RTC_Alarm_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
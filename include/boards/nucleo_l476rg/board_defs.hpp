@@ -2,8 +2,10 @@
 
 #include <stm32l4xx_hal.h>
 
+#include <array>
 #include <cstdint>
 
+#include "hal/board_map.hpp"
 #include "hal/fast_gpio.hpp"
 
 namespace board::pins {
@@ -16,4 +18,111 @@ inline constexpr std::uintptr_t CONSOLE_UART_BASE = USART2_BASE;
 using StatusLed = hal::FastGpio<GPIOA_BASE, GPIO_PIN_5>;
 using UserButton = hal::FastGpio<GPIOC_BASE, GPIO_PIN_13>;
 
+// Blind motor quadrature encoder, counted in hardware by TIM2 (encoder mode, AF1)
+using EncoderA = hal::FastGpio<GPIOA_BASE, GPIO_PIN_15>;
+using EncoderB = hal::FastGpio<GPIOA_BASE, GPIO_PIN_1>;
+
+inline constexpr std::uintptr_t ENCODER_TIM_BASE = TIM2_BASE;
+
+// Motor PWM timebase (centre-aligned); channel 4 triggers the ADC through TRGO2
+inline constexpr std::uintptr_t MOTOR_PWM_TIM_BASE = TIM1_BASE;
+
+// H-bridge gate driver inputs: leg A on TIM1 CH1/CH1N, leg B on CH2/CH2N (AF1).
+// Pulled down so both switches of each leg stay off until hal::Pwm drives them.
+using MotorLegAHigh = hal::FastGpio<GPIOA_BASE, GPIO_PIN_8>;  // TIM1_CH1
+using MotorLegALow = hal::FastGpio<GPIOB_BASE, GPIO_PIN_13>;  // TIM1_CH1N
+using MotorLegBHigh = hal::FastGpio<GPIOA_BASE, GPIO_PIN_9>;  // TIM1_CH2
+using MotorLegBLow = hal::FastGpio<GPIOB_BASE, GPIO_PIN_14>;  // TIM1_CH2N
+
+// Analog front end: ADC1 inputs (CubeMX names them in main.h) and the DAC output.
+// A jumper from DacOut (A2) to MotorCurrentSense (A0) makes the calibration loopback.
+using MotorCurrentSense = hal::FastGpio<GPIOA_BASE, GPIO_PIN_0>;  // ADC1_IN5
+using SupplySense = hal::FastGpio<GPIOC_BASE, GPIO_PIN_1>;        // ADC1_IN2
+using LightSense = hal::FastGpio<GPIOC_BASE, GPIO_PIN_0>;         // ADC1_IN1
+using DacOut = hal::FastGpio<GPIOA_BASE, GPIO_PIN_4>;             // DAC1_OUT1
+
+// Debug port (SWD and SWO), left as reset configures it
+using SwdIo = hal::FastGpio<GPIOA_BASE, GPIO_PIN_13>;
+using SwdClk = hal::FastGpio<GPIOA_BASE, GPIO_PIN_14>;
+using Swo = hal::FastGpio<GPIOB_BASE, GPIO_PIN_3>;
+
+// Every pin the board uses, and the only place pins are set up: Init() runs before
+// the MX_*_Init() calls, which configure no GPIO (keep the .ioc in step for CubeMX's
+// own checks). Add a pin here first: the checks below catch clashes at compile time.
+// hal::Pwm programs the motor bridge channels.
+inline constexpr std::array kPinMap = {
+    hal::AssignPin<ConsoleTx>("console tx",
+                              {.mode = hal::PinMode::Alternate, .speed = hal::Speed::VeryHigh, .af = GPIO_AF7_USART2}),
+    hal::AssignPin<ConsoleRx>("console rx",
+                              {.mode = hal::PinMode::Alternate, .speed = hal::Speed::VeryHigh, .af = GPIO_AF7_USART2}),
+    hal::AssignPin<StatusLed>("status led", {.mode = hal::PinMode::Output}),
+    hal::AssignPin<UserButton>("user button", {.mode = hal::PinMode::ExtiFalling}),
+    hal::AssignPin<EncoderA>("encoder a",
+                             {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Up, .af = GPIO_AF1_TIM2}),
+    hal::AssignPin<EncoderB>("encoder b",
+                             {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Up, .af = GPIO_AF1_TIM2}),
+    hal::AssignPin<MotorLegAHigh>("motor a high",
+                                  {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Down, .af = GPIO_AF1_TIM1}),
+    hal::AssignPin<MotorLegALow>("motor a low",
+                                 {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Down, .af = GPIO_AF1_TIM1}),
+    hal::AssignPin<MotorLegBHigh>("motor b high",
+                                  {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Down, .af = GPIO_AF1_TIM1}),
+    hal::AssignPin<MotorLegBLow>("motor b low",
+                                 {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Down, .af = GPIO_AF1_TIM1}),
+    hal::AssignPin<MotorCurrentSense>("motor current", {.mode = hal::PinMode::AdcInput}),
+    hal::AssignPin<SupplySense>("supply sense", {.mode = hal::PinMode::AdcInput}),
+    hal::AssignPin<LightSense>("light sense", {.mode = hal::PinMode::AdcInput}),
+    hal::AssignPin<DacOut>("dac out", {.mode = hal::PinMode::Analog}),
+    hal::AssignPin<SwdIo>("swdio", {.mode = hal::PinMode::Reserved}),
+    hal::AssignPin<SwdClk>("swclk", {.mode = hal::PinMode::Reserved}),
+    hal::AssignPin<Swo>("swo", {.mode = hal::PinMode::Reserved}),
+};
+
+static_assert(hal::PinsAreWellFormed(kPinMap), "A pin map entry is not a single pin of a GPIO port");
+static_assert(hal::PinsAreUnique(kPinMap), "Two pin map entries claim the same pin");
+static_assert(hal::ExtiLinesAreUnique(kPinMap), "Two EXTI pins share a line (line n serves pin n of one port)");
+
+/**
+ * @brief Configures every pin in kPinMap (see hal::InitPins()).
+ */
+inline void Init() {
+    hal::InitPins<kPinMap>();
+}
+
+// FastGpio folds register addresses at compile time; check them against RM0351 (GPIOA @ 0x4800'0000)
+static_assert(StatusLed::kBsrr == 0x4800'0018 && StatusLed::kBrr == 0x4800'0028, "StatusLed register folding");
+static_assert(UserButton::kIdr == 0x4800'0810, "UserButton register folding");
+
 }  // namespace board::pins
+
+namespace board::dma {
+
+// DMA channels claimed by the HAL wrappers; keep in step with the .ioc DMA page
+inline constexpr std::array kChannelMap = {
+    hal::DmaAssignment{"adc1", hal::DmaRequest::Adc1, 1, 1},
+    hal::DmaAssignment{"dac1 ch1", hal::DmaRequest::DacCh1, 1, 3},
+    hal::DmaAssignment{"console rx", hal::DmaRequest::Usart2Rx, 1, 6},
+    hal::DmaAssignment{"console tx", hal::DmaRequest::Usart2Tx, 1, 7},
+};
+
+static_assert(hal::DmaAssignmentsAreValid(kChannelMap), "A DMA channel is shared or cannot serve its request");
+
+}  // namespace board::dma
+
+namespace board::clocks {
+
+// Kernel clocks set up by SystemClock_Config()/MX_ADC1_Init() (see the .ioc RCC and ADC1 pages)
+inline constexpr std::uint32_t kTim1Hz = 80'000'000;  // APB2 timer clock
+inline constexpr std::uint32_t kTim6Hz = 80'000'000;  // APB1 timer clock
+inline constexpr std::uint32_t kAdcHz = 4'000'000;    // PLLSAI1R 64 MHz / ADC_CLOCK_ASYNC_DIV16
+
+}  // namespace board::clocks
+
+namespace board::flash {
+
+// Last 2 KB page (bank 2, page 255), cut out of the FLASH region in STM32L476XX_FLASH.ld
+inline constexpr std::uintptr_t kCalibrationPage = 0x080F'F800;
+
+static_assert(kCalibrationPage == FLASH_BASE + 2 * FLASH_BANK_SIZE - FLASH_PAGE_SIZE, "Calibration page placement");
+
+}  // namespace board::flash
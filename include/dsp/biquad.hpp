@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "dsp/fixed_point.hpp"
+
+namespace dsp {
+
+/**
+ * @brief One second-order section, normalized so a0 = 1.
+ *
+ * y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ *
+ * This is the row layout of scipy.signal.butter(..., output="sos") minus the a0 column.
+ */
+struct BiquadCoefficients {
+    float b0, b1, b2, a1, a2;
+};
+
+/**
+ * @class BiquadQ15
+ * @brief Cascade of Direct Form I biquads on Q15 samples.
+ * @tparam Stages Number of second-order sections.
+ *
+ * Coefficients are stored in Q15 scaled by 2^-post_shift so that values up to
+ * 2^post_shift in magnitude (e.g. a1 = -1.9 needs post_shift = 1) are
+ * representable; the accumulator is shifted back before saturating. Each section
+ * costs one 16x16 multiply and two SMLALDs per sample: the two past inputs and
+ * the two past outputs are kept packed so each pair is one dual MAC.
+ */
+template <std::size_t Stages>
+class BiquadQ15 {
+    static_assert(Stages > 0, "Biquad cascade needs at least one stage");
+
+public:
+    /**
+     * @brief Creates the cascade with zeroed state.
+     * @param sections   Section coefficients, applied in order.
+     * @param post_shift Coefficient headroom in bits (0..14).
+     */
+    constexpr explicit BiquadQ15(const BiquadCoefficients (&sections)[Stages], unsigned post_shift = 1)
+        : shift_(15U - post_shift) {
+        const float scale = 1.0f / static_cast<float>(1U << post_shift);
+        for (std::size_t s = 0; s < Stages; ++s) {
+            const BiquadCoefficients& c = sections[s];
+            stages_[s].b0 = FloatToQ15(c.b0 * scale);
+            stages_[s].b12 = simd::Pack(FloatToQ15(c.b1 * scale), FloatToQ15(c.b2 * scale));
+            // Negated so the whole update is a sum of products
+            stages_[s].a12 = simd::Pack(FloatToQ15(-c.a1 * scale), FloatToQ15(-c.a2 * scale));
+        }
+    }
+
+    /**
+     * @brief Filters one sample through every section.
+     */
+    q15_t Process(q15_t x) {
+        for (Stage& s : stages_) {
+            std::int64_t acc = static_cast<std::int32_t>(x) * s.b0;
+            acc = simd::Smlald(s.x12, s.b12, acc);
+            acc = simd::Smlald(s.y12, s.a12, acc);
+            const q15_t y = simd::SaturateQ15(simd::SaturateQ31((acc + (1 << (shift_ - 1))) >> shift_));
+
+            // Newest in the low half: {x[n], x[n-1]} becomes {x[n-1], x[n-2]} next time
+            s.x12 = (s.x12 << 16) | static_cast<std::uint16_t>(x);
+            s.y12 = (s.y12 << 16) | static_cast<std::uint16_t>(y);
+            x = y;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Filters a block of samples.
+     * @param in  Input samples.
+     * @param out Output samples; may alias @p in.
+     * @param n   Number of samples.
+     */
+    void Process(const q15_t* in, q15_t* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Process(in[i]);
+        }
+    }
+
+    /**
+     * @brief Clears the state of every section.
+     */
+    void Reset() {
+        for (Stage& s : stages_) {
+            s.x12 = 0;
+            s.y12 = 0;
+        }
+    }
+
+private:
+    struct Stage {
+        q15_t b0 = 0;
+        std::uint32_t b12 = 0;  // {b1, b2}
+        std::uint32_t a12 = 0;  // {-a1, -a2}
+        std::uint32_t x12 = 0;  // {x[n-1], x[n-2]}
+        std::uint32_t y12 = 0;  // {y[n-1], y[n-2]}
+    };
+
+    std::array<Stage, Stages> stages_{};
+    unsigned shift_;
+};
+
+/**
+ * @class BiquadQ31
+ * @brief Cascade of Direct Form I biquads on Q31 samples.
+ * @tparam Stages Number of second-order sections.
+ *
+ * For slow, small signals (e.g. ambient light) where Q15 state would quantize
+ * away the low-frequency content. Products are accumulated in 64 bits as in
+ * CMSIS-DSP's q31 DF1: keep one bit of headroom in the input so the five Q62
+ * products cannot overflow the accumulator.
+ */
+template <std::size_t Stages>
+class BiquadQ31 {
+    static_assert(Stages > 0, "Biquad cascade needs at least one stage");
+
+public:
+    /**
+     * @brief Creates the cascade with zeroed state.
+     * @param sections   Section coefficients, applied in order.
+     * @param post_shift Coefficient headroom in bits (0..30).
+     */
+    constexpr explicit BiquadQ31(const BiquadCoefficients (&sections)[Stages], unsigned post_shift = 1)
+        : shift_(31U - post_shift) {
+        const float scale = 1.0f / static_cast<float>(1U << post_shift);
+        for (std::size_t s = 0; s < Stages; ++s) {
+            const BiquadCoefficients& c = sections[s];
+            stages_[s].b = {FloatToQ31(c.b0 * scale), FloatToQ31(c.b1 * scale), FloatToQ31(c.b2 * scale)};
+            stages_[s].a = {FloatToQ31(-c.a1 * scale), FloatToQ31(-c.a2 * scale)};
+        }
+    }
+
+    /**
+     * @brief Filters one sample through every section.
+     */
+    q31_t Process(q31_t x) {
+        for (Stage& s : stages_) {
+            std::int64_t acc = static_cast<std::int64_t>(s.b[0]) * x;
+            acc += static_cast<std::int64_t>(s.b[1]) * s.x1;
+            acc += static_cast<std::int64_t>(s.b[2]) * s.x2;
+            acc += static_cast<std::int64_t>(s.a[0]) * s.y1;
+            acc += static_cast<std::int64_t>(s.a[1]) * s.y2;
+            const q31_t y = simd::SaturateQ31(acc >> shift_);
+
+            s.x2 = s.x1;
+            s.x1 = x;
+            s.y2 = s.y1;
+            s.y1 = y;
+            x = y;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Filters a block of samples.
+     * @param in  Input samples.
+     * @param out Output samples; may alias @p in.
+     * @param n   Number of samples.
+     */
+    void Process(const q31_t* in, q31_t* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Process(in[i]);
+        }
+    }
+
+    /**
+     * @brief Clears the state of every section.
+     */
+    void Reset() {
+        for (Stage& s : stages_) {
+            s.x1 = s.x2 = s.y1 = s.y2 = 0;
+        }
+    }
+
+private:
+    struct Stage {
+        std::array<q31_t, 3> b{};  // {b0, b1, b2}
+        std::array<q31_t, 2> a{};  // {-a1, -a2}
+        q31_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    };
+
+    std::array<Stage, Stages> stages_{};
+    unsigned shift_;
+};
+
+}  // namespace dsp
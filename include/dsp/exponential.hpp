@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "dsp/fixed_point.hpp"
+
+namespace dsp {
+
+/**
+ * @class Exponential
+ * @brief First-order IIR low-pass (exponential moving average).
+ * @tparam Sample q15_t or q31_t.
+ *
+ * y[n] = y[n-1] + alpha * (x[n] - y[n-1])
+ *
+ * The state is always Q31, so a Q15 input with a small alpha still settles on the
+ * exact input instead of stalling a few LSBs short (the usual integer EMA bug).
+ * alpha = 1 - exp(-2*pi*fc/fs) for a -3 dB corner at fc.
+ */
+template <typename Sample>
+class Exponential {
+    static_assert(std::is_same_v<Sample, q15_t> || std::is_same_v<Sample, q31_t>, "Exponential supports Q15 and Q31");
+
+public:
+    /**
+     * @brief Creates the filter.
+     * @param alpha Smoothing factor in (0, 1]; larger follows the input faster.
+     */
+    constexpr explicit Exponential(float alpha) : alpha_(FloatToQ31(alpha)) {}
+
+    /**
+     * @brief Filters one sample.
+     */
+    Sample Process(Sample x) {
+        const std::int64_t error = static_cast<std::int64_t>(ToQ31(x)) - state_;
+        state_ = simd::SaturateQ31(state_ + ((error * alpha_ + (std::int64_t{1} << 30)) >> 31));
+        return FromQ31(state_);
+    }
+
+    /**
+     * @brief Filters a block of samples.
+     * @param in  Input samples.
+     * @param out Output samples; may alias @p in.
+     * @param n   Number of samples.
+     */
+    void Process(const Sample* in, Sample* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Process(in[i]);
+        }
+    }
+
+    /**
+     * @brief Gets the latest output without adding a sample.
+     */
+    Sample Get() const { return FromQ31(state_); }
+
+    /**
+     * @brief Jumps the output to a value (e.g. the first sample, to skip the settling ramp).
+     */
+    void Reset(Sample value = 0) { state_ = ToQ31(value); }
+
+private:
+    q31_t alpha_;
+    q31_t state_ = 0;
+
+    static constexpr q31_t ToQ31(Sample x) {
+        if constexpr (std::is_same_v<Sample, q15_t>) {
+            return static_cast<q31_t>(static_cast<std::uint32_t>(x) << 16);
+        } else {
+            return x;
+        }
+    }
+
+    static Sample FromQ31(q31_t x) {
+        if constexpr (std::is_same_v<Sample, q15_t>) {
+            return simd::SaturateQ15(static_cast<std::int32_t>((static_cast<std::int64_t>(x) + (1 << 15)) >> 16));
+        } else {
+            return x;
+        }
+    }
+};
+
+}  // namespace dsp
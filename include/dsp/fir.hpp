@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "dsp/fixed_point.hpp"
+
+namespace dsp {
+
+/**
+ * @class FirQ15
+ * @brief Q15 FIR filter with a 64-bit accumulator.
+ * @tparam Taps Number of coefficients.
+ *
+ * y[n] = sum(h[k] * x[n - k]), k = 0 .. Taps - 1, rounded and saturated to Q15.
+ *
+ * The delay line is stored twice back to back, so the newest Taps samples are
+ * always contiguous and two taps are multiplied per SMLALD with no wrap checks.
+ * The 64-bit accumulator cannot overflow for any realistic tap count.
+ */
+template <std::size_t Taps>
+class FirQ15 {
+    static_assert(Taps > 0, "FIR needs at least one tap");
+
+public:
+    /**
+     * @brief Creates a filter with a zeroed delay line.
+     * @param coefficients h[0] .. h[Taps - 1] (h[0] weights the newest sample).
+     */
+    constexpr explicit FirQ15(const std::array<q15_t, Taps>& coefficients) {
+        // Reversed so they line up with the delay line, which runs oldest to newest
+        for (std::size_t k = 0; k < Taps; ++k) {
+            reversed_[k] = coefficients[Taps - 1 - k];
+        }
+    }
+
+    /**
+     * @brief Filters one sample.
+     */
+    q15_t Process(q15_t x) {
+        state_[pos_] = x;
+        state_[pos_ + Taps] = x;
+        pos_ = (pos_ + 1 == Taps) ? 0 : pos_ + 1;
+
+        // The window starts at the oldest sample, which is where the next one will be written
+        const q15_t* window = &state_[pos_];
+        std::int64_t acc = 0;
+        std::size_t k = 0;
+        for (; k + 1 < Taps; k += 2) {
+            acc = simd::Smlald(simd::Load2(&window[k]), simd::Load2(&reversed_[k]), acc);
+        }
+        if constexpr ((Taps % 2) != 0) {
+            acc += static_cast<std::int32_t>(window[k]) * reversed_[k];
+        }
+
+        return simd::SaturateQ15(simd::SaturateQ31((acc + (1 << 14)) >> 15));
+    }
+
+    /**
+     * @brief Filters a block of samples (e.g. one ADC DMA half-buffer after AdcToQ15()).
+     * @param in  Input samples.
+     * @param out Output samples; may alias @p in.
+     * @param n   Number of samples.
+     */
+    void Process(const q15_t* in, q15_t* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Process(in[i]);
+        }
+    }
+
+    /**
+     * @brief Clears the delay line.
+     */
+    void Reset() {
+        state_ = {};
+        pos_ = 0;
+    }
+
+private:
+    std::array<q15_t, Taps> reversed_{};
+    std::array<q15_t, 2 * Taps> state_{};
+    std::size_t pos_ = 0;
+};
+
+}  // namespace dsp
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dsp {
+
+/**
+ * @brief Signed 1.15 fixed point: [-1, 1 - 2^-15].
+ */
+using q15_t = std::int16_t;
+
+/**
+ * @brief Signed 1.31 fixed point: [-1, 1 - 2^-31].
+ */
+using q31_t = std::int32_t;
+
+/**
+ * @brief Converts a float in [-1, 1) to Q15, saturating out-of-range values.
+ */
+constexpr q15_t FloatToQ15(float value) {
+    const float scaled = value * 32768.0f;
+    if (scaled >= 32767.0f) return INT16_MAX;
+    if (scaled <= -32768.0f) return INT16_MIN;
+    return static_cast<q15_t>(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+/**
+ * @brief Converts a float in [-1, 1) to Q31, saturating out-of-range values.
+ */
+constexpr q31_t FloatToQ31(float value) {
+    const double scaled = static_cast<double>(value) * 2147483648.0;
+    if (scaled >= 2147483647.0) return INT32_MAX;
+    if (scaled <= -2147483648.0) return INT32_MIN;
+    return static_cast<q31_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+constexpr float Q15ToFloat(q15_t value) {
+    return static_cast<float>(value) / 32768.0f;
+}
+
+constexpr float Q31ToFloat(q31_t value) {
+    return static_cast<float>(static_cast<double>(value) / 2147483648.0);
+}
+
+// -----------------------------------------------------------------------------
+// Cortex-M4 DSP instructions
+// -----------------------------------------------------------------------------
+// On target these are the single-cycle SIMD/saturation instructions (via the
+// CMSIS core intrinsics); the host simulation gets bit-exact portable versions.
+namespace simd {
+
+/**
+ * @brief Loads two adjacent Q15 values as one packed word (unaligned access is fine on M4).
+ */
+[[gnu::always_inline]]
+inline std::uint32_t Load2(const q15_t* p) {
+    std::uint32_t packed;
+    std::memcpy(&packed, p, sizeof(packed));
+    return packed;
+}
+
+/**
+ * @brief Dual 16x16 multiply, 64-bit accumulate: acc + x.lo*y.lo + x.hi*y.hi (SMLALD).
+ */
+[[gnu::always_inline]]
+inline std::int64_t Smlald(std::uint32_t x, std::uint32_t y, std::int64_t acc) {
+#ifdef AWB_SIM_HAL
+    const auto lo = [](std::uint32_t v) { return static_cast<std::int32_t>(static_cast<std::int16_t>(v)); };
+    const auto hi = [](std::uint32_t v) { return static_cast<std::int32_t>(static_cast<std::int16_t>(v >> 16)); };
+    return acc + static_cast<std::int64_t>(lo(x)) * lo(y) + static_cast<std::int64_t>(hi(x)) * hi(y);
+#else
+    return static_cast<std::int64_t>(__SMLALD(x, y, static_cast<std::uint64_t>(acc)));
+#endif
+}
+
+/**
+ * @brief Dual 16x16 multiply, 32-bit accumulate: acc + x.lo*y.lo + x.hi*y.hi (SMLAD).
+ * @note Wraps on overflow; callers keep the sum within range.
+ */
+[[gnu::always_inline]]
+inline std::int32_t Smlad(std::uint32_t x, std::uint32_t y, std::int32_t acc) {
+#ifdef AWB_SIM_HAL
+    return static_cast<std::int32_t>(Smlald(x, y, acc));
+#else
+    return static_cast<std::int32_t>(__SMLAD(x, y, static_cast<std::uint32_t>(acc)));
+#endif
+}
+
+/**
+ * @brief Saturates to the Q15 range (SSAT #16).
+ */
+[[gnu::always_inline]]
+inline q15_t SaturateQ15(std::int32_t value) {
+#ifdef AWB_SIM_HAL
+    return static_cast<q15_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+#else
+    return static_cast<q15_t>(__SSAT(value, 16));
+#endif
+}
+
+/**
+ * @brief Saturates a 64-bit accumulator to the Q31 range.
+ */
+[[gnu::always_inline]]
+inline q31_t SaturateQ31(std::int64_t value) {
+    return static_cast<q31_t>(value > INT32_MAX ? INT32_MAX : (value < INT32_MIN ? INT32_MIN : value));
+}
+
+/**
+ * @brief Packs two Q15 values into one word, lo in bits 0-15 (PKHBT).
+ */
+[[gnu::always_inline]]
+inline std::uint32_t Pack(q15_t lo, q15_t hi) {
+    return static_cast<std::uint16_t>(lo) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(hi)) << 16);
+}
+
+}  // namespace simd
+
+/**
+ * @brief Converts unsigned right-aligned ADC results to signed Q15 around mid-scale.
+ * @param in   ADC samples (e.g. a DMA half-buffer).
+ * @param out  Q15 samples; may alias @p in.
+ * @param n    Number of samples.
+ * @param bits ADC resolution (12 for the L476 default); samples must not exceed it.
+ *
+ * Mid-scale maps to 0 and full-scale to just under 1.0. Two samples are converted
+ * per 32-bit word: shifting left by (16 - bits) and flipping bit 15 of each half
+ * is the same as subtracting 0x8000 from each, with no carry between halves.
+ */
+inline void AdcToQ15(const std::uint16_t* in, q15_t* out, std::size_t n, unsigned bits = 12) {
+    const unsigned shift = 16U - bits;
+    std::size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        std::uint32_t pair;
+        std::memcpy(&pair, &in[i], sizeof(pair));
+        pair = (pair << shift) ^ 0x8000'8000U;
+        std::memcpy(&out[i], &pair, sizeof(pair));
+    }
+    if (i < n) {
+        out[i] = static_cast<q15_t>(static_cast<std::uint16_t>(in[i] << shift) ^ 0x8000U);
+    }
+}
+
+/**
+ * @brief Inverse of AdcToQ15() for one sample (e.g. to plot a filtered value in ADC counts).
+ */
+constexpr std::uint16_t Q15ToAdc(q15_t value, unsigned bits = 12) {
+    return static_cast<std::uint16_t>((static_cast<std::uint16_t>(value) ^ 0x8000U) >> (16U - bits));
+}
+
+}  // namespace dsp
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+
+/**
+ * @class MovingMedian
+ * @brief Running median over the last Window samples.
+ * @tparam T      Sample type (raw ADC counts, q15_t, ...).
+ * @tparam Window Window length; odd so the median is a sample.
+ *
+ * Rejects isolated spikes (e.g. commutation noise on motor current) that a mean
+ * would smear into the output. Keeps the window both in arrival order and sorted;
+ * each new sample replaces the oldest one in the sorted copy with a single
+ * insertion-sort pass, so a sample costs O(Window) compares and no allocation.
+ * Until the window has filled, the median of the samples seen so far is returned.
+ */
+template <typename T, std::size_t Window>
+class MovingMedian {
+    static_assert(Window % 2 == 1, "Median window must be odd");
+
+public:
+    /**
+     * @brief Adds one sample.
+     * @return Median of the current window.
+     */
+    T Process(T x) {
+        std::size_t i;
+        if (count_ < Window) {
+            i = count_++;
+        } else {
+            // Find the slot of the sample that falls out of the window
+            const T oldest = history_[head_];
+            i = 0;
+            while (sorted_[i] != oldest) {
+                ++i;
+            }
+        }
+        history_[head_] = x;
+        head_ = (head_ + 1 == Window) ? 0 : head_ + 1;
+
+        // Move the freed slot to where x belongs
+        while (i > 0 && sorted_[i - 1] > x) {
+            sorted_[i] = sorted_[i - 1];
+            --i;
+        }
+        while (i + 1 < count_ && sorted_[i + 1] < x) {
+            sorted_[i] = sorted_[i + 1];
+            ++i;
+        }
+        sorted_[i] = x;
+
+        return sorted_[count_ / 2];
+    }
+
+    /**
+     * @brief Filters a block of samples.
+     * @param in  Input samples.
+     * @param out Output samples; may alias @p in.
+     * @param n   Number of samples.
+     */
+    void Process(const T* in, T* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Process(in[i]);
+        }
+    }
+
+    /**
+     * @brief Empties the window.
+     */
+    void Reset() {
+        count_ = 0;
+        head_ = 0;
+    }
+
+private:
+    std::array<T, Window> history_{};  // Arrival order; head_ is the oldest once full
+    std::array<T, Window> sorted_{};   // First count_ entries in ascending order
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+};
+
+}  // namespace dsp
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "dsp/fixed_point.hpp"
+
+namespace dsp {
+
+/**
+ * @brief Continuous-time PID gains, converted to per-sample coefficients by Pid.
+ */
+struct PidGains {
+    float kp;                 ///< Output per unit of error
+    float ki = 0;             ///< Output per unit of error, per second
+    float kd = 0;             ///< Output per unit/s of measurement rate
+    float derivative_hz = 0;  ///< Derivative low-pass corner; 0 leaves the derivative unfiltered
+};
+
+/**
+ * @class Pid
+ * @brief Discrete PID controller with feed-forward, clamping anti-windup and a filtered derivative.
+ * @tparam Sample float (single precision, on the FPU) or q31_t (integer only).
+ *
+ * u[n] = ff[n] + kp*e[n] + I[n] + D[n], clamped to [output_min, output_max], where
+ *   e[n] = setpoint - measurement
+ *   I[n] = I[n-1] + ki*Ts*e[n], held while the output is clamped and e[n] would drive it
+ *          further out, and never outside the output range
+ *   D[n] = D[n-1] + alpha*(kd*(m[n-1] - m[n])/Ts - D[n-1]), a first-order low-pass at derivative_hz
+ *
+ * The derivative acts on the measurement, so setpoint steps do not kick the output;
+ * the feed-forward (e.g. velocity and acceleration from a MotionProfile, scaled to
+ * output units) carries the planned part of the response instead.
+ *
+ * Update() has no loops and no divisions, so it costs the same every call. The q31_t
+ * version takes int32 signals in any scaling (the gains are ratios of output to input
+ * units): each coefficient is a 32-bit mantissa with its own shift, and products and
+ * the integral are 64-bit, so a small ki*Ts still integrates a one-LSB error.
+ */
+template <typename Sample>
+class Pid {
+    static_assert(std::is_same_v<Sample, float> || std::is_same_v<Sample, q31_t>, "Pid supports float and Q31");
+
+    static constexpr bool kFloat = std::is_same_v<Sample, float>;
+
+public:
+    /**
+     * @brief Creates the controller at rest (zero integral, derivative and output).
+     * @param gains      Continuous-time gains.
+     * @param sample_hz  Rate Update() is called at.
+     * @param output_min Lowest output (e.g., full reverse duty).
+     * @param output_max Highest output.
+     */
+    constexpr Pid(const PidGains& gains, float sample_hz, Sample output_min, Sample output_max)
+        : kp_(ToCoefficient(gains.kp)),
+          ki_(ToCoefficient(gains.ki / sample_hz, kMaxIntegralShift)),
+          kd_(ToCoefficient(gains.kd * sample_hz)),
+          alpha_(ToAlpha(gains.derivative_hz, sample_hz)),
+          min_(output_min),
+          max_(output_max) {}
+
+    /**
+     * @brief Runs one control step.
+     * @param setpoint     Where the measurement should be.
+     * @param measurement  Where it is.
+     * @param feed_forward Added to the output ahead of the feedback terms.
+     * @return The clamped output.
+     */
+    constexpr Sample Update(Sample setpoint, Sample measurement, Sample feed_forward = 0) {
+        if constexpr (kFloat) {
+            const float error = setpoint - measurement;
+            derivative_ += alpha_ * (kd_ * (previous_ - measurement) - derivative_);
+            previous_ = measurement;
+
+            const float base = feed_forward + kp_ * error + derivative_;
+            const float integral = integral_ + ki_ * error;
+            if (!Winding(base + integral, error)) {
+                integral_ = Clamp(integral, min_, max_);
+            }
+            output_ = Clamp(base + integral_, min_, max_);
+        } else {
+            const std::int64_t error = Saturate(static_cast<std::int64_t>(setpoint) - measurement);
+            const std::int64_t change = Saturate(static_cast<std::int64_t>(previous_) - measurement);
+            derivative_ += (alpha_ * (Saturate(kd_.Multiply(change)) - derivative_) + (std::int64_t{1} << 30)) >> 31;
+            previous_ = measurement;
+
+            // The integral keeps every ki*e product whole, scaled up by ki's shift
+            const std::int64_t base = feed_forward + kp_.Multiply(error) + derivative_;
+            const std::int64_t integral = integral_ + ki_.value * error;
+            if (!Winding(base + ki_.Unscale(integral), error)) {
+                integral_ = Clamp(integral, ki_.Scale(min_), ki_.Scale(max_));
+            }
+            output_ = static_cast<Sample>(Clamp(base + ki_.Unscale(integral_), min_, max_));
+        }
+        return output_;
+    }
+
+    /**
+     * @brief Gets the output of the last Update().
+     */
+    constexpr Sample GetOutput() const { return output_; }
+
+    /**
+     * @brief Restarts from a known state without a bump (e.g., when closing the loop on a moving axis).
+     * @param measurement Current measurement, so the first derivative is zero.
+     * @param output      Output to continue from: it becomes the integral.
+     */
+    constexpr void Reset(Sample measurement, Sample output = 0) {
+        previous_ = measurement;
+        derivative_ = 0;
+        output_ = Clamp(output, min_, max_);
+        if constexpr (kFloat) {
+            integral_ = output_;
+        } else {
+            integral_ = ki_.Scale(output_);
+        }
+    }
+
+private:
+    // Q31 coefficient: value * 2^-shift, the shift chosen so value uses all 31 bits
+    struct Coefficient {
+        std::int64_t value;
+        unsigned shift;
+
+        constexpr std::int64_t Multiply(std::int64_t x) const {
+            return (shift == 0) ? value * x : (value * x + (std::int64_t{1} << (shift - 1))) >> shift;
+        }
+        constexpr std::int64_t Scale(std::int64_t x) const { return x << shift; }
+        constexpr std::int64_t Unscale(std::int64_t x) const {
+            return (shift == 0) ? x : (x + (std::int64_t{1} << (shift - 1))) >> shift;
+        }
+    };
+
+    using Gain = std::conditional_t<kFloat, float, Coefficient>;
+    using Accumulator = std::conditional_t<kFloat, float, std::int64_t>;
+
+    // The integral holds sum(e) at ki's scale: capping that shift keeps it, and the output range, in 64 bits
+    static constexpr unsigned kMaxIntegralShift = 31;
+
+    static constexpr Gain ToCoefficient(float gain, unsigned max_shift = 62) {
+        if constexpr (kFloat) {
+            return gain;
+        } else {
+            // Largest shift that keeps |gain| * 2^shift inside 31 bits
+            double scaled = gain;
+            unsigned shift = 0;
+            while (shift < max_shift && (scaled < 0 ? -scaled : scaled) * 2 < 2147483647.0) {
+                scaled *= 2;
+                ++shift;
+            }
+            if (scaled >= 2147483647.0) {
+                scaled = 2147483647.0;
+            } else if (scaled <= -2147483647.0) {
+                scaled = -2147483647.0;
+            }
+            return {static_cast<std::int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5), shift};
+        }
+    }
+
+    // Backward-Euler first-order low-pass: alpha = w / (1 + w), w = 2*pi*fc/fs
+    static constexpr Accumulator ToAlpha(float corner_hz, float sample_hz) {
+        const float w = 6.2831853f * corner_hz / sample_hz;
+        const float alpha = (corner_hz > 0) ? w / (1 + w) : 1.0f;
+        if constexpr (kFloat) {
+            return alpha;
+        } else {
+            return (alpha >= 1.0f) ? INT32_MAX : FloatToQ31(alpha);
+        }
+    }
+
+    static constexpr std::int64_t Saturate(std::int64_t x) {
+        return (x > INT32_MAX) ? INT32_MAX : (x < INT32_MIN) ? INT32_MIN : x;
+    }
+
+    template <typename T, typename Limit>
+    static constexpr T Clamp(T x, Limit low, Limit high) {
+        return (x > high) ? T(high) : (x < low) ? T(low) : x;
+    }
+
+    // The output would be clamped and the error pushes it further out
+    constexpr bool Winding(Accumulator unclamped, Accumulator error) const {
+        return (unclamped > max_ && error > 0) || (unclamped < min_ && error < 0);
+    }
+
+    Gain kp_;
+    Gain ki_;
+    Gain kd_;
+    Accumulator alpha_;
+    Sample min_;
+    Sample max_;
+
+    Accumulator integral_ = 0;  // Q31: ki_.value * sum(e), i.e. the integral << ki_.shift
+    Accumulator derivative_ = 0;
+    Sample previous_ = 0;
+    Sample output_ = 0;
+};
+
+}  // namespace dsp
@@ -2,12 +2,130 @@
 
 #include <stm32l4xx_hal.h>
 
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <expected>
+#include <limits>
+#include <type_traits>
 
+#include "hal/adc_calibration.hpp"
 #include "util/error_codes.hpp"
 
 namespace hal {
 
+/**
+ * @brief Most regular channels hal::Adc tracks in one scan sequence.
+ * @note The L4 sequencer allows 16 ranks; 8 bounds the per-channel streaming state in RAM.
+ */
+inline constexpr std::size_t kMaxAdcChannels = 8;
+
+/**
+ * @brief Width of a hardware-oversampled result.
+ * @param resolution_bits ADC resolution (6, 8, 10 or 12).
+ * @param ratio           Conversions summed per result (power of two, 1..256).
+ * @param right_shift     Bits the sum is shifted right by (0..8).
+ * @return Significant bits in the result, capped at 16 (the data register width).
+ */
+constexpr unsigned AdcOversampledBits(unsigned resolution_bits, std::uint32_t ratio, std::uint32_t right_shift) {
+    const unsigned sum_bits = resolution_bits + static_cast<unsigned>(std::bit_width(ratio)) - 1U;
+    const unsigned bits = (right_shift >= sum_bits) ? 0U : sum_bits - right_shift;
+    return bits > 16U ? 16U : bits;
+}
+
+/**
+ * @brief Compile-time list of regular channels, in conversion (rank) order.
+ * @tparam Channels HAL channel constants (e.g., ADC_CHANNEL_5, ADC_CHANNEL_TEMPSENSOR).
+ *
+ * In scan mode the DMA buffer is interleaved: element i belongs to channel
+ * i % kSize. IndexOf<>() turns a channel constant into its position at compile time.
+ */
+template <std::uint32_t... Channels>
+struct AdcSequence {
+    static constexpr std::size_t kSize = sizeof...(Channels);
+    static constexpr std::array<std::uint32_t, kSize> kChannels{Channels...};
+
+    static_assert(kSize > 0 && kSize <= kMaxAdcChannels, "Sequence must have 1..kMaxAdcChannels channels");
+    static_assert(
+        [] {
+            for (std::size_t i = 0; i < kSize; ++i) {
+                for (std::size_t j = i + 1; j < kSize; ++j) {
+                    if (kChannels[i] == kChannels[j]) return false;
+                }
+            }
+            return true;
+        }(),
+        "A channel appears twice in the sequence");
+
+    /**
+     * @brief Position of a channel in the sequence (its index into per-channel APIs).
+     */
+    template <std::uint32_t Channel>
+    static consteval std::size_t IndexOf() {
+        std::size_t index = 0;
+        while (index < kSize && kChannels[index] != Channel) {
+            ++index;
+        }
+        if (index == kSize) {
+            throw "Channel is not part of the sequence";  // Not a constant expression: fails the build
+        }
+        return index;
+    }
+};
+
+/**
+ * @brief Strided, non-owning view of one channel inside an interleaved DMA buffer.
+ * @tparam SampleType The data width of the ADC conversion.
+ *
+ * Reads go straight to the DMA buffer (volatile), so no samples are copied; the
+ * values are as fresh as the DMA has made them.
+ */
+template <typename SampleType>
+class AdcChannelView {
+public:
+    /**
+     * @param first  The channel's first sample.
+     * @param stride Distance between consecutive samples of the channel (the sequence length).
+     * @param size   Number of samples of the channel in the view.
+     */
+    constexpr AdcChannelView(const volatile SampleType* first, std::size_t stride, std::size_t size)
+        : first_(first), stride_(stride), size_(size) {}
+
+    SampleType operator[](std::size_t i) const { return first_[i * stride_]; }
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Mean of the samples in the view (0 if empty).
+     */
+    SampleType Average() const {
+        if (size_ == 0) {
+            return 0;
+        }
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < size_; ++i) {
+            sum += first_[i * stride_];
+        }
+        return static_cast<SampleType>(sum / size_);
+    }
+
+private:
+    const volatile SampleType* first_;
+    std::size_t stride_;
+    std::size_t size_;
+};
+
+/**
+ * @brief Statistics over one decimated block of streamed ADC samples.
+ * @tparam SampleType The data width of the ADC conversion.
+ */
+template <typename SampleType>
+struct AdcSnapshot {
+    SampleType average;      ///< Mean of every sample in the block
+    SampleType min;          ///< Smallest sample in the block
+    SampleType max;          ///< Largest sample in the block
+    std::uint32_t sequence;  ///< Increments on every publish; compare to detect fresh data
+};
+
 /**
  * @brief ADC Driver with DMA support.
  * @tparam SampleType The data width of the ADC conversion.
@@ -19,6 +137,9 @@ namespace hal {
  */
 template <typename SampleType = uint16_t>
 class Adc {
+    static_assert(std::is_unsigned_v<SampleType> && sizeof(SampleType) <= 4,
+                  "SampleType must be uint8_t, uint16_t or uint32_t (the DMA element width)");
+
 public:
     /**
      * @brief Lightweight wrapper around a HAL ADC handle.
@@ -38,6 +159,157 @@ public:
      */
     bool Start(SampleType* buffer, std::size_t length);
 
+    /**
+     * @brief Sets the regular conversion sequence (scan mode when more than one channel).
+     * @tparam Sequence An AdcSequence.
+     * @param sampling_time HAL sampling time for every channel (e.g., ADC_SAMPLETIME_92CYCLES_5).
+     * @return true if configured successfully.
+     * @note Call while conversions are stopped. Scan mode needs DMA; length passed to
+     *       Start()/StartStreaming() must be a multiple of the sequence length.
+     */
+    template <typename Sequence>
+    bool ConfigureSequence(std::uint32_t sampling_time) {
+        return ConfigureSequence(Sequence::kChannels.data(), Sequence::kSize, sampling_time);
+    }
+
+    /**
+     * @brief Runtime form of ConfigureSequence<>().
+     * @param channels HAL channel constants in rank order.
+     * @param count    Number of channels (1..kMaxAdcChannels).
+     * @param sampling_time HAL sampling time for every channel.
+     * @return true if configured successfully.
+     */
+    bool ConfigureSequence(const std::uint32_t* channels, std::size_t count, std::uint32_t sampling_time);
+
+    /**
+     * @brief Enables the hardware oversampler on regular conversions.
+     * @tparam Ratio      Conversions accumulated per result (power of two, 2..256).
+     * @tparam RightShift Bits the accumulated sum is shifted right by (0..8).
+     * @return true if configured successfully.
+     *
+     * The ADC sums Ratio conversions in silicon and delivers one result, so DMA
+     * transfers and block-processing work drop by Ratio at the same input rate.
+     * RightShift = log2(Ratio) gives an averaged result at the native resolution;
+     * a smaller shift keeps extra bits (e.g. 16x, shift 0 gives 16-bit results from
+     * the 12-bit ADC). The result must fit SampleType, checked here at compile time
+     * against the 12-bit worst case.
+     * @note Call while conversions are stopped. The setting survives Stop() and restarts.
+     */
+    template <std::uint32_t Ratio, std::uint32_t RightShift>
+    bool ConfigureOversampling() {
+        static_assert(std::has_single_bit(Ratio) && Ratio >= 2 && Ratio <= 256,
+                      "Oversampling ratio must be a power of two in 2..256");
+        static_assert(RightShift <= 8, "Oversampling right shift must be 0..8");
+        static_assert(AdcOversampledBits(12, Ratio, RightShift) <= std::numeric_limits<SampleType>::digits,
+                      "Oversampled result does not fit SampleType; raise RightShift or widen SampleType");
+        return ConfigureOversampling(Ratio, RightShift);
+    }
+
+    /**
+     * @brief Runtime form of ConfigureOversampling<>().
+     * @param ratio       Power of two in 2..256, or 1 to disable the oversampler.
+     * @param right_shift 0..8.
+     * @return true if configured successfully; false if the result would not fit SampleType.
+     */
+    bool ConfigureOversampling(std::uint32_t ratio, std::uint32_t right_shift);
+
+    /**
+     * @brief Selects what starts regular conversions.
+     * @param trigger HAL trigger source (e.g., ADC_EXTERNALTRIG_T1_TRGO2), or
+     *                ADC_SOFTWARE_START for free-running continuous conversions.
+     * @param edge    Trigger edge (ignored for ADC_SOFTWARE_START).
+     * @return true if configured successfully.
+     *
+     * With an external trigger, continuous mode is turned off. Without oversampling
+     * each trigger converts the whole sequence back to back; with oversampling each
+     * accumulated conversion waits for its own trigger, so every sample lands at the
+     * same point of the trigger period (see hal::PwmSync).
+     * @note Call while conversions are stopped. The setting survives Stop() and restarts.
+     */
+    bool ConfigureTrigger(std::uint32_t trigger, std::uint32_t edge = ADC_EXTERNALTRIGCONVEDGE_RISING);
+
+    /**
+     * @brief Gets the significant bits in each result (resolution, adjusted for oversampling).
+     * @note Pass this to dsp::AdcToQ15() so oversampled results scale correctly.
+     */
+    unsigned GetResultBits() const;
+
+    /**
+     * @brief Installs a correction table applied to regular results.
+     * @param calibration Table for the current result width (must outlive its use), or nullptr to read raw.
+     * @return true if installed; false if the table was built for a different GetResultBits().
+     *
+     * Read(), ReadAverage() and the streaming snapshots return corrected values.
+     * Block handlers (SetBlockHandler()), injected reads, channel views and the
+     * analog watchdog see raw results; Correct() converts those where needed.
+     */
+    bool SetCalibration(const AdcCalibration* calibration);
+
+    /**
+     * @brief Applies the installed correction table to a raw result (pass-through without one).
+     */
+    SampleType Correct(SampleType raw) const {
+        return (calibration_ != nullptr) ? static_cast<SampleType>(calibration_->Apply(raw)) : raw;
+    }
+
+    /**
+     * @brief Gets the number of channels in the regular sequence (1 unless ConfigureSequence() was used).
+     */
+    std::size_t GetChannelCount() const { return channel_count_; }
+
+    /**
+     * @brief Gets a strided view of one channel across the whole DMA buffer.
+     * @param channel Index into the sequence (see AdcSequence::IndexOf()).
+     * @return View, or awb::Error::InvalidParam if not started in DMA mode or the index is out of range.
+     */
+    std::expected<AdcChannelView<SampleType>, awb::Error> GetChannelView(std::size_t channel) const;
+
+    /**
+     * @brief Configures the single injected channel used by ReadInjected().
+     * @param channel       HAL channel constant (e.g., ADC_CHANNEL_VREFINT).
+     * @param sampling_time HAL sampling time.
+     * @return true if configured successfully.
+     * @note Call while conversions are stopped.
+     */
+    bool ConfigureInjected(std::uint32_t channel, std::uint32_t sampling_time);
+
+    /**
+     * @brief Converts the injected channel once and returns the result.
+     * @return Value, awb::Error::Timeout, or awb::Error::InvalidParam if not configured.
+     *
+     * An injected conversion pre-empts the regular sequence, which resumes
+     * afterwards, so this is safe while streaming and gets a fresh sample without
+     * waiting for the scan to come around.
+     */
+    std::expected<SampleType, awb::Error> ReadInjected();
+
+    /**
+     * @brief Starts the ADC in streaming mode (DMA only).
+     * @param buffer     Pointer to the circular DMA buffer.
+     * @param length     Number of 'SampleType' items; must be even (two halves), and each
+     *                   half a multiple of GetChannelCount().
+     * @param decimation Number of completed half-buffers folded into each snapshot.
+     * @return true if started successfully.
+     *
+     * Each DMA half/full-transfer interrupt processes exactly the half-buffer that
+     * was just completed (sum, min, max). Every @p decimation halves, the result is
+     * published to a double-buffered snapshot readable in O(1) via ReadSnapshot().
+     */
+    bool StartStreaming(SampleType* buffer, std::size_t length, std::uint32_t decimation = 1);
+
+    /**
+     * @brief Installs a hook that receives every completed half-buffer while streaming.
+     * @param on_block Called from the DMA interrupt with the half that was just filled
+     *                 (stable until the next half completes); nullptr removes the hook.
+     * @param context  Passed back to on_block.
+     * @note In scan mode the block is interleaved (sample i belongs to sequence index
+     *       i % GetChannelCount()) and always starts at the first rank.
+     * @note Runs once per half-buffer in interrupt context; keep the work bounded
+     *       (e.g. a dsp:: filter over the block).
+     */
+    void SetBlockHandler(void (*on_block)(void* context, const SampleType* block, std::size_t length),
+                         void* context);
+
     /**
      * @brief Stops ADC conversions and DMA (if enabled).
      */
@@ -51,10 +323,50 @@ public:
     std::expected<SampleType, awb::Error> Read(std::size_t index = 0);
 
     /**
-     * @brief Calculates the average of the entire DMA buffer.
+     * @brief Calculates the average of one channel over the entire DMA buffer.
+     * @param channel Index into the sequence (0 for single-channel use).
      * @return Average value, or std::nullopt if not running.
+     * @note In streaming mode this returns the latest snapshot average in O(1).
+     */
+    std::expected<SampleType, awb::Error> ReadAverage(std::size_t channel = 0);
+
+    /**
+     * @brief Returns the most recently published streaming snapshot of one channel.
+     * @param channel Index into the sequence (0 for single-channel use).
+     * @return Snapshot, or awb::Error::Busy if no block has completed yet,
+     *         or awb::Error::InvalidParam if not streaming or the index is out of range.
+     * @note Tear-free: safe to call while the DMA interrupt publishes new data.
      */
-    std::expected<SampleType, awb::Error> ReadAverage();
+    std::expected<AdcSnapshot<SampleType>, awb::Error> ReadSnapshot(std::size_t channel = 0) const;
+
+    /**
+     * @brief Arms analog watchdog 1 on one regular channel.
+     * @param channel HAL channel (e.g., ADC_CHANNEL_5); must be part of the regular sequence.
+     * @param low     Lowest in-window value.
+     * @param high    Highest in-window value.
+     * @param on_trip Called from the ADC interrupt with the offending conversion result.
+     * @param context Passed back to on_trip.
+     * @return true if configured successfully.
+     *
+     * The comparison is done by the ADC itself on every conversion, so the interrupt
+     * fires at the end of the first out-of-window conversion with no CPU polling.
+     * The interrupt is one-shot: it is disabled after on_trip returns so a signal that
+     * stays out of window cannot storm the CPU. Call RearmWatchdog() once handled.
+     * @note Call while conversions are stopped (before Start()/StartStreaming()).
+     *       The setting survives Stop() and restarts.
+     */
+    bool ArmWatchdog(std::uint32_t channel, SampleType low, SampleType high,
+                     void (*on_trip)(void* context, std::uint32_t value), void* context);
+
+    /**
+     * @brief Re-enables the watchdog interrupt after a trip.
+     */
+    void RearmWatchdog();
+
+    /**
+     * @brief Disables the watchdog interrupt and forgets the trip handler.
+     */
+    void DisarmWatchdog();
 
     uint32_t GetMaxTimeoutMs() const { return MAX_TIMEOUT_MS_; }
     void SetMaxTimeoutMs(std::size_t timeout_ms) { MAX_TIMEOUT_MS_ = timeout_ms; }
@@ -65,7 +377,30 @@ private:
     std::size_t length_ = 0;        // length of the buffer
     std::size_t MAX_TIMEOUT_MS_ = 10;
 
+    std::size_t channel_count_ = 1;  // Regular sequence length; the DMA buffer interleaves channels
+    bool injected_configured_ = false;
+    const AdcCalibration* calibration_ = nullptr;
+
+    // Streaming state, per channel. The accumulators are only touched from the DMA interrupt.
+    struct ChannelAccumulator {
+        std::uint64_t sum;
+        SampleType min;
+        SampleType max;
+    };
+    bool streaming_ = false;
+    std::uint32_t decimation_ = 1;
+    std::uint32_t acc_blocks_ = 0;
+    std::array<ChannelAccumulator, kMaxAdcChannels> acc_{};
+    AdcSnapshot<SampleType> snapshots_[2][kMaxAdcChannels]{};
+    volatile std::uint32_t publish_count_ = 0;  // snapshots_[publish_count_ & 1] is the latest
+    void (*block_handler_)(void* context, const SampleType* block, std::size_t length) = nullptr;
+    void* block_context_ = nullptr;
+
     bool IsDmaMode() const { return handle_.DMA_Handle != nullptr; }
+    bool SampleTypeFits() const;
+    void ResetAccumulator();
+    void ProcessBlock(bool upper_half);
+    static void OnBlockComplete(void* self, bool upper_half);
 };
 
 }  // namespace hal
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "util/error_codes.hpp"
+
+namespace hal {
+
+template <typename SampleType>
+class Adc;
+class Dac;
+class FlashPage;
+
+/**
+ * @brief Piecewise-linear correction from raw ADC results to true codes.
+ *
+ * The result range is cut into kSegments equal segments; points[k] holds the
+ * corrected value of raw code k * 2^bits / kSegments. Gain, offset and the
+ * converter's bow (INL) all fold into one table, so correcting a sample is a
+ * shift, a lookup and one multiply. Built by RunLoopbackCalibration() and kept in
+ * flash with SaveAdcCalibration()/LoadAdcCalibration().
+ */
+struct AdcCalibration {
+    static constexpr std::uint32_t kMagic = 0x4C41'4341;  // "ACAL"
+    static constexpr std::uint16_t kVersion = 1;
+    static constexpr unsigned kSegmentBits = 4;
+    static constexpr std::size_t kSegments = 1U << kSegmentBits;
+
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint8_t bits;  ///< Result width the table is for (Adc::GetResultBits())
+    std::uint8_t reserved;
+    float gain;     ///< Straight-line fit: true = gain * raw + offset
+    float offset;   ///< In codes
+    float max_inl;  ///< Largest distance of a sweep point from the fit, in codes
+    std::int32_t points[kSegments + 1];  ///< May run past 0..2^bits - 1 to keep the end segments' slope
+    std::uint32_t crc;  ///< CRC-32 of everything above (see SaveAdcCalibration())
+
+    /**
+     * @brief Corrects one raw result.
+     * @param raw Result of the width the table was built for.
+     * @return Corrected result, clamped to 0..2^bits - 1.
+     */
+    constexpr std::uint32_t Apply(std::uint32_t raw) const {
+        const unsigned shift = bits - kSegmentBits;
+        const std::uint32_t index = std::min<std::uint32_t>(raw >> shift, kSegments - 1);
+        const std::int32_t base = points[index];
+        const std::int32_t step = points[index + 1] - base;
+        const auto fraction = static_cast<std::int32_t>(raw - (index << shift));
+        const std::int32_t value = base + ((step * fraction + (1 << (shift - 1))) >> shift);
+        return static_cast<std::uint32_t>(std::clamp<std::int32_t>(value, 0, (1 << bits) - 1));
+    }
+};
+
+/**
+ * @brief One step of a loopback sweep.
+ */
+struct LoopbackPoint {
+    std::uint32_t expected;  ///< Ideal result for the DAC code driven
+    std::uint32_t measured;  ///< Averaged ADC result
+};
+
+/**
+ * @brief Fits a correction table to loopback measurements.
+ * @param points Sweep steps; usable ones (off the rails) must rise with the DAC code.
+ * @param count  Number of steps.
+ * @param bits   ADC result width (5..16).
+ * @return Table with the CRC left at zero; awb::Error::InvalidParam for bad arguments,
+ *         awb::Error::NotCalibrated if the points do not look like a working loopback
+ *         (fewer than four usable, not monotonic, or a gain far from one).
+ *
+ * Steps whose reading is pinned near either rail are dropped. Breakpoints inside the
+ * measured span follow the measurements (so the table takes out INL as well as
+ * gain and offset); breakpoints outside it continue from the nearest measurement
+ * with the fitted gain.
+ */
+constexpr std::expected<AdcCalibration, awb::Error> ComputeAdcCalibration(const LoopbackPoint* points,
+                                                                         std::size_t count, unsigned bits) {
+    if (points == nullptr || bits <= AdcCalibration::kSegmentBits || bits > 16) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    // Readings at the rails say nothing about gain: the DAC buffer and the ADC both clip there
+    const std::uint32_t max_code = (1U << bits) - 1U;
+    const std::uint32_t margin = max_code / 64;
+    const auto usable = [&](const LoopbackPoint& p) {
+        return p.measured > margin && p.measured < max_code - margin;
+    };
+
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    const LoopbackPoint* previous = nullptr;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!usable(points[i])) {
+            continue;
+        }
+        // A real loopback reads higher for every higher code; anything else is an open or noisy input
+        if (previous != nullptr && points[i].measured <= previous->measured) {
+            return std::unexpected(awb::Error::NotCalibrated);
+        }
+        previous = &points[i];
+        const double x = points[i].measured;
+        const double y = points[i].expected;
+        n += 1;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    const double denominator = n * sxx - sx * sx;
+    if (n < 4 || denominator <= 0) {
+        return std::unexpected(awb::Error::NotCalibrated);
+    }
+    const double gain = (n * sxy - sx * sy) / denominator;
+    const double offset = (sy - gain * sx) / n;
+    if (gain < 0.8 || gain > 1.25) {
+        return std::unexpected(awb::Error::NotCalibrated);
+    }
+
+    AdcCalibration calibration{};
+    calibration.magic = AdcCalibration::kMagic;
+    calibration.version = AdcCalibration::kVersion;
+    calibration.bits = static_cast<std::uint8_t>(bits);
+    calibration.gain = static_cast<float>(gain);
+    calibration.offset = static_cast<float>(offset);
+
+    double max_inl = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (usable(points[i])) {
+            const double residual = points[i].expected - (gain * points[i].measured + offset);
+            max_inl = std::max(max_inl, residual < 0 ? -residual : residual);
+        }
+    }
+    calibration.max_inl = static_cast<float>(max_inl);
+
+    const unsigned shift = bits - AdcCalibration::kSegmentBits;
+    for (std::size_t k = 0; k <= AdcCalibration::kSegments; ++k) {
+        const std::uint32_t raw = static_cast<std::uint32_t>(k) << shift;
+        const LoopbackPoint* below = nullptr;
+        const LoopbackPoint* above = nullptr;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!usable(points[i])) {
+                continue;
+            }
+            if (points[i].measured <= raw) {
+                below = &points[i];
+            } else if (above == nullptr) {
+                above = &points[i];
+            }
+        }
+
+        double value = 0;
+        if (below != nullptr && above != nullptr) {
+            const double t = static_cast<double>(raw - below->measured) / (above->measured - below->measured);
+            value = below->expected + t * (static_cast<double>(above->expected) - below->expected);
+        } else {
+            const LoopbackPoint& edge = (below != nullptr) ? *below : *above;
+            value = edge.expected + gain * (static_cast<double>(raw) - edge.measured);
+        }
+        calibration.points[k] = static_cast<std::int32_t>(value < 0 ? value - 0.5 : value + 0.5);
+    }
+    return calibration;
+}
+
+/**
+ * @brief Settings for RunLoopbackCalibration().
+ */
+struct LoopbackSweep {
+    std::size_t channel = 0;         ///< Sequence index of the ADC input wired to the DAC output
+    std::uint16_t first_code = 0;    ///< DAC code of the first step
+    std::uint16_t last_code = 4095;  ///< DAC code of the last step
+    std::size_t steps = 33;          ///< 2..kMaxLoopbackSteps; spaced evenly from first to last
+    std::uint32_t settle_ms = 20;    ///< Wait after each DAC step before results count
+    std::uint32_t snapshots = 2;     ///< Streaming snapshots averaged per step
+    std::uint32_t timeout_ms = 500;  ///< Longest wait for the snapshots of one step
+};
+
+/**
+ * @brief Most steps one loopback sweep can take.
+ */
+inline constexpr std::size_t kMaxLoopbackSteps = 65;
+
+/**
+ * @brief Sweeps the DAC through a loopback into the ADC and fits a correction table.
+ * @param dac   DAC whose output is wired to the ADC input; its trigger timer must be
+ *              running at a rate set with Dac::SetSampleRate().
+ * @param adc   ADC streaming (StartStreaming()) with the loopback input in its sequence.
+ * @param sweep Sweep settings.
+ * @return Table for adc.GetResultBits(); awb::Error::Timeout if the ADC stopped publishing
+ *         snapshots, awb::Error::NotCalibrated if the response is not a plausible
+ *         loopback (e.g. the jumper is missing), awb::Error::InvalidParam for bad settings.
+ *
+ * The DAC and ADC share VREF+, so the ideal result for DAC code c is
+ * c * (2^bits - 1) / 4095 whatever the reference voltage. Each step averages whole
+ * oversampled snapshots, which keeps noise well under one code. Blocking: about
+ * steps * (settle_ms + (snapshots + 1) snapshot periods). Any calibration installed
+ * on @p adc is removed first so it measures raw codes; the DAC is left stopped.
+ */
+std::expected<AdcCalibration, awb::Error> RunLoopbackCalibration(Dac& dac, Adc<std::uint16_t>& adc,
+                                                                 const LoopbackSweep& sweep = {});
+
+/**
+ * @brief Reads a stored calibration.
+ * @param page Flash page written by SaveAdcCalibration().
+ * @return Table, or awb::Error::NotCalibrated if the page is blank or the record is damaged.
+ */
+std::expected<AdcCalibration, awb::Error> LoadAdcCalibration(const FlashPage& page);
+
+/**
+ * @brief Stores a calibration with its CRC (erases the page).
+ * @param page        Flash page reserved for the record.
+ * @param calibration Table to store.
+ * @return Nothing on success, or the FlashPage::Write() error.
+ */
+std::expected<void, awb::Error> SaveAdcCalibration(FlashPage& page, const AdcCalibration& calibration);
+
+}  // namespace hal
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "hal/gpio_impl.hpp"
+#include "hal/gpio_types.hpp"
+
+/**
+ * Compile-time board description.
+ *
+ * A board lists every pin it uses (PinAssignment) and every DMA channel it claims
+ * (DmaAssignment) in constexpr arrays, checks them with static_assert and the
+ * functions below, and configures all its pins with one InitPins() call. Porting
+ * to another board means rewriting the lists; a pin claimed twice, two EXTI pins
+ * on one line or a DMA channel that cannot serve a peripheral then fails the build
+ * instead of the bring-up.
+ */
+namespace hal {
+
+/**
+ * @brief What a board pin is used as.
+ */
+enum class PinMode : std::uint8_t {
+    Input,
+    Output,
+    Alternate,    ///< Peripheral function (PinAssignment::af)
+    Analog,       ///< DAC output or unused (lowest power)
+    AdcInput,     ///< Analog, connected to the ADC (the L47x's GPIOx_ASCR switch)
+    ExtiRising,   ///< Input with its EXTI line on the rising edge
+    ExtiFalling,  ///< Input with its EXTI line on the falling edge
+    ExtiBoth,     ///< Input with its EXTI line on both edges
+    Reserved,     ///< Claimed but left as reset configures it (e.g. SWD)
+};
+
+/**
+ * @brief One pin of a board and how it is configured.
+ */
+struct PinAssignment {
+    const char* owner = nullptr;  ///< What uses the pin (for readers; not checked)
+    PortBase port = 0;
+    PinMask pin = 0;  ///< Exactly one pin
+    PinMode mode = PinMode::Reserved;
+    Pull pull = Pull::None;
+    Speed speed = Speed::Low;
+    OutputType type = OutputType::PushPull;
+    std::uint8_t af = 0;         ///< Alternate function number (PinMode::Alternate only)
+    Level initial = Level::Low;  ///< Level driven before an output is enabled
+};
+
+/**
+ * @brief Builds a PinAssignment for a FastGpio pin.
+ * @tparam Gpio     FastGpio type (e.g. a board alias).
+ * @param owner    What uses the pin.
+ * @param settings Mode and electrical settings (owner, port and pin are filled in).
+ */
+template <typename Gpio>
+constexpr PinAssignment AssignPin(const char* owner, PinAssignment settings) {
+    settings.owner = owner;
+    settings.port = Gpio::kPort;
+    settings.pin = Gpio::kPin;
+    return settings;
+}
+
+/**
+ * @brief Peripheral requests that can be routed to a DMA channel (RM0351 tables 41 and 42).
+ * @note Only the peripherals the HAL wrappers drive by DMA; extend with the table as needed.
+ */
+enum class DmaRequest : std::uint8_t {
+    Adc1,
+    DacCh1,
+    DacCh2,
+    Usart1Tx,
+    Usart1Rx,
+    Usart2Tx,
+    Usart2Rx,
+    Tim1Up,
+};
+
+/**
+ * @brief One DMA channel claimed by a peripheral.
+ */
+struct DmaAssignment {
+    const char* owner;
+    DmaRequest request;
+    std::uint8_t controller;  ///< 1 or 2
+    std::uint8_t channel;     ///< 1..7
+};
+
+/**
+ * @brief Gets the CSELR value routing a request to a channel.
+ * @return DMA_REQUEST_n number, or -1 if the channel cannot serve the request.
+ */
+constexpr int DmaRequestSelection(DmaRequest request, std::uint8_t controller, std::uint8_t channel) {
+    struct Route {
+        DmaRequest request;
+        std::uint8_t controller;
+        std::uint8_t channel;
+        std::uint8_t selection;
+    };
+    constexpr Route kRoutes[] = {
+        {DmaRequest::Adc1, 1, 1, 0},     {DmaRequest::Adc1, 2, 3, 0},     {DmaRequest::DacCh1, 1, 3, 6},
+        {DmaRequest::DacCh1, 2, 4, 3},   {DmaRequest::DacCh2, 1, 4, 5},   {DmaRequest::DacCh2, 2, 5, 3},
+        {DmaRequest::Usart1Tx, 1, 4, 2}, {DmaRequest::Usart1Tx, 2, 6, 2}, {DmaRequest::Usart1Rx, 1, 5, 2},
+        {DmaRequest::Usart1Rx, 2, 7, 2}, {DmaRequest::Usart2Tx, 1, 7, 2}, {DmaRequest::Usart2Rx, 1, 6, 2},
+        {DmaRequest::Tim1Up, 1, 6, 7},
+    };
+    for (const Route& route : kRoutes) {
+        if (route.request == request && route.controller == controller && route.channel == channel) {
+            return route.selection;
+        }
+    }
+    return -1;
+}
+
+namespace detail {
+
+constexpr bool IsExti(PinMode mode) {
+    return mode == PinMode::ExtiRising || mode == PinMode::ExtiFalling || mode == PinMode::ExtiBoth;
+}
+
+constexpr std::size_t PortIndex(PortBase port) {
+    return (port - GPIOA_BASE) / (GPIOB_BASE - GPIOA_BASE);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Checks that every entry names one pin of a real port, and that alternate
+ *        function numbers are only given to PinMode::Alternate pins.
+ */
+template <std::size_t N>
+constexpr bool PinsAreWellFormed(const std::array<PinAssignment, N>& pins) {
+    for (const PinAssignment& p : pins) {
+        if (p.port < GPIOA_BASE || p.port > GPIOH_BASE || (p.port - GPIOA_BASE) % (GPIOB_BASE - GPIOA_BASE) != 0 ||
+            std::popcount(p.pin) != 1 || p.af > 15 || (p.mode != PinMode::Alternate && p.af != 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that no pin is claimed twice.
+ */
+template <std::size_t N>
+constexpr bool PinsAreUnique(const std::array<PinAssignment, N>& pins) {
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = i + 1; j < N; ++j) {
+            if (pins[i].port == pins[j].port && (pins[i].pin & pins[j].pin) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that no two EXTI pins share a line.
+ *
+ * EXTI line n serves pin n of one port only (SYSCFG_EXTICR picks which), so PA5
+ * and PC5 cannot both interrupt. The runtime registry (Gpio::AttachInterrupt())
+ * has one slot per line for the same reason.
+ */
+template <std::size_t N>
+constexpr bool ExtiLinesAreUnique(const std::array<PinAssignment, N>& pins) {
+    PinMask lines = 0;
+    for (const PinAssignment& p : pins) {
+        if (detail::IsExti(p.mode)) {
+            if ((lines & p.pin) != 0) {
+                return false;
+            }
+            lines |= p.pin;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that a pin is listed with an EXTI mode (e.g. before binding a handler to it).
+ */
+template <std::size_t N>
+constexpr bool HasExtiLine(const std::array<PinAssignment, N>& pins, PortBase port, PinMask pin) {
+    for (const PinAssignment& p : pins) {
+        if (p.port == port && p.pin == pin) {
+            return detail::IsExti(p.mode);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks that every DMA channel can serve its request, and that no channel
+ *        or request is claimed twice.
+ */
+template <std::size_t N>
+constexpr bool DmaAssignmentsAreValid(const std::array<DmaAssignment, N>& dma) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (DmaRequestSelection(dma[i].request, dma[i].controller, dma[i].channel) < 0) {
+            return false;
+        }
+        for (std::size_t j = i + 1; j < N; ++j) {
+            const bool same_channel = dma[i].controller == dma[j].controller && dma[i].channel == dma[j].channel;
+            if (same_channel || dma[i].request == dma[j].request) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Register values for the configured pins of one GPIO port.
+ *
+ * Each register is written as (reg & ~mask) | value, so pins outside the map keep
+ * their configuration. A mask only covers the fields HAL_GPIO_Init() would write
+ * for the pin's mode (e.g. OSPEEDR only for outputs and alternate functions).
+ */
+struct GpioPortImage {
+    PortBase port = 0;
+    std::uint32_t bsrr = 0;  ///< Initial output levels
+    std::uint32_t ospeedr = 0, ospeedr_mask = 0;
+    std::uint32_t otyper = 0, otyper_mask = 0;
+    std::uint32_t ascr = 0, ascr_mask = 0;  ///< ADC switch (written where the part has one)
+    std::uint32_t pupdr = 0, pupdr_mask = 0;
+    std::uint32_t afr[2] = {}, afr_mask[2] = {};
+    std::uint32_t moder = 0, moder_mask = 0;
+};
+
+/**
+ * @brief Register values for every pin of a board description (see ComputeGpioImage()).
+ */
+struct GpioImage {
+    static constexpr std::size_t kMaxPorts = 8;  ///< GPIOA..GPIOH
+
+    std::array<GpioPortImage, kMaxPorts> ports{};
+    std::size_t port_count = 0;
+    std::uint32_t exti_lines = 0;  ///< Lines configured as interrupts (IMR1 set, EMR1 cleared)
+    std::uint32_t rtsr = 0, ftsr = 0;
+    std::uint32_t exticr[4] = {}, exticr_mask[4] = {};  ///< SYSCFG port selection per line
+};
+
+/**
+ * @brief Computes the register values that configure a board description.
+ * @param pins The board's pin list (PinMode::Reserved entries are skipped).
+ * @return Image for ApplyGpioImage(); meant to be evaluated at compile time.
+ *
+ * Encodes what HAL_GPIO_Init() would write for each pin (RM0351 section 8.4).
+ */
+template <std::size_t N>
+constexpr GpioImage ComputeGpioImage(const std::array<PinAssignment, N>& pins) {
+    GpioImage image;
+    for (const PinAssignment& p : pins) {
+        if (p.mode == PinMode::Reserved) {
+            continue;
+        }
+
+        std::size_t slot = 0;
+        while (slot < image.port_count && image.ports[slot].port != p.port) {
+            ++slot;
+        }
+        if (slot == image.port_count) {
+            image.ports[image.port_count++].port = p.port;
+        }
+        GpioPortImage& port = image.ports[slot];
+
+        const unsigned index = static_cast<unsigned>(std::countr_zero(p.pin));
+        const unsigned shift2 = index * 2;
+        const bool output = p.mode == PinMode::Output;
+        const bool alternate = p.mode == PinMode::Alternate;
+        const bool analog = p.mode == PinMode::Analog || p.mode == PinMode::AdcInput;
+
+        if (output) {
+            port.bsrr |= (p.initial == Level::High) ? p.pin : (static_cast<std::uint32_t>(p.pin) << 16);
+        }
+        if (output || alternate) {
+            port.ospeedr_mask |= 0x3U << shift2;
+            port.ospeedr |= detail::SpeedToGpioSpeed(p.speed) << shift2;
+            port.otyper_mask |= p.pin;
+            port.otyper |= (p.type == OutputType::OpenDrain) ? p.pin : 0U;
+        }
+        if (analog) {
+            port.ascr_mask |= p.pin;
+            port.ascr |= (p.mode == PinMode::AdcInput) ? p.pin : 0U;
+        }
+        // The HAL leaves PUPDR alone for an analog pin asked to pull up
+        if (!analog || p.pull != Pull::Up) {
+            port.pupdr_mask |= 0x3U << shift2;
+            port.pupdr |= detail::PullToGpioPull(p.pull) << shift2;
+        }
+        if (alternate) {
+            const unsigned shift4 = (index % 8) * 4;
+            port.afr_mask[index / 8] |= 0xFU << shift4;
+            port.afr[index / 8] |= static_cast<std::uint32_t>(p.af) << shift4;
+        }
+        const std::uint32_t moder = output ? 1U : (alternate ? 2U : (analog ? 3U : 0U));
+        port.moder_mask |= 0x3U << shift2;
+        port.moder |= moder << shift2;
+
+        if (detail::IsExti(p.mode)) {
+            const unsigned shift_cr = (index % 4) * 4;
+            image.exti_lines |= p.pin;
+            image.rtsr |= (p.mode != PinMode::ExtiFalling) ? p.pin : 0U;
+            image.ftsr |= (p.mode != PinMode::ExtiRising) ? p.pin : 0U;
+            image.exticr_mask[index / 4] |= 0xFU << shift_cr;
+            image.exticr[index / 4] |= static_cast<std::uint32_t>(detail::PortIndex(p.port)) << shift_cr;
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief Writes a computed image: one pass over each port's registers.
+ * @param image Image from ComputeGpioImage().
+ *
+ * Port clocks are enabled, then each port's registers are written once, in the
+ * order HAL_GPIO_Init() uses (levels, speed and type, pulls, alternate functions,
+ * mode last) so no pin drives a wrong level or function on the way. EXTI routing
+ * and edges follow. HAL_GPIO_Init() instead loops over all 16 pin positions once
+ * per call, with one call (and one clock enable) per pin or per group of pins.
+ * @note SYSCFG's clock must be on when the image has EXTI lines (HAL_MspInit() does it).
+ */
+void ApplyGpioImage(const GpioImage& image);
+
+/**
+ * @brief Configures every pin of a board description.
+ * @tparam Pins The board's pin list (a constexpr std::array of PinAssignment).
+ *
+ * The register image is computed at compile time; at run time this is only the
+ * stores of ApplyGpioImage().
+ */
+template <const auto& Pins>
+void InitPins() {
+    static constexpr GpioImage kImage = ComputeGpioImage(Pins);
+    ApplyGpioImage(kImage);
+}
+
+}  // namespace hal
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+
+#include "hal/adc.hpp"
+#include "util/error_codes.hpp"
+
+namespace hal {
+
+/**
+ * @class CurrentMonitor
+ * @brief Motor over-current supervision with a hardware fast-trip.
+ * @tparam SampleType The data width of the ADC conversion (see hal::Adc).
+ *
+ * Uses the ADC analog watchdog on the current-sense channel, so the trip
+ * decision costs no CPU and is made on every conversion rather than whenever
+ * the control loop next polls. On the first conversion above the trip level
+ * the ADC interrupt calls the drive-disable function directly and latches
+ * awb::Error::MotorOvercurrent. The latch holds (and the watchdog stays quiet)
+ * until Clear() is called, so a fault cannot be missed or silently re-enabled.
+ *
+ * Worst-case trip latency is one conversion plus interrupt entry.
+ */
+template <typename SampleType = uint16_t>
+class CurrentMonitor {
+public:
+    /**
+     * @param adc             ADC sampling the current-sense channel.
+     * @param disable_outputs Puts the motor drive into a safe state. Runs in the ADC
+     *                        interrupt, so it must be short and must not block.
+     */
+    CurrentMonitor(Adc<SampleType>& adc, void (*disable_outputs)()) : adc_(adc), disable_outputs_(disable_outputs) {}
+
+    // Delete copy/move; the ADC interrupt holds a pointer to this object
+    CurrentMonitor(const CurrentMonitor&) = delete;
+    CurrentMonitor& operator=(const CurrentMonitor&) = delete;
+
+    /**
+     * @brief Starts supervising a current-sense channel.
+     * @param channel    HAL channel (e.g., ADC_CHANNEL_5) in the ADC's regular sequence.
+     * @param trip_level Raw ADC value above which the drive is cut.
+     * @return true if the watchdog was configured.
+     * @note Call while the ADC is stopped (see Adc::ArmWatchdog()).
+     */
+    bool Arm(std::uint32_t channel, SampleType trip_level);
+
+    /**
+     * @brief Stops supervising. Does not clear a latched trip.
+     */
+    void Disarm() { adc_.DisarmWatchdog(); }
+
+    /**
+     * @brief Reports the latched fault state.
+     * @return Nothing if healthy, awb::Error::MotorOvercurrent if tripped.
+     */
+    std::expected<void, awb::Error> Check() const;
+
+    /**
+     * @brief Clears the latch and re-enables the watchdog.
+     * @note The caller is responsible for re-enabling the drive afterwards.
+     */
+    void Clear();
+
+    bool IsTripped() const { return tripped_; }
+
+    /**
+     * @brief Gets the conversion result that caused the last trip.
+     */
+    SampleType GetTripValue() const { return trip_value_; }
+
+    /**
+     * @brief Gets the number of trips since construction.
+     */
+    std::uint32_t GetTripCount() const { return trip_count_; }
+
+private:
+    Adc<SampleType>& adc_;
+    void (*disable_outputs_)();
+
+    volatile bool tripped_ = false;
+    volatile SampleType trip_value_ = 0;
+    volatile std::uint32_t trip_count_ = 0;
+
+    static void OnTrip(void* self, std::uint32_t value);
+};
+
+}  // namespace hal
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hal {
+
+/**
+ * @brief Full-scale code of the 12-bit DAC.
+ */
+inline constexpr std::uint16_t kDacMaxCode = 4095;
+
+/**
+ * @brief Fills a table with one period of a symmetric triangle.
+ * @param table  Output samples (e.g. a Dac stream buffer).
+ * @param length Samples per period.
+ * @param low    Code at the start of the period.
+ * @param high   Code at the midpoint.
+ */
+void FillTriangle(std::uint16_t* table, std::size_t length, std::uint16_t low, std::uint16_t high);
+
+/**
+ * @class Dac
+ * @brief Timer-paced DAC channel: DMA waveform tables, hardware triangle/noise, or a held level.
+ *
+ * Every output update happens on a trigger from a basic timer (CubeMX: TIM6 with
+ * TRGO = update, DAC channel trigger = DAC_TRIGGER_T6_TRGO), so the output rate
+ * is set by the timer and not by when the CPU gets around to it. Streaming uses a
+ * circular memory-to-peripheral DMA (halfword, 12-bit right aligned), and the CPU
+ * is only involved at the half/full-transfer interrupts.
+ */
+class Dac {
+public:
+    /**
+     * @param handle  Reference to the HAL-generated DAC handle (e.g., hdac1).
+     * @param trigger Reference to the timer that triggers this channel (e.g., htim6).
+     * @param channel DAC_CHANNEL_1 or DAC_CHANNEL_2.
+     */
+    Dac(DAC_HandleTypeDef& handle, TIM_HandleTypeDef& trigger, std::uint32_t channel = DAC_CHANNEL_1)
+        : handle_(handle), trigger_(trigger), channel_(channel) {}
+
+    // Delete copy/move to prevent handle duplication
+    Dac(const Dac&) = delete;
+    Dac& operator=(const Dac&) = delete;
+
+    /**
+     * @brief Sets how often the output updates by reprogramming the trigger timer.
+     * @param timer_hz  Trigger timer kernel clock (e.g., board::clocks::kTim6Hz).
+     * @param sample_hz Output updates per second.
+     * @return true if set; false if the rate is zero or out of the timer's reach.
+     * @note While running the new rate takes effect at the next update, without a short sample.
+     */
+    bool SetSampleRate(std::uint32_t timer_hz, std::uint32_t sample_hz);
+
+    /**
+     * @brief Starts streaming a table to the output in a loop.
+     * @param buffer Samples (12-bit codes); read by DMA until Stop(), so it must outlive the stream.
+     * @param length Number of samples; must be even (two halves).
+     * @return true if started successfully.
+     */
+    bool Start(std::uint16_t* buffer, std::size_t length);
+
+    /**
+     * @brief Replaces the streamed table at the next period boundary.
+     * @param table  New samples; must stay valid until IsTablePending() returns false.
+     * @param length Must equal the length passed to Start().
+     * @return true if queued; false if not streaming, the length differs, or a swap is pending.
+     *
+     * The new table is copied into the stream buffer half by half, each half just
+     * after DMA has finished reading it: the lower half at the half-transfer
+     * interrupt, the upper half at the next transfer-complete. The output plays the
+     * old table to its end and the new one from its start, never a mix of the two.
+     */
+    bool QueueTable(const std::uint16_t* table, std::size_t length);
+
+    /**
+     * @brief Checks whether a table passed to QueueTable() is still being copied in.
+     */
+    bool IsTablePending() const { return pending_.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * @brief Starts the hardware triangle generator.
+     * @param base           Lowest code.
+     * @param amplitude_bits Peak-to-peak amplitude of 2^bits - 1 codes (1..12).
+     * @return true if started; false if the parameters are out of range or the peak exceeds full scale.
+     * @note The output steps by one code per trigger: one period is 2 * (2^bits - 1) triggers.
+     */
+    bool StartTriangle(std::uint16_t base, unsigned amplitude_bits);
+
+    /**
+     * @brief Starts the hardware noise generator (12-bit LFSR).
+     * @param base Lowest code.
+     * @param bits LFSR bits added to @p base (1..12): noise spans 0..2^bits - 1 codes.
+     * @return true if started; false if the parameters are out of range or the peak exceeds full scale.
+     */
+    bool StartNoise(std::uint16_t base, unsigned bits);
+
+    /**
+     * @brief Drives a constant code (stops any stream or generator).
+     * @param code 12-bit code; applied at the next trigger.
+     * @return true if started successfully.
+     */
+    bool SetValue(std::uint16_t code);
+
+    /**
+     * @brief Stops the trigger timer, the DMA and the channel.
+     */
+    void Stop();
+
+    /**
+     * @brief Drives code 0 from the next trigger, with register writes only.
+     *
+     * Cuts the DMA requests and the generators and zeroes the held code, leaving the
+     * trigger timer running to latch it. It takes no HAL lock and does not touch this
+     * object's state, so it may interrupt any other call on the same channel (e.g. from
+     * a fault handler). Follow up with Stop() or SetValue() from thread context.
+     */
+    void Mute();
+
+    /**
+     * @brief Checks whether the output is being driven (stream, generator or held level).
+     */
+    bool IsRunning() const { return mode_ != Mode::Idle; }
+
+    /**
+     * @brief Gets the code currently on the output.
+     */
+    std::uint16_t GetOutput() const { return static_cast<std::uint16_t>(HAL_DAC_GetValue(&handle_, channel_)); }
+
+private:
+    enum class Mode : std::uint8_t { Idle, Constant, Stream, Triangle, Noise };
+
+    bool StartWave(Mode mode, std::uint16_t base, unsigned bits);
+    void SetWaveGeneration(Mode mode, unsigned bits);
+    void OnTransfer(bool upper_half);
+    static void OnTransferComplete(void* self, bool upper_half);
+
+    DAC_HandleTypeDef& handle_;
+    TIM_HandleTypeDef& trigger_;
+    std::uint32_t channel_;
+    Mode mode_ = Mode::Idle;
+
+    std::uint16_t* buffer_ = nullptr;
+    std::size_t length_ = 0;
+    std::atomic<const std::uint16_t*> pending_{nullptr};
+    bool lower_swapped_ = false;  // The pending table's lower half is in the buffer
+};
+
+}  // namespace hal
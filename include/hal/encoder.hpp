@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstdint>
+
+namespace hal {
+
+/**
+ * @class EncoderTracker
+ * @brief Hardware-independent position/velocity bookkeeping for a quadrature counter.
+ *
+ * Extends a free-running 32-bit hardware count to 64 bits and estimates velocity.
+ * Kept free of HAL calls so it can be driven by any count source (or a mock timer).
+ *
+ * Velocity uses an adaptive window: it is recomputed once at least kMinWindowCounts
+ * edges have been seen (short window at speed) or once kMaxWindowUs has elapsed (long
+ * window when slow), and a stall reads 0 after one kMaxWindowUs. Below
+ * kMinWindowCounts per kMaxWindowUs (80 counts/s) the estimate is quantised to one
+ * count per window, i.e. 10 counts/s; finer low-speed resolution needs edge-period
+ * capture on a second timer.
+ */
+class EncoderTracker {
+public:
+    static constexpr int32_t kMinWindowCounts = 8;
+    static constexpr uint32_t kMaxWindowUs = 100'000;
+
+    /**
+     * @brief Resets the tracker to a known position.
+     * @param raw_count    Current raw hardware count.
+     * @param timestamp_us Current time in microseconds.
+     * @param position     Position to assign to raw_count.
+     */
+    void Reset(uint32_t raw_count, uint32_t timestamp_us, int64_t position = 0);
+
+    /**
+     * @brief Folds a new raw count into the position and velocity estimate.
+     * @param raw_count    Current raw hardware count.
+     * @param timestamp_us Current time in microseconds.
+     * @note Must be called at least once per 2^31 counts (trivially true in practice).
+     */
+    void Update(uint32_t raw_count, uint32_t timestamp_us);
+
+    int64_t GetPosition() const { return position_; }
+    int32_t GetVelocity() const { return velocity_; }
+
+private:
+    uint32_t last_raw_ = 0;
+    int64_t position_ = 0;
+    int32_t velocity_ = 0;  // counts per second
+
+    uint32_t window_start_us_ = 0;
+    int32_t window_counts_ = 0;
+};
+
+/**
+ * @class Encoder
+ * @brief Quadrature encoder on a general-purpose timer in encoder mode.
+ *
+ * The timer counts both edges of both channels in hardware (x4 decoding),
+ * so tracking position costs no CPU and no interrupts. Call Update()
+ * periodically (e.g. from the control loop) to extend the count and refresh
+ * the velocity estimate.
+ */
+class Encoder {
+public:
+    /**
+     * @brief Lightweight wrapper around a HAL timer handle configured in encoder mode.
+     * @param handle Reference to the HAL-generated TIM handle (e.g., htim2).
+     */
+    explicit Encoder(TIM_HandleTypeDef& handle) : handle_(handle) {}
+
+    // Delete copy/move to prevent handle duplication
+    Encoder(const Encoder&) = delete;
+    Encoder& operator=(const Encoder&) = delete;
+
+    /**
+     * @brief Starts the encoder interface on both channels.
+     * @param timestamp_us Current time in microseconds.
+     * @return true if started successfully.
+     */
+    bool Start(uint32_t timestamp_us);
+
+    /**
+     * @brief Stops the encoder interface.
+     */
+    void Stop();
+
+    /**
+     * @brief Samples the hardware counter and refreshes position/velocity.
+     * @param timestamp_us Current time in microseconds.
+     */
+    void Update(uint32_t timestamp_us) { tracker_.Update(ReadRaw(), timestamp_us); }
+
+    /**
+     * @brief Redefines the current position (e.g. after homing).
+     * @param position     New position in counts.
+     * @param timestamp_us Current time in microseconds.
+     */
+    void SetPosition(int64_t position, uint32_t timestamp_us) { tracker_.Reset(ReadRaw(), timestamp_us, position); }
+
+    /**
+     * @brief Gets the 64-bit extended position as of the last Update().
+     * @return Position in encoder counts.
+     */
+    int64_t GetPosition() const { return tracker_.GetPosition(); }
+
+    /**
+     * @brief Gets the velocity estimate as of the last Update().
+     * @return Velocity in counts per second (positive = counting up).
+     */
+    int32_t GetVelocity() const { return tracker_.GetVelocity(); }
+
+    /**
+     * @brief Reads the raw 32-bit hardware count.
+     * @return TIMx->CNT.
+     */
+    uint32_t ReadRaw() const { return handle_.Instance->CNT; }
+
+private:
+    TIM_HandleTypeDef& handle_;
+    EncoderTracker tracker_;
+};
+
+}  // namespace hal
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <bit>
+
+#include "hal/fast_gpio.hpp"
+#include "hal/gpio_types.hpp"
+
+namespace hal {
+namespace detail {
+// EXTI lines sharing the EXTI9_5 and EXTI15_10 vectors
+inline constexpr PinMask kExti9_5Lines = 0x03E0;
+inline constexpr PinMask kExti15_10Lines = 0xFC00;
+
+void DispatchExtiRuntime(uint32_t pending);
+}  // namespace detail
+
+/**
+ * @brief Compile-time association of a FastGpio pin with its EXTI handler.
+ * @tparam Gpio    FastGpio type; EXTI line n is pin n of whichever port SYSCFG routes to it.
+ * @tparam Handler Function called from the EXTI interrupt.
+ * @note Usually spelled `MyPin::Interrupt<Handler>`.
+ */
+template <typename Gpio, void (*Handler)()>
+struct ExtiBinding {
+    static constexpr PinMask kLines = Gpio::kPin;
+    static constexpr void (*kHandler)() = Handler;
+};
+
+/**
+ * @class ExtiDispatcher
+ * @brief Inline EXTI dispatch for a fixed set of bindings.
+ * @tparam Bindings ExtiBinding types.
+ *
+ * Instead of HAL_GPIO_EXTI_IRQHandler -> HAL_GPIO_EXTI_Callback -> table lookup,
+ * each IRQ handler reads EXTI->PR1 once, clears the bound pending bits with one
+ * store and calls the bound handlers directly. Shared vectors (5-9, 10-15) test
+ * only the lines that have a binding. Pending lines without a binding fall back
+ * to the runtime registry used by Gpio::AttachInterrupt().
+ *
+ * Use AWB_EXTI_DISPATCH() in exactly one source file to emit the IRQ handlers.
+ */
+template <typename... Bindings>
+class ExtiDispatcher {
+public:
+    static constexpr PinMask kBound = (PinMask{0} | ... | Bindings::kLines);
+
+    static_assert((0 + ... + std::popcount(Bindings::kLines)) == std::popcount(kBound),
+                  "Two handlers are bound to the same EXTI line");
+
+    /**
+     * @brief Services every pending line of one EXTI vector.
+     * @tparam VectorLines Mask of EXTI lines sharing the vector (e.g. 0xFC00 for EXTI15_10).
+     */
+    template <PinMask VectorLines>
+    [[gnu::always_inline]]
+    static inline void Dispatch() {
+        constexpr uint32_t bound = kBound & VectorLines;
+        const uint32_t pending = EXTI->PR1 & VectorLines;
+
+        if constexpr (bound != 0) {
+            const uint32_t hits = pending & bound;
+            EXTI->PR1 = hits;  // write-1-to-clear
+            (Call<Bindings, VectorLines>(hits), ...);
+        }
+
+        if constexpr (bound != VectorLines) {
+            if (pending & ~bound) {
+                detail::DispatchExtiRuntime(pending & ~bound);
+            }
+        }
+    }
+
+private:
+    template <typename Binding, PinMask VectorLines>
+    [[gnu::always_inline]]
+    static inline void Call(const uint32_t hits) {
+        if constexpr ((Binding::kLines & VectorLines) != 0) {
+            if (hits & Binding::kLines) {
+                Binding::kHandler();
+            }
+        }
+    }
+};
+
+}  // namespace hal
+
+/**
+ * @brief Emits the EXTI IRQ handlers for a set of compile-time bindings.
+ *
+ * Place at namespace scope in one source file, after the handlers are declared:
+ * @code
+ * AWB_EXTI_DISPATCH(board::pins::UserButton::Interrupt<OnButtonPressed>);
+ * @endcode
+ * The EXTI line must still be configured (edge, SYSCFG routing, NVIC enable) in CubeMX,
+ * with "Generate IRQ handler" unticked for the vectors defined here.
+ */
+#define AWB_EXTI_DISPATCH(...)                                                                               \
+    using AwbExtiDispatcher_ = hal::ExtiDispatcher<__VA_ARGS__>;                                             \
+    extern "C" void EXTI0_IRQHandler(void) { AwbExtiDispatcher_::Dispatch<GPIO_PIN_0>(); }                   \
+    extern "C" void EXTI1_IRQHandler(void) { AwbExtiDispatcher_::Dispatch<GPIO_PIN_1>(); }                   \
+    extern "C" void EXTI2_IRQHandler(void) { AwbExtiDispatcher_::Dispatch<GPIO_PIN_2>(); }                   \
+    extern "C" void EXTI3_IRQHandler(void) { AwbExtiDispatcher_::Dispatch<GPIO_PIN_3>(); }                   \
+    extern "C" void EXTI4_IRQHandler(void) { AwbExtiDispatcher_::Dispatch<GPIO_PIN_4>(); }                   \
+    extern "C" void EXTI9_5_IRQHandler(void) { AwbExtiDispatcher_::Dispatch<hal::detail::kExti9_5Lines>(); } \
+    extern "C" void EXTI15_10_IRQHandler(void) { AwbExtiDispatcher_::Dispatch<hal::detail::kExti15_10Lines>(); }
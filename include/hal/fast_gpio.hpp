@@ -1,14 +1,41 @@
 #pragma once
 
+#include <cstddef>
+
 #include "hal/gpio_impl.hpp"
 #include "hal/gpio_types.hpp"
 
-// TODO: Need to change reads and writes to use registers directly for speed
-
 namespace hal {
+
+template <typename Gpio, void (*Handler)()>
+struct ExtiBinding;
+
 namespace detail {
 void RegisterExtiCallback(uint8_t index, void (*cb)(void));
+
+// GPIO register offsets from RM0351 (STM32L4 reference manual), section 8.5.
+// FastGpio folds these into absolute addresses at compile time.
+static_assert(offsetof(GPIO_TypeDef, IDR) == 0x10, "GPIOx_IDR offset mismatch");
+static_assert(offsetof(GPIO_TypeDef, ODR) == 0x14, "GPIOx_ODR offset mismatch");
+static_assert(offsetof(GPIO_TypeDef, BSRR) == 0x18, "GPIOx_BSRR offset mismatch");
+static_assert(offsetof(GPIO_TypeDef, BRR) == 0x28, "GPIOx_BRR offset mismatch");
+
+/**
+ * @brief Accesses a 32-bit peripheral register at a fixed address.
+ * @param address Absolute register address.
+ * @return Volatile reference to the register (a register proxy in the host simulation).
+ */
+#ifdef AWB_SIM_HAL
+static inline sim::RegisterRef Reg(const std::uintptr_t address) {
+    return sim::RegisterRef(address);
+}
+#else
+[[gnu::always_inline]]
+static inline volatile uint32_t& Reg(const std::uintptr_t address) {
+    return *reinterpret_cast<volatile uint32_t*>(address);
 }
+#endif
+}  // namespace detail
 
 /**
  * @class FastGpio
@@ -29,6 +56,12 @@ public:
     static constexpr PortBase kPort = PORT;
     static constexpr PinMask kPin = PIN;
 
+    // Absolute register addresses, folded at compile time
+    static constexpr std::uintptr_t kIdr = PORT + offsetof(GPIO_TypeDef, IDR);
+    static constexpr std::uintptr_t kOdr = PORT + offsetof(GPIO_TypeDef, ODR);
+    static constexpr std::uintptr_t kBsrr = PORT + offsetof(GPIO_TypeDef, BSRR);
+    static constexpr std::uintptr_t kBrr = PORT + offsetof(GPIO_TypeDef, BRR);
+
     /**
      * @brief Resets the GPIO pin to its default state.
      */
@@ -39,10 +72,19 @@ public:
      */
     static void Lock() { HAL_GPIO_LockPin(detail::PortPtr(PORT), PIN); }
 
+    /**
+     * @brief Compile-time EXTI binding for this pin, for use with AWB_EXTI_DISPATCH() (hal/exti.hpp).
+     * @tparam Handler Function called directly from the EXTI IRQ handler.
+     * @note Preferred over AttachInterrupt() for high-rate edges: no HAL callback or table lookup.
+     */
+    template <void (*Handler)()>
+    using Interrupt = ExtiBinding<FastGpio, Handler>;
+
     /**
      * @brief Registers a function to be called when this pin triggers an interrupt.
      * @param callback Function pointer (void function(void)).
      * @warning You must Enable the EXTI Interrupt in CubeMX NVIC settings!
+     * @note Runtime path via a callback table; see Interrupt for the zero-overhead binding.
      */
     static void AttachInterrupt(void (*callback)(void)) {
         constexpr uint8_t pin_index = __builtin_ctz(PIN);
@@ -80,26 +122,31 @@ public:
 
     /**
      * @brief Drives the pin HIGH.
+     * @note Single store to BSRR; atomic with respect to other pins and ISRs.
      */
     [[gnu::always_inline]]
     static inline void Set() {
-        HAL_GPIO_WritePin(detail::PortPtr(PORT), PIN, GPIO_PIN_SET);
+        detail::Reg(kBsrr) = PIN;
     }
 
     /**
      * @brief Drives the pin LOW.
+     * @note Single store to BRR; atomic with respect to other pins and ISRs.
      */
     [[gnu::always_inline]]
     static inline void Clear() {
-        HAL_GPIO_WritePin(detail::PortPtr(PORT), PIN, GPIO_PIN_RESET);
+        detail::Reg(kBrr) = PIN;
     }
 
     /**
      * @brief Toggles the pin state (HIGH ↔ LOW).
+     * @note Reads ODR but writes through BSRR, so an ISR changing another pin on
+     *       the same port between the read and the write is never overwritten.
      */
     [[gnu::always_inline]]
     static inline void Toggle() {
-        HAL_GPIO_TogglePin(detail::PortPtr(PORT), PIN);
+        const uint32_t odr = detail::Reg(kOdr);
+        detail::Reg(kBsrr) = ((odr & PIN) << 16) | (~odr & PIN);
     }
 
     /**
@@ -108,8 +155,7 @@ public:
      */
     [[gnu::always_inline]]
     static inline Level ReadLevel() {
-        GPIO_PinState state = HAL_GPIO_ReadPin(detail::PortPtr(PORT), PIN);
-        return (state == GPIO_PIN_SET) ? Level::High : Level::Low;
+        return (detail::Reg(kIdr) & PIN) ? Level::High : Level::Low;
     }
 
     /**
@@ -118,8 +164,7 @@ public:
      */
     [[gnu::always_inline]]
     static inline int Read() {
-        GPIO_PinState state = HAL_GPIO_ReadPin(detail::PortPtr(PORT), PIN);
-        return static_cast<int>(state == GPIO_PIN_SET);
+        return static_cast<int>((detail::Reg(kIdr) & PIN) != 0);
     }
 };
 
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <tuple>
+
+#include "hal/fast_gpio.hpp"
+
+namespace hal {
+
+/**
+ * @class FastGpioGroup
+ * @brief Several FastGpio pins on one port, written together with a single BSRR store.
+ * @tparam Gpios FastGpio types (e.g. board aliases). All must share one port.
+ *
+ * Pin masks are merged at compile time. Patterns are indexed by declaration
+ * order: bit 0 of a pattern drives the first Gpio, bit 1 the second, and so on.
+ * Every pin in the group changes on the same bus write, so there is no skew
+ * between them (e.g. H-bridge or stepper phases switched from a step ISR).
+ *
+ * @code
+ * using Phases = hal::FastGpioGroup<PhaseA, PhaseB, PhaseC, PhaseD>;
+ * constexpr uint32_t kFullStep[] = {Phases::Encode(0b0011), Phases::Encode(0b0110),
+ *                                   Phases::Encode(0b1100), Phases::Encode(0b1001)};
+ * Phases::WriteRaw(kFullStep[step & 3]);  // one str
+ * @endcode
+ */
+template <typename... Gpios>
+class FastGpioGroup {
+    static_assert(sizeof...(Gpios) > 0, "FastGpioGroup needs at least one pin");
+
+    using First = std::tuple_element_t<0, std::tuple<Gpios...>>;
+
+public:
+    // Prevent instantiation
+    FastGpioGroup() = delete;
+
+    static constexpr PortBase kPort = First::kPort;
+    static constexpr PinMask kMask = (Gpios::kPin | ...);
+    static constexpr std::size_t kCount = sizeof...(Gpios);
+
+    static_assert(((Gpios::kPort == kPort) && ...), "FastGpioGroup pins must all be on the same port");
+    static_assert((std::popcount(Gpios::kPin) + ...) == std::popcount(kMask), "FastGpioGroup pins must be distinct");
+    static_assert(kCount <= 16, "A GPIO port has at most 16 pins");
+
+    /**
+     * @brief Builds the BSRR word that drives the given pins HIGH and the rest of the group LOW.
+     * @param high Pin mask of group pins to drive HIGH (pins outside the group are ignored).
+     * @return Value to pass to WriteRaw().
+     */
+    static constexpr uint32_t EncodePins(PinMask high) {
+        high &= kMask;
+        return (static_cast<uint32_t>(kMask & ~high) << 16) | high;
+    }
+
+    /**
+     * @brief Builds the BSRR word for a pattern indexed by declaration order.
+     * @param pattern Bit i set = i-th Gpio HIGH.
+     * @return Value to pass to WriteRaw(). Use in constexpr tables to pay nothing at runtime.
+     */
+    static constexpr uint32_t Encode(uint32_t pattern) {
+        constexpr PinMask pins[] = {Gpios::kPin...};
+        PinMask high = 0;
+        for (std::size_t i = 0; i < kCount; ++i) {
+            if (pattern & (1u << i)) {
+                high |= pins[i];
+            }
+        }
+        return EncodePins(high);
+    }
+
+    /**
+     * @brief Writes a precomputed BSRR word (see Encode()/EncodePins()).
+     * @param bsrr Value stored to BSRR unchanged.
+     */
+    [[gnu::always_inline]]
+    static inline void WriteRaw(uint32_t bsrr) {
+        detail::Reg(First::kBsrr) = bsrr;
+    }
+
+    /**
+     * @brief Drives every group pin to the state given by a declaration-order pattern.
+     * @param pattern Bit i set = i-th Gpio HIGH.
+     */
+    [[gnu::always_inline]]
+    static inline void Write(uint32_t pattern) {
+        WriteRaw(Encode(pattern));
+    }
+
+    /**
+     * @brief Drives every group pin using a port pin mask.
+     * @param high Pin mask of group pins to drive HIGH; the rest go LOW.
+     */
+    [[gnu::always_inline]]
+    static inline void WritePins(PinMask high) {
+        WriteRaw(EncodePins(high));
+    }
+
+    /**
+     * @brief Drives every group pin HIGH.
+     */
+    [[gnu::always_inline]]
+    static inline void Set() {
+        detail::Reg(First::kBsrr) = kMask;
+    }
+
+    /**
+     * @brief Drives every group pin LOW.
+     */
+    [[gnu::always_inline]]
+    static inline void Clear() {
+        detail::Reg(First::kBrr) = kMask;
+    }
+
+    /**
+     * @brief Toggles every group pin.
+     * @note Reads ODR but writes through BSRR, so other pins on the port are never touched.
+     */
+    [[gnu::always_inline]]
+    static inline void Toggle() {
+        const uint32_t odr = detail::Reg(First::kOdr);
+        detail::Reg(First::kBsrr) = ((odr & kMask) << 16) | (~odr & kMask);
+    }
+
+    /**
+     * @brief Reads the input state of the group pins.
+     * @return Port pin mask with only group pins that read HIGH set.
+     */
+    [[gnu::always_inline]]
+    static inline PinMask Read() {
+        return static_cast<PinMask>(detail::Reg(First::kIdr) & kMask);
+    }
+};
+
+}  // namespace hal
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "util/error_codes.hpp"
+
+namespace hal {
+
+/**
+ * @class FlashPage
+ * @brief One erasable page of internal flash, read in place and rewritten whole.
+ *
+ * For small records that must survive resets and power loss (e.g. calibration).
+ * Keep the page out of the linker script's FLASH region so code never lands in it.
+ * Writing erases the page, then programs it in 64-bit double words (the L4's
+ * programming unit, each carrying its own ECC). The CPU stalls on flash fetches
+ * while the page erases (~22 ms), so write outside time-critical phases.
+ */
+class FlashPage {
+public:
+    static constexpr std::size_t kSize = FLASH_PAGE_SIZE;
+
+    /**
+     * @param address Page start (a multiple of kSize inside main flash).
+     */
+    explicit FlashPage(std::uintptr_t address) : address_(address) {}
+
+    /**
+     * @brief Gets the page contents (memory-mapped; 0xFF where erased).
+     */
+    const std::uint8_t* Data() const;
+
+    /**
+     * @brief Replaces the page contents.
+     * @param data Bytes to store; the rest of the page is left erased.
+     * @param size Number of bytes (at most kSize).
+     * @return Nothing on success; awb::Error::InvalidParam if misaligned or too large,
+     *         awb::Error::FlashFailure if the erase or a program step failed.
+     */
+    std::expected<void, awb::Error> Write(const void* data, std::size_t size);
+
+private:
+    std::uintptr_t address_;
+};
+
+}  // namespace hal
@@ -9,7 +9,7 @@ namespace hal::detail {
  * @param type The output driver type (PushPull or OpenDrain).
  * @return HAL GPIO alternate function mode constant.
  */
-static inline uint32_t OutputTypeToAfMode(const OutputType type) {
+static constexpr uint32_t OutputTypeToAfMode(const OutputType type) {
     switch (type) {
         case hal::OutputType::OpenDrain: return GPIO_MODE_AF_OD;
         case hal::OutputType::PushPull:
@@ -21,7 +21,7 @@ static inline uint32_t OutputTypeToAfMode(const OutputType type) {
  * @param type The output driver type (PushPull or OpenDrain).
  * @return HAL GPIO output mode constant.
  */
-static inline uint32_t OutputTypeToGpioMode(const OutputType type) {
+static constexpr uint32_t OutputTypeToGpioMode(const OutputType type) {
     switch (type) {
         case hal::OutputType::OpenDrain: return GPIO_MODE_OUTPUT_OD;
         case hal::OutputType::PushPull:
@@ -34,7 +34,7 @@ static inline uint32_t OutputTypeToGpioMode(const OutputType type) {
  * @param speed The desired switching speed (Low, Medium, High, or VeryHigh).
  * @return HAL GPIO speed constant.
  */
-static inline uint32_t SpeedToGpioSpeed(const Speed speed) {
+static constexpr uint32_t SpeedToGpioSpeed(const Speed speed) {
     switch (speed) {
         case hal::Speed::Medium:   return GPIO_SPEED_FREQ_MEDIUM;
         case hal::Speed::High:     return GPIO_SPEED_FREQ_HIGH;
@@ -49,7 +49,7 @@ static inline uint32_t SpeedToGpioSpeed(const Speed speed) {
  * @param pull The pull resistor configuration (None, Up, or Down).
  * @return HAL GPIO pull configuration constant.
  */
-static inline uint32_t PullToGpioPull(const Pull pull) {
+static constexpr uint32_t PullToGpioPull(const Pull pull) {
     switch (pull) {
         case hal::Pull::Up:   return GPIO_PULLUP;
         case hal::Pull::Down: return GPIO_PULLDOWN;
@@ -70,6 +70,7 @@ static inline void EnableGpioClock(const PortBase port_base) {
         case GPIOC_BASE: __HAL_RCC_GPIOC_CLK_ENABLE(); break;
         case GPIOD_BASE: __HAL_RCC_GPIOD_CLK_ENABLE(); break;
         case GPIOE_BASE: __HAL_RCC_GPIOE_CLK_ENABLE(); break;
+        case GPIOH_BASE: __HAL_RCC_GPIOH_CLK_ENABLE(); break;
     }
 }
 
@@ -79,29 +80,11 @@ static inline void EnableGpioClock(const PortBase port_base) {
  * @return Pointer to the GPIO_TypeDef structure.
  */
 static inline GPIO_TypeDef* PortPtr(const PortBase& p) {
+#ifdef AWB_SIM_HAL
+    return sim::GpioPort(p);
+#else
     return reinterpret_cast<GPIO_TypeDef*>(p);
-}
-
-/**
- * @brief Configures a GPIO pin with the specified mode and characteristics.
- * @param port    The GPIO port base address.
- * @param pin     The pin mask (e.g., GPIO_PIN_5).
- * @param mode    The GPIO mode constant (input, output, alternate, analog).
- * @param pull    The pull resistor configuration.
- * @param speed   The switching speed.
- * @param af_num  The alternate function number (0-15, default 0 for non-alternate modes).
- * @details Automatically enables the GPIO port clock before configuration.
- */
-static inline void ConfigureGpio(PortBase port, PinMask pin, uint32_t mode, uint32_t pull, uint32_t speed,
-                                 uint32_t af_num = 0) {
-    EnableGpioClock(port);
-    GPIO_InitTypeDef init = {};
-    init.Pin = pin;
-    init.Mode = mode;
-    init.Pull = pull;
-    init.Speed = speed;
-    init.Alternate = af_num;
-    HAL_GPIO_Init(PortPtr(port), &init);
+#endif
 }
 
 }  // namespace hal::detail
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "hal/sys_tick_clock.hpp"
+#include "util/error_codes.hpp"
+
+namespace hal {
+
+/**
+ * @brief What ended the last STOP2 period.
+ */
+enum class WakeSource : uint8_t {
+    None,       ///< Has not been in STOP2 yet
+    Timer,      ///< RTC wake-up timer expired (requested sleep completed)
+    Interrupt,  ///< Any other enabled interrupt, e.g. the UserButton EXTI line or an RTC alarm
+};
+
+/**
+ * @brief Callbacks that park and re-arm one peripheral around STOP2.
+ *
+ * Either pointer may be nullptr. Suspend hooks run in registration order before
+ * entering STOP2; resume hooks run in reverse order after the clocks are restored.
+ * Both run in thread context with interrupts enabled.
+ */
+struct LowPowerHooks {
+    void (*suspend)();
+    void (*resume)();
+};
+
+/**
+ * @brief Power manager accounting.
+ */
+struct PowerStats {
+    uint32_t stop_entries = 0;          ///< Number of STOP2 periods
+    uint32_t stop_ms = 0;               ///< Total time spent in STOP2
+    uint32_t last_wake_latency_us = 0;  ///< Wake-up to clocks and peripherals ready, most recent
+    uint32_t max_wake_latency_us = 0;   ///< Worst wake-up latency observed
+    WakeSource last_wake_source = WakeSource::None;
+};
+
+/**
+ * @class PowerManager
+ * @brief Idles the core in STOP2 when nothing needs the CPU.
+ *
+ * STOP2 keeps SRAM and peripheral registers but stops every high-speed clock,
+ * dropping the MCU from several mA to a few uA. The RTC keeps running from
+ * the LSE and serves both as the wake-up timer and as the time base used to
+ * advance the HAL tick by the time spent asleep, so HAL_GetTick() (and the
+ * scheduler) stay in step with wall-clock time.
+ *
+ * The core wakes on the RTC wake-up timer, an RTC alarm or any enabled EXTI
+ * line (e.g. the UserButton). It wakes on HSI16, which is also the PLL source,
+ * so only the PLL has to be restarted before the registered resume hooks
+ * re-arm ADC/DMA streams.
+ *
+ * @note Requires the DWT cycle counter (SysTickClock::Init()) for latency measurement.
+ * @note Enables RTC shadow register bypass; read the calendar with HAL_RTC_GetTime()
+ *       twice and compare if exact coherency matters.
+ */
+class PowerManager {
+public:
+    static constexpr std::size_t kMaxHooks = 8;
+
+    /**
+     * @brief Sleeps shorter than this use WFI in SLEEP mode instead of STOP2.
+     * Entering and leaving STOP2 (hooks, PLL lock) costs more than it saves below this.
+     */
+    static constexpr uint32_t kMinStopMs = 3;
+
+    /**
+     * @brief Longest single STOP2 period (the wake-up timer is 16-bit at 2048 Hz).
+     */
+    static constexpr uint32_t kMaxStopMs = 30'000;
+
+    /**
+     * @brief  Gets the singleton instance of the PowerManager.
+     * @return Reference to the single PowerManager object.
+     */
+    static PowerManager& GetInstance();
+
+    PowerManager(const PowerManager&) = delete;
+    void operator=(const PowerManager&) = delete;
+
+    /**
+     * @brief Binds the RTC used for wake-up and timekeeping.
+     * @param rtc Pointer to the initialized HAL RTC handle (e.g., &hrtc).
+     */
+    void Init(RTC_HandleTypeDef* rtc);
+
+    /**
+     * @brief Registers a peripheral to be parked and re-armed around STOP2.
+     * @param hooks Suspend/resume callbacks.
+     * @return false if kMaxHooks hooks are already registered.
+     */
+    bool AddHooks(const LowPowerHooks& hooks);
+
+    /**
+     * @brief Keeps the core out of STOP2 (e.g. while the motor is moving or telemetry is streaming).
+     * @note Nestable; each call must be balanced by Allow(). Call from thread context only.
+     */
+    void Inhibit() { inhibit_count_++; }
+
+    /**
+     * @brief Releases one Inhibit().
+     */
+    void Allow() {
+        if (inhibit_count_ > 0) {
+            inhibit_count_--;
+        }
+    }
+
+    /**
+     * @brief Checks whether Sleep() may enter STOP2.
+     * @return true if initialized and not inhibited.
+     */
+    bool IsStopAllowed() const { return rtc_ != nullptr && inhibit_count_ == 0; }
+
+    /**
+     * @brief Sleeps until the next interrupt, for at most max_ms.
+     * @param max_ms Longest time to stay asleep (clamped to kMaxStopMs).
+     * @return Milliseconds spent in STOP2 (0 if it only executed WFI), or
+     *         Error::Timeout if the RTC wake-up timer could not be programmed.
+     * @note Uses STOP2 only if IsStopAllowed() and max_ms >= kMinStopMs.
+     */
+    std::expected<uint32_t, awb::Error> Sleep(uint32_t max_ms);
+
+    const PowerStats& GetStats() const { return stats_; }
+    void ResetStats() { stats_ = {}; }
+
+private:
+    PowerManager() = default;
+
+    RTC_HandleTypeDef* rtc_ = nullptr;
+    std::array<LowPowerHooks, kMaxHooks> hooks_{};
+    std::size_t hook_count_ = 0;
+    uint32_t inhibit_count_ = 0;
+    PowerStats stats_{};
+
+    uint32_t ReadRtcMs() const;
+    static uint32_t RestoreClocks();
+};
+
+/**
+ * @brief Scheduler clock policy that idles in STOP2 through the PowerManager.
+ *
+ * Drop-in replacement for SysTickClock: Idle() hands the time until the next
+ * task release to PowerManager::Sleep().
+ */
+struct LowPowerClock : SysTickClock {
+    static void Idle(uint32_t max_ticks) { (void)PowerManager::GetInstance().Sleep(max_ticks); }
+};
+
+}  // namespace hal
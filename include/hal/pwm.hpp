@@ -0,0 +1,159 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "util/error_codes.hpp"
+
+namespace hal {
+
+/**
+ * @brief Longest dead time the BDTR DTG field can encode, in timer ticks.
+ */
+inline constexpr std::uint32_t kMaxDeadTimeTicks = 1008;
+
+/**
+ * @brief Encodes a dead time into the BDTR DTG field.
+ * @param timer_hz     Timer kernel clock (dead time counts it undivided: ClockDivision = DIV1).
+ * @param dead_time_ns Shortest gap between one output of a pair turning off and the other turning on.
+ * @return DTG value, rounded up to the next step the field can express;
+ *         awb::Error::InvalidParam if it is over kMaxDeadTimeTicks.
+ *
+ * DTG is piecewise: 0..127 ticks in steps of 1, 128..254 in steps of 2,
+ * 256..504 in steps of 8 and 512..1008 in steps of 16 (RM0351, TIMx_BDTR).
+ */
+constexpr std::expected<std::uint8_t, awb::Error> ComputeDeadTime(std::uint32_t timer_hz, std::uint32_t dead_time_ns) {
+    const std::uint64_t ticks = (static_cast<std::uint64_t>(dead_time_ns) * timer_hz + 999'999'999ULL) /
+                                1'000'000'000ULL;
+    if (timer_hz == 0 || ticks > kMaxDeadTimeTicks) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+    if (ticks <= 127) {
+        return static_cast<std::uint8_t>(ticks);
+    }
+    if (ticks <= 254) {
+        return static_cast<std::uint8_t>(0x80U | ((ticks + 1) / 2 - 64));
+    }
+    if (ticks <= 504) {
+        return static_cast<std::uint8_t>(0xC0U | ((ticks + 7) / 8 - 32));
+    }
+    return static_cast<std::uint8_t>(0xE0U | ((ticks + 15) / 16 - 32));
+}
+
+/**
+ * @brief Decodes a BDTR DTG value.
+ * @param dead_time DTG value (e.g., from ComputeDeadTime()).
+ * @return Dead time in timer ticks.
+ */
+constexpr std::uint32_t DeadTimeTicks(std::uint8_t dead_time) {
+    if ((dead_time & 0x80U) == 0) {
+        return dead_time;
+    }
+    if ((dead_time & 0xC0U) == 0x80U) {
+        return (64U + (dead_time & 0x3FU)) * 2U;
+    }
+    if ((dead_time & 0xE0U) == 0xC0U) {
+        return (32U + (dead_time & 0x1FU)) * 8U;
+    }
+    return (32U + (dead_time & 0x1FU)) * 16U;
+}
+
+/**
+ * @class Pwm
+ * @brief Complementary PWM outputs with dead time on channels 1-3 of an advanced timer.
+ *
+ * Shares the timer with PwmSync: PwmSync owns the centre-aligned timebase and
+ * channel 4 (the ADC trigger), Pwm owns channels 1-3 and their CHxN outputs. In
+ * PWM mode 1 each CHx is high while the counter is below its compare, so a pulse
+ * of 2 * compare ticks is centred on the counter valley, where the ADC samples;
+ * CHxN is its complement with the dead time cut out of both edges.
+ *
+ * Compares are preloaded: new duties take effect at the next update event. With
+ * RepetitionCounter = 1 (CubeMX) that is once per period, at the counter peak, so
+ * every pulse is symmetric.
+ *
+ * While the outputs are disabled (the default, and after Disable()) every CHx and
+ * CHxN is driven low (OSSI = 1 with idle levels low), which turns both switches of
+ * each bridge leg off. Break inputs are not used.
+ */
+class Pwm {
+public:
+    static constexpr std::size_t kChannels = 3;
+
+    /**
+     * @param handle Reference to the HAL-generated handle of a centre-aligned advanced timer (e.g., htim1).
+     */
+    explicit Pwm(TIM_HandleTypeDef& handle) : handle_(handle) {}
+
+    // Delete copy/move to prevent handle duplication
+    Pwm(const Pwm&) = delete;
+    Pwm& operator=(const Pwm&) = delete;
+
+    /**
+     * @brief Sets up channels 1-3 as complementary PWM outputs, disabled, with every duty at zero.
+     * @param dead_time DTG value from ComputeDeadTime().
+     * @return true if configured; false if the timer is not centre-aligned or divides its
+     *         dead-time clock (ClockDivision other than DIV1).
+     * @note Call after PwmSync::Start(): HAL_TIM_PWM_Start() sets the main output enable
+     *       on advanced timers, which this clears again.
+     */
+    bool Configure(std::uint8_t dead_time);
+
+    /**
+     * @brief Connects the outputs to the pins (sets MOE).
+     */
+    void Enable() { handle_.Instance->BDTR |= TIM_BDTR_MOE; }
+
+    /**
+     * @brief Forces every output low (clears MOE); takes effect immediately.
+     * @note Safe from interrupts, e.g. an over-current trip.
+     */
+    void Disable() { handle_.Instance->BDTR &= ~TIM_BDTR_MOE; }
+
+    /**
+     * @brief Checks whether the outputs are enabled.
+     */
+    bool IsEnabled() const { return (handle_.Instance->BDTR & TIM_BDTR_MOE) != 0; }
+
+    /**
+     * @brief Sets the duty of all three channels for the same period.
+     * @param duty1..duty3 Compare values: 0 keeps CHx low all period, GetPeriod() or more keeps it high.
+     *
+     * Update events are held off (CR1 UDIS) while the compares are written, so
+     * the next period gets all three new values or, if the update fell inside
+     * the window, keeps all three old ones for one more period. Register writes
+     * only, no HAL calls: cheap enough for the control interrupt.
+     */
+    void SetDuties(std::uint32_t duty1, std::uint32_t duty2, std::uint32_t duty3) {
+        TIM_TypeDef* const tim = handle_.Instance;
+        tim->CR1 |= TIM_CR1_UDIS;
+        tim->CCR1 = duty1;
+        tim->CCR2 = duty2;
+        tim->CCR3 = duty3;
+        tim->CR1 &= ~TIM_CR1_UDIS;
+    }
+
+    /**
+     * @brief Sets the duty of one channel (from the next update event).
+     * @param channel Channel index, 0..kChannels - 1 (CH1..CH3); others are ignored.
+     * @param duty    Compare value, as for SetDuties().
+     */
+    void SetDuty(std::size_t channel, std::uint32_t duty) {
+        if (channel < kChannels) {
+            (&handle_.Instance->CCR1)[channel] = duty;
+        }
+    }
+
+    /**
+     * @brief Gets the auto-reload value (the compare for 100% duty).
+     */
+    std::uint32_t GetPeriod() const { return handle_.Instance->ARR; }
+
+private:
+    TIM_HandleTypeDef& handle_;
+};
+
+}  // namespace hal
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstdint>
+#include <expected>
+
+#include "util/error_codes.hpp"
+
+namespace hal {
+
+/**
+ * @brief Worst-case delay from an external trigger to the start of sampling, in half ADC cycles.
+ * @note Datasheet t_LATR with the asynchronous ADC clock is 2-3 cycles; 2.5 splits the difference.
+ */
+inline constexpr std::uint32_t kAdcTriggerLatencyHalfCycles = 5;
+
+/**
+ * @brief Conversion time after sampling at 12-bit resolution (12.5 cycles), in half ADC cycles.
+ */
+inline constexpr std::uint32_t kAdcConversionHalfCycles = 25;
+
+/**
+ * @brief Gets the length of a HAL sampling time in half ADC cycles.
+ * @param sampling_time HAL constant (e.g., ADC_SAMPLETIME_24CYCLES_5).
+ * @return Half cycles, or 0 for an unknown constant.
+ */
+constexpr std::uint32_t AdcSamplingHalfCycles(std::uint32_t sampling_time) {
+    switch (sampling_time) {
+        case ADC_SAMPLETIME_2CYCLES_5: return 5;
+        case ADC_SAMPLETIME_6CYCLES_5: return 13;
+        case ADC_SAMPLETIME_12CYCLES_5: return 25;
+        case ADC_SAMPLETIME_24CYCLES_5: return 49;
+        case ADC_SAMPLETIME_47CYCLES_5: return 95;
+        case ADC_SAMPLETIME_92CYCLES_5: return 185;
+        case ADC_SAMPLETIME_247CYCLES_5: return 495;
+        case ADC_SAMPLETIME_640CYCLES_5: return 1281;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Clocks and ADC settings that decide where a PWM-triggered conversion samples.
+ */
+struct PwmSyncConfig {
+    std::uint32_t timer_hz;       ///< Timer kernel clock (APB2 timer clock for TIM1)
+    std::uint32_t pwm_hz;         ///< PWM switching frequency
+    std::uint32_t adc_hz;         ///< ADC conversion clock (after the ADC prescaler)
+    std::uint32_t sampling_time;  ///< HAL sampling time of the triggered conversions
+};
+
+/**
+ * @brief Centre-aligned timer settings for one PWM frequency.
+ */
+struct PwmSyncTiming {
+    std::uint32_t period;           ///< Auto-reload value; one PWM period is 2 * period timer ticks
+    std::uint32_t trigger_compare;  ///< Trigger channel compare: ticks before the period centre
+};
+
+/**
+ * @brief Computes timer settings that centre ADC sampling on the PWM period centre.
+ * @param config Clocks and sampling time.
+ * @return Timing, or awb::Error::InvalidParam if the period does not fit the 16-bit
+ *         timer, the sampling window is longer than half a period, or a conversion
+ *         would not finish before the next trigger.
+ *
+ * In centre-aligned mode the counter runs 0 -> period -> 0, and every PWM pulse is
+ * symmetric about the valley (counter = 0), the point furthest from both switching
+ * edges. The trigger fires trigger_compare ticks before the valley, early enough
+ * to cover the trigger latency plus half the sampling window, so the middle of
+ * the sampling window lands on the valley.
+ */
+constexpr std::expected<PwmSyncTiming, awb::Error> ComputePwmSyncTiming(const PwmSyncConfig& config) {
+    const std::uint64_t sample_half_cycles = AdcSamplingHalfCycles(config.sampling_time);
+    if (config.timer_hz == 0 || config.pwm_hz == 0 || config.adc_hz == 0 || sample_half_cycles == 0) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    // Up and down counting: one PWM period is 2 * period ticks (rounded to nearest)
+    const std::uint64_t period = (config.timer_hz + config.pwm_hz) / (2ULL * config.pwm_hz);
+    if (period < 2 || period > 0xFFFF) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    // Latency plus half the sampling window, in quarter ADC cycles, then in timer ticks
+    const std::uint64_t lead_quarter_cycles = 2ULL * kAdcTriggerLatencyHalfCycles + sample_half_cycles;
+    std::uint64_t lead = (config.timer_hz * lead_quarter_cycles + 2ULL * config.adc_hz) / (4ULL * config.adc_hz);
+    lead = (lead == 0) ? 1 : lead;  // A compare of 0 never triggers
+    if (lead >= period) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    // The ADC ignores triggers while converting, so each conversion must end within one period
+    const std::uint64_t conversion_half_cycles =
+        kAdcTriggerLatencyHalfCycles + sample_half_cycles + kAdcConversionHalfCycles;
+    const std::uint64_t conversion_ticks = (config.timer_hz * conversion_half_cycles) / (2ULL * config.adc_hz);
+    if (conversion_ticks >= 2ULL * period) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    return PwmSyncTiming{static_cast<std::uint32_t>(period), static_cast<std::uint32_t>(lead)};
+}
+
+/**
+ * @class PwmSync
+ * @brief Centre-aligned PWM timebase that triggers the ADC once per period.
+ *
+ * Channel 4 of an advanced timer is the trigger source. In PWM mode 1 its
+ * reference rises trigger_compare ticks before every counter valley and reaches
+ * the ADC through TRGO2 (CubeMX: MasterOutputTrigger2 = TIM_TRGO2_OC4REF, no pin).
+ * Pair with Adc::ConfigureTrigger(ADC_EXTERNALTRIG_T1_TRGO2) so every conversion
+ * samples at the same quiet point of the PWM period.
+ */
+class PwmSync {
+public:
+    /**
+     * @param handle Reference to the HAL-generated handle of a centre-aligned timer (e.g., htim1).
+     */
+    explicit PwmSync(TIM_HandleTypeDef& handle) : handle_(handle) {}
+
+    // Delete copy/move to prevent handle duplication
+    PwmSync(const PwmSync&) = delete;
+    PwmSync& operator=(const PwmSync&) = delete;
+
+    /**
+     * @brief Programs the period and trigger point and starts the timer.
+     * @param timing Settings from ComputePwmSyncTiming().
+     * @return true if started; false if the timer is not in a centre-aligned mode.
+     */
+    bool Start(const PwmSyncTiming& timing);
+
+    /**
+     * @brief Stops the timer (and with it the ADC triggers).
+     */
+    void Stop();
+
+    /**
+     * @brief Gets the auto-reload value in use (half a PWM period, in timer ticks).
+     */
+    std::uint32_t GetPeriod() const { return timing_.period; }
+
+private:
+    TIM_HandleTypeDef& handle_;
+    PwmSyncTiming timing_{};
+};
+
+}  // namespace hal
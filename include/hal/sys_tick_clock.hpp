@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstdint>
+
+namespace hal {
+
+/**
+ * @brief Scheduler clock policy backed by the HAL SysTick and the DWT cycle counter.
+ *
+ * Ticks are the milliseconds counted by HAL_GetTick(). Cycles come from DWT->CYCCNT,
+ * which must be enabled once with Init(); the position inside the current tick comes
+ * from the SysTick down-counter, which runs at the core clock. Idle() sleeps with WFI; the SysTick
+ * interrupt wakes the core on the next tick, so the max_ticks hint is not needed.
+ */
+struct SysTickClock {
+    /**
+     * @brief Enables the DWT cycle counter.
+     */
+    static void Init() {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    static uint32_t Now() { return HAL_GetTick(); }
+    static uint32_t Cycles() { return DWT->CYCCNT; }
+    static uint32_t CyclesPerTick() { return SystemCoreClock / 1000U; }
+    static uint32_t CyclesIntoTick() { return SysTick->LOAD - SysTick->VAL; }
+    static void Idle(uint32_t /*max_ticks*/) { __WFI(); }
+};
+
+}  // namespace hal
@@ -2,21 +2,70 @@
 
 #include <stm32l4xx_hal.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "util/ring_buffer.hpp"
+
 namespace hal {
 
+/**
+ * @brief Transmit strategy used by Uart::Write().
+ */
+enum class UartMode : std::uint8_t {
+    Blocking,  ///< Write() waits in HAL_UART_Transmit until every byte is on the wire.
+    Dma        ///< Write() copies into a TX ring that is drained by DMA in the background.
+};
+
+/**
+ * @brief Receive counters of one Uart (see Uart::GetRxStats()).
+ */
+struct UartRxStats {
+    uint32_t frames = 0;          ///< Frames delivered to the frame handler
+    uint32_t bytes = 0;           ///< Bytes delivered in those frames
+    uint32_t truncated = 0;       ///< Frames longer than Uart::kRxFrameSize (the excess was dropped)
+    uint32_t overruns = 0;        ///< Receiver overruns: bytes lost before DMA could move them
+    uint32_t framing_errors = 0;  ///< Bytes with a bad stop bit (baud mismatch, line break)
+    uint32_t noise_errors = 0;    ///< Bytes with noise detected on the line
+    uint32_t parity_errors = 0;   ///< Bytes with a parity mismatch
+};
+
 class Uart final {
 public:
     /**
-     * @brief Construct a UART wrapper using the provided configuration.
-     * @param config Configuration for the underlying HAL UART peripheral.
-     * @note This constructor only stores configuration; call Init() before use.
+     * @brief Size of the TX ring buffer used in UartMode::Dma, in bytes.
      */
-    explicit Uart(const UART_HandleTypeDef& huart) : huart_(huart) {}
+    static constexpr std::size_t kTxBufferSize = 512;
+
+    /**
+     * @brief Longest frame StartReceive() delivers, in bytes.
+     */
+    static constexpr std::size_t kRxFrameSize = 128;
+
+    /**
+     * @brief Construct a UART wrapper around a HAL-generated handle.
+     * @param huart Reference to the HAL UART handle (e.g., huart2).
+     * @param mode  Transmit strategy. UartMode::Dma requires a TX DMA channel
+     *              linked to the handle (hdmatx); until one is linked, Write() blocks.
+     */
+    explicit Uart(UART_HandleTypeDef& huart, UartMode mode = UartMode::Blocking);
+
+    /**
+     * @brief Aborts any DMA transfer and reception, and stops receiving the HAL callbacks.
+     */
+    ~Uart();
+
+    // Delete copy/move: the DMA callbacks hold a pointer to this object
+    Uart(const Uart&) = delete;
+    Uart& operator=(const Uart&) = delete;
 
     /**
      * @brief Generic write function.
      * @param data Pointer to raw byte buffer.
      * @param len  Number of bytes to send.
+     * @note In UartMode::Dma this returns as soon as the bytes are queued. Bytes
+     *       that do not fit in the ring are dropped and counted (see GetDroppedBytes()).
      */
     void Write(const uint8_t* data, size_t len);
 
@@ -26,18 +75,120 @@ public:
      * @param len    Maximum number of bytes to read.
      * @param timeout Timeout in milliseconds to wait for data.
      * @return true if the expected number of bytes was received within timeout; false otherwise.
+     * @note Blocks the caller; fails while StartReceive() owns the receiver.
      */
     bool Read(uint8_t* buffer, size_t len, uint32_t timeout);
 
+    /**
+     * @brief Starts background reception, delivering each frame as the line goes idle.
+     * @param buffer   Circular DMA ring the receiver writes into; must outlive reception.
+     * @param length   Ring size in bytes (2..65535).
+     * @param on_frame Called from the UART/DMA interrupt with each frame (valid only
+     *                 during the call; copy what you keep).
+     * @param context  Passed back to on_frame.
+     * @return true if started; false without a circular RX DMA channel (hdmarx) or on bad arguments.
+     *
+     * The receiver runs on circular DMA with idle-line detection, so there is no
+     * per-byte interrupt: the CPU only wakes at the ring's half and end and when the
+     * line has been idle for one character time, which marks the end of a frame
+     * (e.g. one line typed into a terminal or one packet from a host). Bytes are
+     * copied out of the ring at each of those events, so frames may be longer than
+     * the ring; the ring only has to cover the interrupt latency.
+     * Errors are counted (GetRxStats()). Any receive error (overrun, framing, noise or
+     * parity) makes the HAL abort the DMA, so reception restarts and drops the partial frame.
+     * @note A frame that ends exactly at the end of the ring is delivered together with
+     *       the next one: the HAL reports no idle event at position 0.
+     */
+    bool StartReceive(uint8_t* buffer, size_t length,
+                      void (*on_frame)(void* context, const uint8_t* frame, size_t length), void* context);
+
+    /**
+     * @brief Stops background reception (a partial frame is dropped).
+     */
+    void StopReceive();
+
+    /**
+     * @brief Gets the receive counters.
+     * @return Running totals since construction.
+     */
+    UartRxStats GetRxStats() const;
+
+    /**
+     * @brief Waits until all queued TX bytes have been handed to the peripheral.
+     * @param timeout Timeout in milliseconds.
+     * @return true if the TX ring drained within timeout; false otherwise.
+     */
+    bool Flush(uint32_t timeout);
+
+    /**
+     * @brief Number of bytes discarded because the TX ring was full.
+     * @return Running total since construction.
+     */
+    uint32_t GetDroppedBytes() const { return dropped_bytes_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the active transmit strategy.
+     * @return UartMode::Dma or UartMode::Blocking.
+     */
+    UartMode GetMode() const { return mode_; }
+
     /**
      * @brief Access the underlying HAL UART handle.
-     * @return Pointer to the internal UART_HandleTypeDef.
+     * @return Pointer to the HAL UART_HandleTypeDef.
      * @note Prefer using Write()/Read() for typical I/O operations.
      */
     UART_HandleTypeDef* GetHandle() { return &huart_; }
 
+    /**
+     * @brief Releases the first half of the in-flight DMA chunk back to the ring.
+     * @note Called from HAL_UART_TxHalfCpltCallback; not for application use.
+     */
+    void OnTxHalfComplete();
+
+    /**
+     * @brief Releases the in-flight DMA chunk and chains the next one.
+     * @note Called from HAL_UART_TxCpltCallback; not for application use.
+     */
+    void OnTxComplete();
+
+    /**
+     * @brief Copies newly received bytes out of the RX ring; delivers the frame on idle.
+     * @param position Ring offset DMA has written up to.
+     * @param idle     true if the line went idle (end of frame).
+     * @note Called from HAL_UARTEx_RxEventCallback; not for application use.
+     */
+    void OnRxEvent(size_t position, bool idle);
+
+    /**
+     * @brief Counts receive errors and restarts reception if the HAL aborted it.
+     * @note Called from HAL_UART_ErrorCallback; not for application use.
+     */
+    void OnError();
+
 private:
-    UART_HandleTypeDef huart_{};
+    UART_HandleTypeDef& huart_;
+    UartMode mode_;
+
+    awb::RingBuffer<uint8_t, kTxBufferSize> tx_ring_;
+    volatile std::size_t tx_in_flight_ = 0;  // bytes handed to the current DMA transfer
+    volatile std::size_t tx_released_ = 0;   // bytes of that transfer already consumed at half-complete
+    std::atomic<uint32_t> dropped_bytes_{0};
+
+    // Reception state; after StartReceive() only the UART/DMA interrupts touch it
+    uint8_t* rx_buffer_ = nullptr;
+    size_t rx_length_ = 0;
+    size_t rx_tail_ = 0;  // Ring offset of the first byte not yet copied into frame_
+    void (*on_frame_)(void* context, const uint8_t* frame, size_t length) = nullptr;
+    void* frame_context_ = nullptr;
+    uint8_t frame_[kRxFrameSize];
+    size_t frame_length_ = 0;
+    bool frame_truncated_ = false;
+    UartRxStats rx_stats_;
+
+    bool IsDmaMode() const { return mode_ == UartMode::Dma && huart_.hdmatx != nullptr; }
+    void StartNextTransfer();
+    bool RestartReceive();
+    void AppendToFrame(const uint8_t* data, size_t len);
 };
 
 }  // namespace hal
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef AWB_SIM_HAL
+#include <chrono>
+#else
+#include "hal/sys_tick_clock.hpp"
+#endif
+
+class Logger;
+
+namespace awb {
+
+/**
+ * @brief Time source for benchmarks.
+ *
+ * On target this is the DWT cycle counter. The host simulation has no meaningful
+ * cycle count (its DWT only moves with simulated time), so it falls back to
+ * std::chrono::steady_clock in nanoseconds. kUnit is reported with every result.
+ */
+struct BenchClock {
+#ifdef AWB_SIM_HAL
+    static constexpr const char* kUnit = "ns";
+
+    static void Init() {}
+    static uint32_t Now() {
+        const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+#else
+    static constexpr const char* kUnit = "cycles";
+
+    static void Init() { hal::SysTickClock::Init(); }
+    static uint32_t Now() { return hal::SysTickClock::Cycles(); }
+#endif
+};
+
+/**
+ * @brief Optional hooks around a benchmark; none of them is timed.
+ */
+struct BenchFixture {
+    void (*setup)();        ///< Once, before the first iteration
+    void (*before_each)();  ///< Before every iteration (e.g. re-arm a pending flag)
+    void (*teardown)();     ///< Once, after the last iteration
+};
+
+/**
+ * @brief Summary of one benchmark run, in BenchClock units.
+ */
+struct BenchResult {
+    uint32_t iterations = 0;
+    uint32_t min = 0;
+    uint32_t median = 0;
+    uint32_t max = 0;
+};
+
+/**
+ * @class Benchmark
+ * @brief A named, self-registering microbenchmark.
+ *
+ * Instances are normally created with AWB_BENCHMARK() / AWB_BENCHMARK_F() at
+ * namespace scope; the constructor links them into a global list, so no heap or
+ * central table is needed. Each iteration times one call of the body, minus the
+ * measured cost of timing an empty body.
+ */
+class Benchmark {
+public:
+    /**
+     * @brief Upper bound on iterations per benchmark (samples are kept for the median).
+     */
+    static constexpr std::size_t kMaxIterations = 64;
+
+    /**
+     * @brief Registers a benchmark.
+     * @param name    Label used in the report; must not contain commas.
+     * @param body    Code under test, called once per iteration.
+     * @param fixture Optional untimed hooks.
+     */
+    Benchmark(const char* name, void (*body)(), const BenchFixture& fixture = {});
+
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    /**
+     * @brief Runs the benchmark.
+     * @param iterations Number of timed calls (clamped to 1..kMaxIterations).
+     * @return min/median/max over all iterations.
+     */
+    BenchResult Run(uint32_t iterations) const;
+
+    const char* GetName() const { return name_; }
+
+    /**
+     * @brief Gets the first registered benchmark (registration order within a file).
+     */
+    static const Benchmark* First() { return head_; }
+    const Benchmark* Next() const { return next_; }
+
+private:
+    const char* name_;
+    void (*body_)();
+    BenchFixture fixture_;
+    const Benchmark* next_ = nullptr;
+
+    // Constant-initialized, so registration from any translation unit's static
+    // constructors is safe regardless of initialization order
+    static inline Benchmark* head_ = nullptr;
+    static inline Benchmark* tail_ = nullptr;
+};
+
+/**
+ * @brief Runs every registered benchmark and reports the results through the Logger.
+ * @param logger     Destination for the report.
+ * @param iterations Timed calls per benchmark.
+ * @return Number of benchmarks run.
+ *
+ * The report is one CSV line per benchmark, prefixed so it can be picked out of
+ * other console output (see tools/bench_compare.py):
+ * @code
+ * BENCH,name,unit,iterations,min,median,max
+ * BENCH,FastGpioToggle,cycles,32,6,6,9
+ * @endcode
+ */
+std::size_t RunBenchmarks(Logger& logger, uint32_t iterations = 32);
+
+/**
+ * @brief Keeps the compiler from discarding a value computed by a benchmark body.
+ */
+template <typename T>
+[[gnu::always_inline]]
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace awb
+
+/**
+ * @brief Defines and registers a benchmark.
+ * @code
+ * AWB_BENCHMARK(RingBufferPush16) {
+ *     awb::DoNotOptimize(ring.Push(block, 16));
+ * }
+ * @endcode
+ */
+#define AWB_BENCHMARK(name) AWB_BENCHMARK_F(name, {})
+
+/**
+ * @brief Defines and registers a benchmark with a BenchFixture.
+ */
+#define AWB_BENCHMARK_F(name, ...)                                                        \
+    static void AwbBench_##name();                                                        \
+    static const ::awb::Benchmark awb_bench_##name(#name, &AwbBench_##name, __VA_ARGS__); \
+    static void AwbBench_##name()
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace awb {
+
+/**
+ * @brief Largest COBS encoding of a message (one overhead byte per 254 bytes, at least one).
+ * @param length Message length in bytes.
+ */
+constexpr std::size_t CobsMaxEncodedSize(std::size_t length) {
+    return length + length / 254 + 1;
+}
+
+/**
+ * @brief COBS-encodes a message so that it contains no zero bytes.
+ * @param in     Message.
+ * @param length Message length in bytes.
+ * @param out    Encoded bytes; room for CobsMaxEncodedSize(length).
+ * @return Encoded length.
+ *
+ * Consistent Overhead Byte Stuffing replaces every zero with the distance to the
+ * next one, so a zero byte can delimit frames unambiguously and a receiver that
+ * joins mid-stream resynchronises at the next delimiter.
+ */
+constexpr std::size_t CobsEncode(const std::uint8_t* in, std::size_t length, std::uint8_t* out) {
+    std::size_t code_index = 0;  // Where the current block's length byte goes
+    std::size_t out_index = 1;
+    std::uint8_t code = 1;
+    for (std::size_t i = 0; i < length; ++i) {
+        if (in[i] != 0) {
+            out[out_index++] = in[i];
+            ++code;
+        }
+        // A zero ends the block; so does reaching the longest block (254 data bytes)
+        if (in[i] == 0 || code == 0xFF) {
+            out[code_index] = code;
+            code_index = out_index++;
+            code = 1;
+        }
+    }
+    out[code_index] = code;
+    return out_index;
+}
+
+}  // namespace awb
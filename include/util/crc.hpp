@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace awb {
+
+/**
+ * @brief CRC-32 (IEEE 802.3: reflected, polynomial 0xEDB88320, init and final XOR 0xFFFFFFFF).
+ * @param data   Bytes to check.
+ * @param length Number of bytes.
+ * @return CRC; "123456789" gives 0xCBF43926.
+ * @note Bitwise (no table): meant for small records such as flash-stored calibration.
+ */
+constexpr std::uint32_t Crc32(const std::uint8_t* data, std::size_t length) {
+    std::uint32_t crc = 0xFFFF'FFFFU;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB8'8320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polynomial 0x1021, init 0xFFFF, not reflected, no final XOR).
+ * @param data   Bytes to check.
+ * @param length Number of bytes.
+ * @return CRC; "123456789" gives 0x29B1.
+ * @note Bitwise (no table): meant for short packets such as telemetry frames.
+ */
+constexpr std::uint16_t Crc16(const std::uint8_t* data, std::size_t length) {
+    std::uint16_t crc = 0xFFFF;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= static_cast<std::uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<std::uint16_t>((crc & 0x8000U) ? (crc << 1) ^ 0x1021U : crc << 1);
+        }
+    }
+    return crc;
+}
+
+}  // namespace awb
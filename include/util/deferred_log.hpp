@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "util/logger.hpp"
+
+/**
+ * Deferred ("defmt-style") logging.
+ *
+ * With AWB_LOG_DEFERRED defined, AWB_LOGF() does not format anything on the
+ * target. Each call site's format string is placed in the `.awb_log_fmt`
+ * linker section, which is never loaded into flash; the string's offset in
+ * that section is its ID. The target emits a small binary frame:
+ *
+ *   [0xFF marker][ID lo][ID hi][payload length][payload ...]
+ *
+ * where the payload is the raw argument bytes (little-endian):
+ *   - integers/enums up to 32 bits  -> 4 bytes (64-bit integers -> 8 bytes)
+ *   - float/double                  -> 8 bytes (double)
+ *   - pointers                      -> 4 bytes
+ *   - C strings                     -> 1 length byte + characters
+ *
+ * tools/log_decoder.py reads the section back out of the ELF and turns the
+ * frames into text. 0xFF never appears in ASCII, so text written through the
+ * regular Logger API can share the same stream.
+ *
+ * Without AWB_LOG_DEFERRED, AWB_LOGF() is plain Logger::Logf().
+ */
+
+namespace awb::deflog {
+
+inline constexpr std::uint8_t kFrameMarker = 0xFF;
+inline constexpr std::size_t kHeaderSize = 4;
+inline constexpr std::size_t kMaxFrameSize = 64;
+
+/**
+ * @class Frame
+ * @brief Fixed-size builder for one deferred log frame.
+ */
+class Frame {
+public:
+    /**
+     * @brief Starts a frame for the given format string ID.
+     * @param id Offset of the format string in the `.awb_log_fmt` section.
+     */
+    explicit Frame(std::uintptr_t id) {
+        data_[0] = kFrameMarker;
+        data_[1] = static_cast<std::uint8_t>(id);
+        data_[2] = static_cast<std::uint8_t>(id >> 8);
+    }
+
+    /**
+     * @brief Appends one argument using the wire encoding described above.
+     * @param value The argument (arrays are expected to have decayed to pointers).
+     * @note Arguments that do not fit are dropped; the decoder marks the line as truncated.
+     */
+    template <typename T>
+    void Append(T value) {
+        if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            AppendString(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            AppendRaw(static_cast<double>(value));
+        } else if constexpr (std::is_pointer_v<T>) {
+            AppendRaw(static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(value)));
+        } else if constexpr (std::is_enum_v<T>) {
+            AppendRaw(static_cast<std::int32_t>(value));
+        } else if constexpr (sizeof(T) <= 4) {
+            AppendRaw(static_cast<std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>>(value));
+        } else {
+            AppendRaw(static_cast<std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>(value));
+        }
+    }
+
+    const char* Data() {
+        data_[3] = static_cast<std::uint8_t>(size_ - kHeaderSize);
+        return reinterpret_cast<const char*>(data_);
+    }
+    std::size_t Size() const { return size_; }
+
+private:
+    std::uint8_t data_[kMaxFrameSize];
+    std::size_t size_ = kHeaderSize;
+
+    template <typename T>
+    void AppendRaw(const T value) {
+        if (size_ + sizeof(T) > kMaxFrameSize) return;
+        std::memcpy(&data_[size_], &value, sizeof(T));
+        size_ += sizeof(T);
+    }
+
+    void AppendString(const char* str) {
+        if (size_ >= kMaxFrameSize) return;
+        const std::size_t room = kMaxFrameSize - size_ - 1;
+        std::size_t len = (str != nullptr) ? std::strlen(str) : 0;
+        if (len > room) len = room;
+        data_[size_++] = static_cast<std::uint8_t>(len);
+        std::memcpy(&data_[size_], str, len);
+        size_ += len;
+    }
+};
+
+/**
+ * @brief Encodes and transmits one deferred log record.
+ * @param logger Logger whose transport receives the frame.
+ * @param format Format string placed in the `.awb_log_fmt` section.
+ * @param args   Arguments matching the format string.
+ */
+template <typename... Args>
+void Emit(Logger& logger, const char* format, Args... args) {
+    Frame frame(reinterpret_cast<std::uintptr_t>(format));
+    (frame.Append(args), ...);
+    const char* data = frame.Data();
+    logger.Write(data, frame.Size());
+}
+
+}  // namespace awb::deflog
+
+#if defined(AWB_LOG_DEFERRED)
+// The dead Logf() call keeps -Wformat checking the arguments against the string
+#define AWB_LOGF(fmt, ...)                                                                  \
+    do {                                                                                    \
+        [[gnu::section(".awb_log_fmt"), gnu::used]] static const char awb_log_fmt_[] = fmt; \
+        if (false) Logger::GetInstance().Logf(fmt __VA_OPT__(, ) __VA_ARGS__);              \
+        awb::deflog::Emit(Logger::GetInstance(), awb_log_fmt_ __VA_OPT__(, ) __VA_ARGS__);  \
+    } while (0)
+#else
+#define AWB_LOGF(fmt, ...) Logger::GetInstance().Logf(fmt __VA_OPT__(, ) __VA_ARGS__)
+#endif
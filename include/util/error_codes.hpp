@@ -11,6 +11,7 @@ enum class Error : std::uint8_t {
     Busy,
     InvalidParam,
     DmaFailure,
+    FlashFailure,
     AdcConversionFailed,
 
     NotCalibrated,
@@ -28,6 +29,7 @@ constexpr const char* ToString(const Error e) {
         case Error::Busy:                return "Busy";
         case Error::InvalidParam:        return "Invalid Param";
         case Error::DmaFailure:          return "DMA Failure";
+        case Error::FlashFailure:        return "Flash Failure";
         case Error::AdcConversionFailed: return "ADC Failed";
         case Error::NotCalibrated:       return "Not Calibrated";
         case Error::TargetUnreachable:   return "Target Unreachable";
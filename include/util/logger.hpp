@@ -25,11 +25,18 @@ public:
      */
     void Init(hal::Uart* uart);
 
+    /**
+     * @brief  Gets the transport passed to Init().
+     * @return Pointer to the UART driver, or nullptr before Init().
+     */
+    hal::Uart* GetTransport() const { return transport_; }
+
     /**
      * @brief  Transmits raw data over UART.
      * @param  data   Pointer to the data buffer to send.
      * @param  length Number of bytes to transmit.
-     * @note   This is a blocking call using HAL_UART_Transmit.
+     * @note   Blocks only if the transport is in hal::UartMode::Blocking;
+     *         in hal::UartMode::Dma the bytes are queued and sent in the background.
      */
     void Write(const char* data, size_t length);
 
@@ -0,0 +1,416 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "util/error_codes.hpp"
+
+namespace awb {
+
+/**
+ * @brief Kinematic limits of a move, in encoder counts and seconds.
+ */
+struct MotionLimits {
+    float velocity;                          ///< Cruise speed, counts/s (> 0)
+    float acceleration;                      ///< counts/s^2 (> 0)
+    float jerk = 0;                          ///< counts/s^3; 0 for a trapezoidal profile
+    std::int32_t min_position = -(1 << 30);  ///< Travel range: MoveTo() refuses targets outside it
+    std::int32_t max_position = 1 << 30;
+};
+
+/**
+ * @brief Where the profile wants the axis on this tick.
+ */
+struct MotionSetpoint {
+    std::int32_t position;      ///< counts
+    std::int32_t velocity;      ///< counts/s (feed-forward)
+    std::int32_t acceleration;  ///< counts/s^2 (feed-forward)
+};
+
+namespace detail {
+
+// Planning-only helpers (constexpr, like the planner that uses them)
+constexpr std::int64_t CeilToInt(double x) {
+    const auto i = static_cast<std::int64_t>(x);
+    return (static_cast<double>(i) < x) ? i + 1 : i;
+}
+
+constexpr std::int64_t RoundToInt(double x) {
+    return static_cast<std::int64_t>(x < 0 ? x - 0.5 : x + 0.5);
+}
+
+constexpr double Sqrt(double x) {
+    if (x <= 0) {
+        return 0;
+    }
+    if !consteval {
+        return std::sqrt(x);
+    }
+    double r = (x > 1) ? x : 1;
+    for (int i = 0; i < 64; ++i) {
+        const double next = 0.5 * (r + x / r);
+        if (next >= r) {
+            break;
+        }
+        r = next;
+    }
+    return r;
+}
+
+/**
+ * @brief Tick counts of one velocity-change block: jerk ramps of n1 ticks either side
+ *        of n2 ticks of constant acceleration.
+ *
+ * With jerk J the block changes the velocity by J * Gain() and, on top of the
+ * starting velocity times Ticks(), moves J * Reach(); both sums are exact integers.
+ */
+struct MotionBlock {
+    std::int64_t n1;
+    std::int64_t n2;
+
+    constexpr std::int64_t Ticks() const { return 2 * n1 + n2; }
+
+    // Sum of the acceleration over the block
+    constexpr std::int64_t Gain() const { return n1 * (n1 + n2); }
+
+    // Sum of the velocity gained so far, over the block
+    constexpr std::int64_t Reach() const {
+        const std::int64_t t = Ticks();
+        const std::int64_t ramp_up = (t + 1) * n1 * (n1 + 1) / 2 - n1 * (n1 + 1) * (2 * n1 + 1) / 6;
+        const std::int64_t plateau = n1 * (n2 * (t + 1) - n2 * (2 * n1 + n2 + 1) / 2);
+        const std::int64_t ramp_down = (n1 - 1) * n1 * (2 * n1 - 1) / 6 + (n1 - 1) * n1 / 2;
+        return ramp_up + plateau + ramp_down;
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @class MotionProfile
+ * @brief Jerk-limited (S-curve) or trapezoidal point-to-point moves, one setpoint per control tick.
+ *
+ * A move is planned as a list of segments of constant jerk: an acceleration
+ * block (jerk +J, 0, -J), a cruise, and a deceleration block (-J, 0, +J).
+ * Step() integrates jerk -> acceleration -> velocity -> position in fixed point
+ * (positions 32.32, rates with 48 fraction bits), so every tick costs three
+ * 64-bit adds, a shift and no divisions; all the division and square-root work
+ * is done once, by MoveTo().
+ *
+ * Segment lengths are whole ticks, and the block jerks are solved so the
+ * discrete sums land on the target. Rounding the jerks to 2^-48 leaves the
+ * integrators slightly off the plan, so they are snapped to the exact planned
+ * velocity at each segment end and to the target at the end of the move. The
+ * snaps are far below one count: the error grows with the cube of the ramp
+ * length, to a few hundredths of a count for ramps of seconds at 20 kHz.
+ *
+ * MoveTo() may be called mid-move. From cruise or rest the new plan starts at
+ * once; inside an acceleration or deceleration block (acceleration != 0) that
+ * block is finished first, so acceleration never steps. If the new target is
+ * behind the axis or closer than its stopping distance, the plan stops first
+ * and then moves back. (Rarely, when the target is only just beyond the stopping
+ * distance and no whole-tick plan reaches it at speed within the limits, the
+ * plan also stops first, short of it, and creeps the rest of the way.)
+ *
+ * Not thread-safe: call MoveTo() and Step() from the same context (e.g., both in
+ * the control loop, or with the control interrupt masked around MoveTo()).
+ */
+class MotionProfile {
+public:
+    static constexpr unsigned kFractionBits = 32;      ///< Position
+    static constexpr unsigned kRateFractionBits = 48;  ///< Velocity, acceleration, jerk: up to 32767 counts/tick
+    static constexpr std::size_t kMaxSegments = 13;    ///< Rest of a block + stop block + a full move
+
+    /**
+     * @param tick_hz Rate Step() is called at.
+     * @param limits  Speed, acceleration and jerk limits and the travel range.
+     */
+    constexpr MotionProfile(std::uint32_t tick_hz, const MotionLimits& limits)
+        : tick_hz_(tick_hz), tick_hz_squared_(static_cast<std::int64_t>(tick_hz) * tick_hz), limits_(limits) {}
+
+    /**
+     * @brief Plans a move to a new target, from wherever the axis is heading now.
+     * @param target Position in counts.
+     * @return Nothing on success; awb::Error::TargetUnreachable if the target is outside the
+     *         travel range, awb::Error::InvalidParam if the limits are unusable.
+     * @note Costs a few thousand double-precision operations (software on a Cortex-M4; see the
+     *       MotionProfileMoveTo benchmark): keep it out of the control interrupt.
+     */
+    constexpr std::expected<void, awb::Error> MoveTo(std::int32_t target) {
+        if (tick_hz_ == 0 || !(limits_.velocity > 0) || !(limits_.acceleration > 0) || !(limits_.jerk >= 0) ||
+            limits_.min_position >= limits_.max_position) {
+            return std::unexpected(awb::Error::InvalidParam);
+        }
+        if (target < limits_.min_position || target > limits_.max_position) {
+            return std::unexpected(awb::Error::TargetUnreachable);
+        }
+
+        std::array<Segment, kMaxSegments> plan{};
+        std::size_t count = 0;
+        std::int64_t position = position_;
+        std::int64_t velocity = velocity_;
+
+        // Inside a block: keep its remaining segments and plan from where it ends
+        if (acceleration_ != 0) {
+            std::int64_t acceleration = acceleration_;
+            for (std::size_t i = segment_; i < count_; ++i) {
+                const Segment& segment = segments_[i];
+                const std::uint32_t ticks = (i == segment_) ? remaining_ : segment.ticks;
+                plan[count] = segment;
+                plan[count++].ticks = ticks;
+                const double n = ticks;
+                const double travel = static_cast<double>(velocity) * n +
+                                      static_cast<double>(acceleration) * n * (n + 1) / 2 +
+                                      static_cast<double>(segment.jerk) * n * (n + 1) * (n + 2) / 6;
+                position += detail::RoundToInt(travel / kRateScale);
+                acceleration += segment.jerk * ticks;
+                velocity = segment.end_velocity;
+                if (segment.ends_block) {
+                    break;
+                }
+            }
+        }
+
+        const std::int64_t goal = static_cast<std::int64_t>(target) << kFractionBits;
+        if (!PlanFrom(position, velocity, goal, plan, count)) {
+            return std::unexpected(awb::Error::InvalidParam);
+        }
+
+        segments_ = plan;
+        count_ = count;
+        segment_ = 0;
+        remaining_ = (count > 0) ? plan[0].ticks : 0;
+        target_ = target;
+        if (count == 0) {
+            position_ = goal;
+        }
+        return {};
+    }
+
+    /**
+     * @brief Stops dead at a position (e.g., after homing), dropping any move.
+     */
+    constexpr void Reset(std::int32_t position) {
+        position_ = static_cast<std::int64_t>(position) << kFractionBits;
+        velocity_ = 0;
+        acceleration_ = 0;
+        count_ = 0;
+        segment_ = 0;
+        remaining_ = 0;
+        target_ = position;
+    }
+
+    /**
+     * @brief Advances one tick.
+     * @return The new setpoint.
+     */
+    constexpr MotionSetpoint Step() {
+        if (segment_ != count_) {
+            const Segment& segment = segments_[segment_];
+            acceleration_ += segment.jerk;
+            velocity_ += acceleration_;
+            position_ += velocity_ >> kRateShift;
+            if (--remaining_ == 0) {
+                velocity_ = segment.end_velocity;
+                if (++segment_ == count_) {
+                    position_ = static_cast<std::int64_t>(target_) << kFractionBits;
+                    velocity_ = 0;
+                    acceleration_ = 0;
+                } else {
+                    remaining_ = segments_[segment_].ticks;
+                }
+            }
+        }
+        return GetSetpoint();
+    }
+
+    /**
+     * @brief Gets the current setpoint without advancing.
+     */
+    constexpr MotionSetpoint GetSetpoint() const {
+        constexpr std::int64_t kHalf = std::int64_t{1} << (kFractionBits - 1);
+        return {static_cast<std::int32_t>((position_ + kHalf) >> kFractionBits),
+                static_cast<std::int32_t>(((velocity_ >> kRateShift) * tick_hz_ + kHalf) >> kFractionBits),
+                static_cast<std::int32_t>(((acceleration_ >> kRateShift) * tick_hz_squared_ + kHalf) >> kFractionBits)};
+    }
+
+    /**
+     * @brief Checks whether the last move has finished (the setpoint rests on the target).
+     */
+    constexpr bool IsDone() const { return segment_ == count_; }
+
+    /**
+     * @brief Gets the target of the last accepted MoveTo()/Reset().
+     */
+    constexpr std::int32_t GetTarget() const { return target_; }
+
+    /**
+     * @brief Gets the limits moves are planned with.
+     */
+    constexpr const MotionLimits& GetLimits() const { return limits_; }
+
+private:
+    static constexpr unsigned kRateShift = kRateFractionBits - kFractionBits;
+    static constexpr double kRateScale = static_cast<double>(std::int64_t{1} << kRateShift);
+
+    struct Segment {
+        std::int64_t jerk;          ///< Added to the acceleration every tick
+        std::int64_t end_velocity;  ///< Exact velocity at the end (the integrators snap to it)
+        std::uint32_t ticks;
+        bool ends_block;  ///< Acceleration is back to zero after this segment
+    };
+
+    // Shortest block that changes the velocity by delta (fixed point, per tick) within the limits
+    constexpr detail::MotionBlock ShapeBlock(double delta) const {
+        const double accel = AccelerationLimit();
+        const double jerk = JerkLimit();
+        std::int64_t n1 = 1;
+        if (jerk > 0) {
+            const double ramp = (delta * jerk >= accel * accel) ? accel / jerk : detail::Sqrt(delta / jerk);
+            n1 = (ramp > 1) ? detail::CeilToInt(ramp) : 1;
+        }
+        const double flat = delta / accel - static_cast<double>(n1);
+        return {n1, (flat > 0) ? detail::CeilToInt(flat) : 0};
+    }
+
+    // Distance to change the velocity from va to vb over a block (jerk solved to fit)
+    static constexpr double BlockDistance(const detail::MotionBlock& block, double va, double vb) {
+        return va * static_cast<double>(block.Ticks()) +
+               (vb - va) * static_cast<double>(block.Reach()) / static_cast<double>(block.Gain());
+    }
+
+    // Limits per tick, in rate fixed point
+    constexpr double Scale() const { return static_cast<double>(std::int64_t{1} << kRateFractionBits); }
+    constexpr double VelocityLimit() const { return limits_.velocity / static_cast<double>(tick_hz_) * Scale(); }
+    constexpr double AccelerationLimit() const {
+        return limits_.acceleration / static_cast<double>(tick_hz_squared_) * Scale();
+    }
+    constexpr double JerkLimit() const {
+        return limits_.jerk / static_cast<double>(tick_hz_squared_) / static_cast<double>(tick_hz_) * Scale();
+    }
+
+    // Appends a block taking the velocity from va to vb with jerk +/-jerk; returns false if too long
+    static constexpr bool AppendBlock(std::array<Segment, kMaxSegments>& plan, std::size_t& count,
+                                      const detail::MotionBlock& block, std::int64_t va, std::int64_t vb,
+                                      std::int64_t jerk) {
+        if (block.Ticks() > INT32_MAX || count + 3 > kMaxSegments) {
+            return false;
+        }
+        const std::int64_t ramp_end = va + jerk * (block.n1 * (block.n1 + 1) / 2);
+        plan[count++] = {jerk, ramp_end, static_cast<std::uint32_t>(block.n1), false};
+        if (block.n2 > 0) {
+            plan[count++] = {0, ramp_end + jerk * block.n1 * block.n2, static_cast<std::uint32_t>(block.n2), false};
+        }
+        plan[count++] = {-jerk, vb, static_cast<std::uint32_t>(block.n1), true};
+        return true;
+    }
+
+    // Position in 32.32, velocity in rate fixed point
+    constexpr bool PlanFrom(std::int64_t position, std::int64_t velocity, std::int64_t goal,
+                            std::array<Segment, kMaxSegments>& plan, std::size_t& count) const {
+        if (position == goal && velocity == 0) {
+            return true;
+        }
+        // Plan in the direction of travel, in rate units, so speeds and distances are positive
+        const std::int64_t direction = (goal > position || (goal == position && velocity < 0)) ? 1 : -1;
+        const double distance = static_cast<double>((goal - position) * direction) * kRateScale;
+        const double start = static_cast<double>(velocity * direction);
+
+        // Stops, then plans the rest of the way from rest
+        const detail::MotionBlock stop = ShapeBlock(start < 0 ? -start : start);
+        const auto stop_first = [&]() {
+            const auto jerk = detail::RoundToInt(-start / static_cast<double>(stop.Gain())) * direction;
+            if (velocity == 0 || !AppendBlock(plan, count, stop, velocity, 0, jerk)) {
+                return false;
+            }
+            const double travel = static_cast<double>(velocity) * static_cast<double>(stop.Ticks()) +
+                                  static_cast<double>(jerk) * static_cast<double>(stop.Reach());
+            return PlanFrom(position + detail::RoundToInt(travel / kRateScale), 0, goal, plan, count);
+        };
+        if (start < 0 || BlockDistance(stop, start, 0) > distance) {
+            // Moving away, or too close to stop in time
+            return stop_first();
+        }
+
+        // Fastest peak speed whose blocks fit the distance (a cruise takes up any slack)
+        const double max_speed = VelocityLimit();
+        const auto distance_at = [&](double peak) {
+            const double change = peak - start;
+            return BlockDistance(ShapeBlock(change < 0 ? -change : change), start, peak) +
+                   BlockDistance(ShapeBlock(peak), peak, 0);
+        };
+        double peak = max_speed;
+        if (distance_at(max_speed) > distance) {
+            double low = 0;
+            double high = max_speed;
+            for (int i = 0; i < 48; ++i) {
+                peak = 0.5 * (low + high);
+                if (distance_at(peak) > distance) {
+                    high = peak;
+                } else {
+                    low = peak;
+                }
+            }
+            peak = low;
+        }
+        const detail::MotionBlock slow_down = ShapeBlock(peak);
+        const double down_share = static_cast<double>(slow_down.Reach()) / static_cast<double>(slow_down.Gain());
+
+        // Whole ticks of cruise for the slack (rounded up), then the cruise speed that makes the whole-tick
+        // blocks and cruise cover the distance exactly. That speed sits just under the peak, so it may need a
+        // bigger change than the speed-change block was shaped for: reshape it for the actual change and plan
+        // again. From rest the first plan always fits; otherwise a longer block can eat the cruise and need a
+        // longer one still, so after a few tries stop first instead.
+        double change = (peak > start) ? peak - start : start - peak;
+        detail::MotionBlock speed_up{};
+        std::int64_t cruise = 0;
+        double speed = 0;
+        bool fits = false;
+        for (int i = 0; i < 4 && !fits; ++i) {
+            speed_up = ShapeBlock(change);
+            const double slack = distance - BlockDistance(speed_up, start, peak) - BlockDistance(slow_down, peak, 0);
+            cruise = (peak > 0 && slack > 0) ? detail::CeilToInt(slack / peak) : 0;
+            const double up_share = static_cast<double>(speed_up.Reach()) / static_cast<double>(speed_up.Gain());
+            speed = (distance - start * (static_cast<double>(speed_up.Ticks()) - up_share)) /
+                    (up_share + static_cast<double>(cruise + slow_down.Ticks()) - down_share);
+
+            const double actual = (speed > start) ? speed - start : start - speed;
+            const detail::MotionBlock needed = ShapeBlock(actual);
+            fits = speed >= 0 && needed.n1 <= speed_up.n1 && needed.n1 + needed.n2 <= speed_up.n1 + speed_up.n2;
+            change = actual;
+        }
+        if (!fits) {
+            return stop_first();
+        }
+        const std::int64_t cruise_velocity = detail::RoundToInt(speed) * direction;
+        const std::int64_t up_jerk = detail::RoundToInt((speed - start) / static_cast<double>(speed_up.Gain()));
+        const std::int64_t down_jerk = detail::RoundToInt(speed / static_cast<double>(slow_down.Gain()));
+
+        if (cruise > INT32_MAX || !AppendBlock(plan, count, speed_up, velocity, cruise_velocity, up_jerk * direction)) {
+            return false;
+        }
+        if (cruise > 0) {
+            plan[count++] = {0, cruise_velocity, static_cast<std::uint32_t>(cruise), false};
+        }
+        return AppendBlock(plan, count, slow_down, cruise_velocity, 0, -down_jerk * direction);
+    }
+
+    std::uint32_t tick_hz_;
+    std::int64_t tick_hz_squared_;
+    MotionLimits limits_;
+
+    // Position in 32.32 counts; velocity and acceleration per tick and tick^2 with kRateFractionBits
+    std::int64_t position_ = 0;
+    std::int64_t velocity_ = 0;
+    std::int64_t acceleration_ = 0;
+
+    std::array<Segment, kMaxSegments> segments_{};
+    std::size_t count_ = 0;
+    std::size_t segment_ = 0;
+    std::uint32_t remaining_ = 0;
+    std::int32_t target_ = 0;
+};
+
+}  // namespace awb
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+namespace awb {
+
+/**
+ * @class RingBuffer
+ * @brief Lock-free single-producer/single-consumer ring buffer.
+ * @tparam T        Element type (must be trivially copyable).
+ * @tparam Capacity Number of elements. Must be a power of two.
+ *
+ * One context (e.g. the main loop) calls Push(); exactly one other context
+ * (e.g. a DMA-complete ISR) calls PeekContiguous()/Consume(). The read side
+ * hands out contiguous spans so a DMA engine can read straight out of the
+ * storage without an intermediate copy.
+ */
+template <typename T, std::size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    static constexpr std::size_t kCapacity = Capacity;
+
+    /**
+     * @brief Copies as many elements as fit into the buffer.
+     * @param data Source elements.
+     * @param len  Number of elements to copy.
+     * @return Number of elements actually written (less than len if full).
+     * @note Producer side only.
+     */
+    std::size_t Push(const T* data, std::size_t len) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t count = std::min(len, Capacity - (head - tail));
+
+        const std::size_t offset = head & kMask;
+        const std::size_t first = std::min(count, Capacity - offset);
+        std::memcpy(&storage_[offset], data, first * sizeof(T));
+        std::memcpy(&storage_[0], data + first, (count - first) * sizeof(T));
+
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Copies up to len elements out of the buffer.
+     * @param out Destination buffer.
+     * @param len Maximum number of elements to read.
+     * @return Number of elements read.
+     * @note Consumer side only.
+     */
+    std::size_t Pop(T* out, std::size_t len) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t count = std::min(len, head - tail);
+
+        const std::size_t offset = tail & kMask;
+        const std::size_t first = std::min(count, Capacity - offset);
+        std::memcpy(out, &storage_[offset], first * sizeof(T));
+        std::memcpy(out + first, &storage_[0], (count - first) * sizeof(T));
+
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Returns the longest readable run that does not wrap.
+     * @return Span over the oldest unread elements (empty if none).
+     * @note Consumer side only. The span stays valid until Consume() is called.
+     */
+    std::span<const T> PeekContiguous() const {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t offset = tail & kMask;
+        return {&storage_[offset], std::min(head - tail, Capacity - offset)};
+    }
+
+    /**
+     * @brief Releases elements previously returned by PeekContiguous().
+     * @param len Number of elements to release.
+     * @note Consumer side only.
+     */
+    void Consume(std::size_t len) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        tail_.store(tail + len, std::memory_order_release);
+    }
+
+    std::size_t Size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+    std::size_t Free() const { return Capacity - Size(); }
+    bool Empty() const { return Size() == 0; }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    T storage_[Capacity]{};
+    // Free-running indices; unsigned wrap-around keeps (head - tail) correct.
+    std::atomic<std::size_t> head_{0};
+    std::atomic<std::size_t> tail_{0};
+};
+
+}  // namespace awb
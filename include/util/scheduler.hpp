@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace awb {
+
+/**
+ * @brief Static description of one periodic task.
+ */
+struct Task {
+    const char* name;       ///< Label used when reporting statistics
+    void (*run)();          ///< Task body; must return (cooperative)
+    uint32_t period_ticks;  ///< Release period in scheduler ticks (must be >= 1)
+    uint8_t priority;       ///< Lower runs first when several tasks are due on the same tick
+};
+
+/**
+ * @brief Runtime accounting for one task.
+ */
+struct TaskStats {
+    uint32_t runs = 0;                ///< Number of completed executions
+    uint32_t deadline_misses = 0;     ///< Releases skipped because the task started a full period late
+    uint32_t overruns = 0;            ///< Executions that took longer than one period
+    uint32_t last_cycles = 0;         ///< Execution time of the most recent run
+    uint32_t max_cycles = 0;          ///< Worst-case execution time observed
+    uint32_t max_latency_cycles = 0;  ///< Worst delay from the scheduled release to task start (jitter)
+};
+
+/**
+ * @class Scheduler
+ * @brief Fixed-rate, allocation-free cooperative scheduler.
+ * @tparam N     Number of tasks.
+ * @tparam Clock Time source policy providing:
+ *               - `static uint32_t Now()`           current tick count
+ *               - `static uint32_t Cycles()`        free-running cycle counter
+ *               - `static uint32_t CyclesPerTick()` cycles in one tick
+ *               - `static uint32_t CyclesIntoTick()` cycles since Now() last advanced
+ *               - `static void Idle(uint32_t max_ticks)` sleep until the next
+ *                 interrupt, or for at most max_ticks (advancing Now() accordingly)
+ *
+ * Tasks are fixed at compile time and run to completion in priority order on
+ * the tick they are due. A task that falls a whole period behind is not
+ * "caught up" in a burst; the missed releases are counted instead. Between
+ * ticks the core is idled via Clock::Idle(), which is told how long it may
+ * stay asleep before the next release (WFI or STOP2 on target). Latency is measured
+ * from the cycle at which the release tick began, so it includes time spent asleep
+ * past it, waking up and running higher-priority tasks. Because the clock
+ * is a template parameter, a host build can drive the scheduler with a
+ * simulated tick source.
+ */
+template <std::size_t N, typename Clock>
+class Scheduler {
+    static_assert(N > 0, "Scheduler needs at least one task");
+
+public:
+    /**
+     * @brief Builds the scheduler from a compile-time task table.
+     * @param tasks Task descriptions; sorted by priority internally.
+     */
+    constexpr explicit Scheduler(const std::array<Task, N>& tasks) : tasks_(tasks) {
+        std::stable_sort(tasks_.begin(), tasks_.end(),
+                         [](const Task& a, const Task& b) { return a.priority < b.priority; });
+    }
+
+    /**
+     * @brief Releases every task at the current tick.
+     */
+    void Start() {
+        started_ = false;
+        last_tick_ = Clock::Now();
+        for (uint32_t& due : next_due_) {
+            due = last_tick_;
+        }
+    }
+
+    /**
+     * @brief Runs all tasks due at the current tick, then returns.
+     * @return true if a new tick was processed, false if still on the same tick.
+     */
+    bool Poll() {
+        const uint32_t now = Clock::Now();
+        if (now == last_tick_ && started_) {
+            return false;
+        }
+        started_ = true;
+        last_tick_ = now;
+        const uint32_t tick_cycles = TickStartCycles(now);
+
+        for (std::size_t i = 0; i < N; ++i) {
+            // Signed compare keeps working across tick counter wrap-around
+            if (static_cast<int32_t>(now - next_due_[i]) < 0) {
+                continue;
+            }
+
+            const uint32_t late = now - next_due_[i];
+            if (late >= tasks_[i].period_ticks) {
+                stats_[i].deadline_misses += late / tasks_[i].period_ticks;
+                next_due_[i] += (late / tasks_[i].period_ticks) * tasks_[i].period_ticks;
+            }
+            const uint32_t release_cycles = tick_cycles - (now - next_due_[i]) * Clock::CyclesPerTick();
+            next_due_[i] += tasks_[i].period_ticks;
+
+            RunTask(i, release_cycles);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Scheduler main loop; never returns.
+     */
+    [[noreturn]] void Run() {
+        Start();
+        while (true) {
+            if (!Poll()) {
+                Clock::Idle(TicksUntilNextRelease());
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the number of ticks until the earliest pending task release.
+     * @return 0 if a task is already due.
+     */
+    uint32_t TicksUntilNextRelease() const {
+        const uint32_t now = Clock::Now();
+        uint32_t ticks = UINT32_MAX;
+        for (const uint32_t due : next_due_) {
+            const int32_t remaining = static_cast<int32_t>(due - now);
+            ticks = std::min(ticks, remaining > 0 ? static_cast<uint32_t>(remaining) : 0U);
+        }
+        return ticks;
+    }
+
+    /**
+     * @brief Gets the task table in execution (priority) order.
+     */
+    const std::array<Task, N>& GetTasks() const { return tasks_; }
+
+    /**
+     * @brief Gets statistics for the task at the given index of GetTasks().
+     */
+    const TaskStats& GetStats(std::size_t index) const { return stats_[index]; }
+
+    /**
+     * @brief Clears all statistics (e.g. after a reporting interval).
+     */
+    void ResetStats() { stats_ = {}; }
+
+private:
+    std::array<Task, N> tasks_;
+    std::array<TaskStats, N> stats_{};
+    std::array<uint32_t, N> next_due_{};
+    uint32_t last_tick_ = 0;
+    bool started_ = false;
+
+    // Cycle count at which the given tick began (Now() may have moved on since it was read)
+    static uint32_t TickStartCycles(uint32_t tick) {
+        uint32_t current;
+        uint32_t into;
+        uint32_t cycles;
+        do {  // Re-read if a tick boundary falls between the reads
+            current = Clock::Now();
+            into = Clock::CyclesIntoTick();
+            cycles = Clock::Cycles();
+        } while (Clock::Now() != current);
+        return cycles - into - (current - tick) * Clock::CyclesPerTick();
+    }
+
+    void RunTask(std::size_t i, uint32_t release_cycles) {
+        const uint32_t start = Clock::Cycles();
+        tasks_[i].run();
+        const uint32_t elapsed = Clock::Cycles() - start;
+
+        TaskStats& s = stats_[i];
+        s.runs++;
+        s.last_cycles = elapsed;
+        s.max_cycles = std::max(s.max_cycles, elapsed);
+        s.max_latency_cycles = std::max(s.max_latency_cycles, start - release_cycles);
+        if (elapsed > tasks_[i].period_ticks * Clock::CyclesPerTick()) {
+            s.overruns++;
+        }
+    }
+};
+
+}  // namespace awb
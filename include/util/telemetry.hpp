@@ -0,0 +1,207 @@
+#pragma once
+
+#include <stm32l4xx_hal.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+#include "util/logger.hpp"
+
+/**
+ * Binary telemetry.
+ *
+ * Samples of a fixed set of named signals are packed into binary packets and
+ * sent on the console stream, instead of one ">name:value" text line per sample
+ * (Logger::Plot()). Each packet is
+ *
+ *   [type][body ...][CRC-16 lo][CRC-16 hi]
+ *
+ * COBS-encoded and sent between two zero bytes. Console text never contains a
+ * zero, so text, deferred log frames and packets can share the stream.
+ * Multi-byte fields are little-endian. Packet types:
+ *
+ *   Schema:  [0x01][version][period ms (2)][rows per packet][signal count]
+ *            then per signal: [SignalType][name length][name ...]
+ *   Samples: [0x02][sequence (2)][tick ms of the first row (4)][row count]
+ *            then each row: every signal's value in schema order, sized by its type
+ *
+ * The schema is sent by Begin() and again on request (SendSchema()), so a host
+ * that attaches later can ask for it. tools/telemetry_decoder.py does that, checks
+ * the CRC and sequence numbers, and prints the samples in teleplot format.
+ */
+namespace awb::telemetry {
+
+inline constexpr std::uint8_t kVersion = 1;
+inline constexpr std::uint8_t kSchemaPacket = 0x01;
+inline constexpr std::uint8_t kSamplesPacket = 0x02;
+inline constexpr std::size_t kMaxPacketSize = 250;  ///< Before COBS and CRC; one COBS block plus a byte to spare
+inline constexpr std::size_t kMaxNameLength = 15;
+inline constexpr std::size_t kSamplesHeaderSize = 8;
+
+/**
+ * @brief Wire width of one signal's values.
+ */
+enum class SignalType : std::uint8_t {
+    I16 = 1,  ///< Signed 16-bit (values are saturated)
+    I32 = 2,  ///< Signed 32-bit
+};
+
+/**
+ * @brief One named signal in the schema.
+ */
+struct Signal {
+    const char* name;  ///< Label shown by the host (truncated to kMaxNameLength)
+    SignalType type;
+};
+
+/**
+ * @brief Appends the CRC, COBS-encodes a packet and writes it to the logger's transport.
+ * @param logger Logger whose transport receives the frame.
+ * @param packet Packet bytes; needs two spare bytes after @p length for the CRC.
+ * @param length Packet length without the CRC (at most kMaxPacketSize).
+ */
+void Send(Logger& logger, std::uint8_t* packet, std::size_t length);
+
+}  // namespace awb::telemetry
+
+namespace awb {
+
+/**
+ * @class Telemetry
+ * @brief Packs samples of N named signals into CRC-checked binary packets.
+ * @tparam N Number of signals.
+ *
+ * A text plot (Logger::Plot()) costs ~11 bytes and a vsnprintf call per value. Here
+ * a value costs 2 or 4 bytes and no formatting, plus ~13 bytes of packet overhead
+ * shared by all the rows batched into a packet.
+ */
+template <std::size_t N>
+class Telemetry {
+    static_assert(N > 0 && N <= 12, "Telemetry supports 1..12 signals (the schema must fit one packet)");
+
+public:
+    /**
+     * @param logger          Logger whose transport carries the packets (the console).
+     * @param signals         Names and types, in the order Record() takes values.
+     * @param period_ms       Interval between Record() calls (tells the host the sample rate).
+     * @param rows_per_packet Rows batched per packet; clamped to what fits kMaxPacketSize.
+     *                        More rows amortise the packet overhead at the cost of latency.
+     */
+    Telemetry(Logger& logger, const std::array<telemetry::Signal, N>& signals, std::uint16_t period_ms,
+              std::size_t rows_per_packet = 1)
+        : logger_(logger), signals_(signals), period_ms_(period_ms) {
+        for (const telemetry::Signal& signal : signals_) {
+            row_size_ += (signal.type == telemetry::SignalType::I16) ? 2 : 4;
+        }
+        const std::size_t max_rows = (telemetry::kMaxPacketSize - telemetry::kSamplesHeaderSize) / row_size_;
+        rows_per_packet_ = (rows_per_packet == 0) ? 1 : (rows_per_packet > max_rows ? max_rows : rows_per_packet);
+    }
+
+    // Delete copy/move: the packet under construction is tied to this instance
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    /**
+     * @brief Sends the schema and starts a new sequence of sample packets.
+     */
+    void Begin() {
+        sequence_ = 0;
+        rows_ = 0;
+        SendSchema();
+    }
+
+    /**
+     * @brief Sends the schema packet (e.g. when a host asks for it).
+     */
+    void SendSchema() {
+        std::uint8_t packet[telemetry::kMaxPacketSize + 2];
+        std::size_t size = 0;
+        packet[size++] = telemetry::kSchemaPacket;
+        packet[size++] = telemetry::kVersion;
+        packet[size++] = static_cast<std::uint8_t>(period_ms_);
+        packet[size++] = static_cast<std::uint8_t>(period_ms_ >> 8);
+        packet[size++] = static_cast<std::uint8_t>(rows_per_packet_);
+        packet[size++] = static_cast<std::uint8_t>(N);
+        for (const telemetry::Signal& signal : signals_) {
+            const std::string_view name =
+                (signal.name != nullptr) ? std::string_view(signal.name).substr(0, telemetry::kMaxNameLength) : "";
+            packet[size++] = static_cast<std::uint8_t>(signal.type);
+            packet[size++] = static_cast<std::uint8_t>(name.size());
+            std::memcpy(&packet[size], name.data(), name.size());
+            size += name.size();
+        }
+        telemetry::Send(logger_, packet, size);
+    }
+
+    /**
+     * @brief Records one row of samples; sends the packet once it holds rows_per_packet rows.
+     * @param values One value per signal, in schema order (missing values are sent as 0).
+     */
+    void Record(std::initializer_list<std::int32_t> values) {
+        if (rows_ == 0) {
+            const std::uint32_t tick = HAL_GetTick();
+            std::size_t size = 0;
+            packet_[size++] = telemetry::kSamplesPacket;
+            packet_[size++] = static_cast<std::uint8_t>(sequence_);
+            packet_[size++] = static_cast<std::uint8_t>(sequence_ >> 8);
+            std::memcpy(&packet_[size], &tick, sizeof(tick));
+            size_ = size + sizeof(tick) + 1;  // The row count goes in last
+        }
+
+        const std::int32_t* value = values.begin();
+        for (const telemetry::Signal& signal : signals_) {
+            const std::int32_t v = (value != values.end()) ? *value++ : 0;
+            if (signal.type == telemetry::SignalType::I16) {
+                const auto narrow = static_cast<std::int16_t>(std::clamp<std::int32_t>(v, INT16_MIN, INT16_MAX));
+                std::memcpy(&packet_[size_], &narrow, sizeof(narrow));
+                size_ += sizeof(narrow);
+            } else {
+                std::memcpy(&packet_[size_], &v, sizeof(v));
+                size_ += sizeof(v);
+            }
+        }
+
+        if (++rows_ == rows_per_packet_) {
+            Flush();
+        }
+    }
+
+    /**
+     * @brief Sends the rows recorded so far, if any, as a short packet.
+     * @note Call before pausing Record() calls: rows are timestamped from the first one
+     *       in the packet, so a packet must not span a gap.
+     */
+    void Flush() {
+        if (rows_ == 0) {
+            return;
+        }
+        packet_[telemetry::kSamplesHeaderSize - 1] = static_cast<std::uint8_t>(rows_);
+        telemetry::Send(logger_, packet_, size_);
+        ++sequence_;
+        rows_ = 0;
+    }
+
+    /**
+     * @brief Gets the number of rows batched per packet (after clamping).
+     */
+    std::size_t GetRowsPerPacket() const { return rows_per_packet_; }
+
+private:
+    Logger& logger_;
+    std::array<telemetry::Signal, N> signals_;
+    std::uint16_t period_ms_;
+    std::size_t row_size_ = 0;
+    std::size_t rows_per_packet_ = 1;
+
+    std::uint8_t packet_[telemetry::kMaxPacketSize + 2];  // Room for the CRC
+    std::size_t size_ = 0;
+    std::size_t rows_ = 0;
+    std::uint16_t sequence_ = 0;
+};
+
+}  // namespace awb
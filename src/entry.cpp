@@ -1,67 +1,375 @@
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <iterator>
+#include <string_view>
+
 #include "adc.h"
 #include "board_defs.hpp"
 #include "dac.h"
+#include "dsp/exponential.hpp"
+#include "dsp/fixed_point.hpp"
+#include "dsp/moving_median.hpp"
 #include "hal/adc.hpp"
+#include "hal/adc_calibration.hpp"
+#include "hal/current_monitor.hpp"
+#include "hal/dac.hpp"
+#include "hal/exti.hpp"
+#include "hal/flash.hpp"
+#include "hal/power.hpp"
+#include "hal/pwm.hpp"
+#include "hal/pwm_sync.hpp"
 #include "hal/uart.hpp"
+#include "rtc.h"
+#include "tim.h"
 #include "usart.h"
+#include "util/benchmark.hpp"
+#include "util/deferred_log.hpp"
 #include "util/error_codes.hpp"
 #include "util/logger.hpp"
+#include "util/scheduler.hpp"
+#include "util/telemetry.hpp"
 
 // Currently we are targeting the Nucleo-L476RG board because that is all I have on hand.
 // Once we get the actual board (Nucleo-L432KC), we can change the pin definitions.
 
-// This test application outputs a ramp signal on DAC channel 1.
+// This test application streams a triangle ramp to DAC channel 1 (DMA, paced by TIM6).
 // For the nucleo-l476rg, place a jumper between A0 (PA0) and A2 (PA4) to
 // connect the DAC output to the ADC input.
 
 hal::Adc<std::uint16_t> adc1(hadc1);
-std::uint16_t data[16];
+hal::Uart console_uart(huart2, hal::UartMode::Dma);
+
+// Scanned every pass: motor current (A0), supply divider (PC1), ambient light (PC0)
+// and die temperature. The DMA buffer interleaves them in this order.
+// Each result is 16 conversions averaged by the ADC's oversampler (12-bit out), and
+// every conversion is triggered by the motor PWM timebase at the centre of its
+// period: 20 kHz / 16 / 4 channels = ~310 SPS per channel, sampled away from the
+// switching edges and with no CPU averaging.
+using SenseSequence = hal::AdcSequence<ADC_CHANNEL_5, ADC_CHANNEL_2, ADC_CHANNEL_1, ADC_CHANNEL_TEMPSENSOR>;
+constexpr std::size_t kCurrentIndex = SenseSequence::IndexOf<ADC_CHANNEL_5>();
+constexpr std::size_t kSupplyIndex = SenseSequence::IndexOf<ADC_CHANNEL_2>();
+constexpr std::size_t kLightIndex = SenseSequence::IndexOf<ADC_CHANNEL_1>();
+constexpr std::size_t kTemperatureIndex = SenseSequence::IndexOf<ADC_CHANNEL_TEMPSENSOR>();
+std::uint16_t data[16 * SenseSequence::kSize];
+
+constexpr std::uint32_t kSenseSamplingTime = ADC_SAMPLETIME_24CYCLES_5;  // >= 5 us for the temperature sensor
+constexpr auto kPwmTiming =
+    hal::ComputePwmSyncTiming({board::clocks::kTim1Hz, 20'000, board::clocks::kAdcHz, kSenseSamplingTime});
+static_assert(kPwmTiming.has_value(), "ADC conversion does not fit the PWM period");
+hal::PwmSync motor_pwm(htim1);
+
+// H-bridge on TIM1 CH1/CH1N and CH2/CH2N, sharing the PWM timebase above. Outputs
+// stay disabled on the bench (no bridge fitted); 500 ns covers the gate driver's turn-off.
+constexpr auto kMotorDeadTime = hal::ComputeDeadTime(board::clocks::kTim1Hz, 500);
+static_assert(kMotorDeadTime.has_value(), "Dead time does not fit TIM1's DTG field");
+hal::Pwm motor_drive(htim1);
+
+// 512-step triangle at 100 updates/s: one 0 -> full scale -> 0 sweep every ~5 s
+hal::Dac dac1(hdac1, htim6);
+std::uint16_t stimulus[512];
+constexpr std::uint32_t kStimulusRateHz = 100;
+
+// The ramp stands in for motion: while it runs the core stays out of STOP2.
+// The user button pauses/resumes it.
+volatile bool ramp_enabled = true;
+
+// Cuts the H-bridge. On the bench the DAC ramp also plays the motor and the ADC
+// loopback its current sense, so it is muted too. Runs in the ADC interrupt, which may
+// have preempted RampTask inside a HAL call on the DAC: register writes only here,
+// and RampTask stops the DAC properly once it sees the trip.
+void DisableMotorDrive() {
+    motor_drive.Disable();
+    dac1.Mute();
+    ramp_enabled = false;
+}
+
+hal::CurrentMonitor<std::uint16_t> motor_current(adc1, DisableMotorDrive);
+constexpr std::uint16_t kMotorTripLevel = 3800;  // Raw code: the ADC's watchdog compares uncorrected results
+
+// Loopback correction for adc1, measured through the A0/A2 jumper on first boot and kept in flash
+hal::FlashPage calibration_page(board::flash::kCalibrationPage);
+hal::AdcCalibration adc1_calibration;
 
-std::uint16_t value_dac = 0;
+// Motor current conditioning, run on every ADC half-buffer: a short median knocks
+// out commutation spikes, then a low-pass (~30 Hz corner at the ~310 SPS per-channel rate)
+dsp::MovingMedian<dsp::q15_t, 5> current_median;
+dsp::Exponential<dsp::q15_t> current_lpf(0.45f);
+volatile dsp::q15_t filtered_current = 0;
+
+void OnCurrentBlock(void* /*context*/, const std::uint16_t* block, std::size_t length) {
+    const hal::AdcChannelView<std::uint16_t> current(block + kCurrentIndex, SenseSequence::kSize,
+                                                     length / SenseSequence::kSize);
+    std::uint16_t raw[16];
+    dsp::q15_t samples[16];
+    length = std::min(current.size(), std::size(samples));
+    for (std::size_t i = 0; i < length; ++i) {
+        raw[i] = adc1.Correct(current[i]);
+    }
+    dsp::AdcToQ15(raw, samples, length, adc1.GetResultBits());
+    current_median.Process(samples, samples, length);
+    current_lpf.Process(samples, samples, length);
+    filtered_current = samples[length - 1];
+}
+
+// Console commands are lines of text. A frame is whatever arrived before the line went
+// idle: a whole line from a host script, or single keystrokes from a terminal, so
+// lines are assembled here, in the UART interrupt, and handed to ConsoleTask.
+std::uint8_t console_rx[64];
+char console_line[32];
+std::size_t console_line_length = 0;
+std::atomic<bool> console_line_ready{false};
+
+void OnConsoleFrame(void* /*context*/, const std::uint8_t* frame, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        if (console_line_ready.load(std::memory_order_acquire)) {
+            return;  // The last line has not been handled yet; drop input until it is
+        }
+        const char c = static_cast<char>(frame[i]);
+        if (c == '\r' || c == '\n') {
+            if (console_line_length > 0) {
+                console_line[console_line_length] = '\0';
+                console_line_length = 0;
+                console_line_ready.store(true, std::memory_order_release);
+            }
+        } else if (console_line_length < sizeof(console_line) - 1) {
+            console_line[console_line_length++] = c;
+        }
+    }
+}
 
 void OnButtonPressed() {
     board::pins::StatusLed::Toggle();
+    ramp_enabled = !ramp_enabled;
 }
 
-extern "C" int Entry(void) {
-    board::pins::UserButton::AttachInterrupt(OnButtonPressed);
+static_assert(hal::HasExtiLine(board::pins::kPinMap, board::pins::UserButton::kPort, board::pins::UserButton::kPin),
+              "The pin map must configure the button's EXTI line");
+AWB_EXTI_DISPATCH(board::pins::UserButton::Interrupt<OnButtonPressed>);
 
-    hal::Uart console_uart(huart2);
+// Binary plots of the ramp (tools/telemetry_decoder.py turns them back into teleplot
+// lines). Four rows per ~60-byte packet replace ~44 bytes of text and four vsnprintf
+// calls per tick; adc/avg are 32-bit so their 0xFFFF read-error marker survives.
+awb::Telemetry<4> ramp_telemetry(Logger::GetInstance(),
+                                 {{
+                                     {"dac", awb::telemetry::SignalType::I16},
+                                     {"adc", awb::telemetry::SignalType::I32},
+                                     {"avg", awb::telemetry::SignalType::I32},
+                                     {"lpf", awb::telemetry::SignalType::I16},
+                                 }},
+                                 10, 4);
 
+// Starts/pauses the DAC stream and plots its output against the ADC readings
+void RampTask() {
+    static bool inhibiting = false;
+    static bool streaming = false;
+    if (ramp_enabled && !inhibiting) {
+        hal::PowerManager::GetInstance().Inhibit();
+        inhibiting = true;
+    } else if (!ramp_enabled && inhibiting) {
+        hal::PowerManager::GetInstance().Allow();
+        inhibiting = false;
+    }
+    if (ramp_enabled != streaming) {
+        if (ramp_enabled) {
+            // The button restarted the ramp, possibly after an over-current trip
+            if (motor_current.IsTripped()) {
+                motor_current.Clear();
+            }
+            streaming = dac1.Start(stimulus, std::size(stimulus));
+        } else {
+            // Paused by the button: hold the level. A trip has muted it; finish the stop.
+            dac1.SetValue(motor_current.IsTripped() ? 0 : dac1.GetOutput());
+            ramp_telemetry.Flush();
+            streaming = false;
+        }
+    }
+    if (!ramp_enabled) {
+        return;
+    }
+
+    auto adc_value = adc1.Read(kCurrentIndex);
+    auto adc_avg = adc1.ReadAverage(kCurrentIndex);
+
+    if (!adc_value.has_value()) {
+        AWB_LOGF("ADC Read Error: %s\r\n", awb::ToString(adc_value.error()));
+    }
+    if (!adc_avg.has_value()) {
+        AWB_LOGF("ADC Avg Error: %s\r\n", awb::ToString(adc_avg.error()));
+    }
+
+    ramp_telemetry.Record({dac1.GetOutput(), adc_value.value_or(0xFFFF), adc_avg.value_or(0xFFFF),
+                           dsp::Q15ToAdc(filtered_current)});
+}
+
+// Runs the console command received last, if any
+void ConsoleTask() {
+    if (!console_line_ready.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    const std::string_view command(console_line);
+    if (command == "pause" || command == "resume") {
+        ramp_enabled = (command == "resume");
+    } else if (command == "rx") {
+        const hal::UartRxStats rx = console_uart.GetRxStats();
+        AWB_LOGF("[console] frames=%" PRIu32 " bytes=%" PRIu32 " truncated=%" PRIu32 " overruns=%" PRIu32
+                 " framing=%" PRIu32 " noise=%" PRIu32 " parity=%" PRIu32 "\r\n",
+                 rx.frames, rx.bytes, rx.truncated, rx.overruns, rx.framing_errors, rx.noise_errors,
+                 rx.parity_errors);
+    } else if (command == "schema") {
+        ramp_telemetry.SendSchema();
+    } else {
+        AWB_LOGF("[console] commands: pause, resume, rx, schema\r\n");
+    }
+    console_line_ready.store(false, std::memory_order_release);
+}
+
+void StatsTask();
+
+awb::Scheduler<3, hal::LowPowerClock> scheduler({{
+    {"ramp", RampTask, 10, 0},
+    {"console", ConsoleTask, 50, 1},
+    {"stats", StatsTask, 1000, 2},
+}});
+
+// Reports per-task timing once per second
+void StatsTask() {
+    const auto& tasks = scheduler.GetTasks();
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const awb::TaskStats& stats = scheduler.GetStats(i);
+        AWB_LOGF("[%s] runs=%" PRIu32 " max=%" PRIu32 " cyc jitter=%" PRIu32 " cyc misses=%" PRIu32 " overruns=%" PRIu32
+                 "\r\n",
+                 tasks[i].name, stats.runs, stats.max_cycles, stats.max_latency_cycles, stats.deadline_misses,
+                 stats.overruns);
+    }
+    scheduler.ResetStats();
+
+    // VREFINT through the injected channel gives the true VDDA, which scales the rest
+    if (auto vrefint = adc1.ReadInjected(); vrefint.has_value() && *vrefint != 0) {
+        const std::uint32_t vdda_mv = __LL_ADC_CALC_VREFANALOG_VOLTAGE(*vrefint, LL_ADC_RESOLUTION_12B);
+        const std::int32_t temperature_c = __LL_ADC_CALC_TEMPERATURE(
+            vdda_mv, adc1.ReadAverage(kTemperatureIndex).value_or(0), LL_ADC_RESOLUTION_12B);
+        AWB_LOGF("[sense] vdda=%" PRIu32 " mV temp=%" PRId32 " C supply=%u light=%u\r\n", vdda_mv, temperature_c,
+                 adc1.ReadAverage(kSupplyIndex).value_or(0), adc1.ReadAverage(kLightIndex).value_or(0));
+    }
+
+    if (auto health = motor_current.Check(); !health.has_value()) {
+        AWB_LOGF("[motor] %s latched at %u (trips=%" PRIu32 ")\r\n", awb::ToString(health.error()),
+                 motor_current.GetTripValue(), motor_current.GetTripCount());
+    }
+
+    hal::PowerManager& power = hal::PowerManager::GetInstance();
+    const hal::PowerStats& power_stats = power.GetStats();
+    AWB_LOGF("[power] stops=%" PRIu32 " asleep=%" PRIu32 " ms wake=%" PRIu32 " us (max %" PRIu32 " us)\r\n",
+             power_stats.stop_entries, power_stats.stop_ms, power_stats.last_wake_latency_us,
+             power_stats.max_wake_latency_us);
+    power.ResetStats();
+}
+
+// Installs the stored correction table, or sweeps the DAC (~4 s) and stores the result.
+// Needs the ADC streaming. Without the jumper the sweep fails and adc1 stays uncorrected.
+void CalibrateAdc() {
+    auto stored = hal::LoadAdcCalibration(calibration_page);
+    if (stored.has_value() && stored->bits == adc1.GetResultBits()) {
+        adc1_calibration = *stored;
+    } else if (auto measured = hal::RunLoopbackCalibration(dac1, adc1, {.channel = kCurrentIndex});
+               measured.has_value()) {
+        adc1_calibration = *measured;
+        if (auto saved = hal::SaveAdcCalibration(calibration_page, adc1_calibration); !saved.has_value()) {
+            AWB_LOGF("[adc] calibration not saved: %s\r\n", awb::ToString(saved.error()));
+        }
+    } else {
+        AWB_LOGF("[adc] calibration failed: %s\r\n", awb::ToString(measured.error()));
+        return;
+    }
+
+    adc1.SetCalibration(&adc1_calibration);
+    AWB_LOGF("[adc] calibrated: gain=%+" PRId32 " ppm offset=%+" PRId32 " inl=%" PRId32 " (1/100 code)\r\n",
+             static_cast<std::int32_t>((adc1_calibration.gain - 1.0f) * 1e6f),
+             static_cast<std::int32_t>(adc1_calibration.offset * 100.0f),
+             static_cast<std::int32_t>(adc1_calibration.max_inl * 100.0f));
+}
+
+// Runs before the MX_*_Init() calls. The checked pin map is the only pin setup: the
+// .ioc leaves MX_GPIO_Init() uncalled and the MSP inits carry no GPIO code (strip it
+// again after regenerating), so a port to another board edits kPinMap alone.
+extern "C" void BoardInit(void) {
+    board::pins::Init();
+
+    // User button; CubeMX puts this in MX_GPIO_Init(). Priority as on the .ioc NVIC page.
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+}
+
+extern "C" int Entry(void) {
     Logger& logger = Logger::GetInstance();
     logger.Init(&console_uart);
     logger.Clear();
     logger.TestLogger();
 
-    HAL_DAC_Start(&hdac1, DAC_CHANNEL_1);
-
-    if (!adc1.Start(data, 16)) {
-        logger.LogLine("ADC Start Failed!");
+    // While the ramp is paused the core sleeps in STOP2 between ticks, where the USART
+    // clock is off: bytes arriving then are lost (resend, or use the user button)
+    if (!console_uart.StartReceive(console_rx, std::size(console_rx), OnConsoleFrame, nullptr)) {
+        logger.LogLine("Console RX Start Failed!");
         return -1;
     }
 
-    while (1) {
-        HAL_DAC_SetValue(&hdac1, DAC_CHANNEL_1, DAC_ALIGN_12B_R, value_dac);
+#ifdef AWB_BENCHMARKS
+    // Before the application claims the ADC (see bench/hal_bench.cpp)
+    awb::RunBenchmarks(logger);
+#endif
 
-        auto adc_value = adc1.Read();
-        auto adc_avg = adc1.ReadAverage();
+    hal::FillTriangle(stimulus, std::size(stimulus), 0, hal::kDacMaxCode);
+    if (!dac1.SetSampleRate(board::clocks::kTim6Hz, kStimulusRateHz)) {
+        logger.LogLine("DAC Rate Config Failed!");
+        return -1;
+    }
 
-        if (!adc_value.has_value()) {
-            logger.Logf("ADC Read Error: %s\r\n", awb::ToString(adc_value.error()));
-        }
-        if (!adc_avg.has_value()) {
-            logger.Logf("ADC Avg Error: %s\r\n", awb::ToString(adc_avg.error()));
-        }
+    if (!adc1.ConfigureTrigger(ADC_EXTERNALTRIG_T1_TRGO2) || !adc1.ConfigureOversampling<16, 4>() ||
+        !adc1.ConfigureSequence<SenseSequence>(kSenseSamplingTime) ||
+        !adc1.ConfigureInjected(ADC_CHANNEL_VREFINT, ADC_SAMPLETIME_92CYCLES_5)) {
+        logger.LogLine("ADC Sequence Config Failed!");
+        return -1;
+    }
 
-        logger.Plot("dac", value_dac);
-        logger.Plot("adc", adc_value.value_or(0xFFFF));
-        logger.Plot("avg", adc_avg.value_or(0xFFFF));
+    adc1.SetBlockHandler(OnCurrentBlock, nullptr);
+    if (!adc1.StartStreaming(data, std::size(data))) {
+        logger.LogLine("ADC Start Failed!");
+        return -1;
+    }
 
-        value_dac++;
-        if (value_dac > 4095) {
-            value_dac = 0;
-        }
+    // Conversions only happen on PWM triggers from here on
+    if (!motor_pwm.Start(*kPwmTiming)) {
+        logger.LogLine("PWM Start Failed!");
+        return -1;
+    }
+    if (!motor_drive.Configure(*kMotorDeadTime)) {
+        logger.LogLine("Motor Drive Config Failed!");
+        return -1;
+    }
 
-        HAL_Delay(10);
+    // The sweep drives the loopback to full scale, so the over-current trip is armed
+    // afterwards (the watchdog is configured with conversions stopped)
+    CalibrateAdc();
+    adc1.Stop();
+    if (!motor_current.Arm(ADC_CHANNEL_5, kMotorTripLevel)) {
+        logger.LogLine("Current Monitor Arm Failed!");
+        return -1;
     }
+    if (!adc1.StartStreaming(data, std::size(data))) {
+        logger.LogLine("ADC Start Failed!");
+        return -1;
+    }
+
+    // The console has to drain before STOP2 freezes its DMA; the ADC stream is
+    // restarted on wake so the first snapshot after resume is fresh
+    hal::PowerManager& power = hal::PowerManager::GetInstance();
+    power.Init(&hrtc);
+    power.AddHooks({[] { console_uart.Flush(10); }, nullptr});
+    power.AddHooks({[] { adc1.Stop(); }, [] { adc1.StartStreaming(data, std::size(data)); }});
+
+    ramp_telemetry.Begin();
+    hal::LowPowerClock::Init();
+    scheduler.Run();
 }
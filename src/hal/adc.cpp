@@ -1,12 +1,119 @@
 #include "hal/adc.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <limits>
+#include <type_traits>
 
 #include "stm32l4xx_hal_def.h"
 #include "util/error_codes.hpp"
 
 namespace hal {
 
+// ADCs in streaming mode, looked up by handle from the HAL DMA callbacks
+struct StreamSlot {
+    ADC_HandleTypeDef* handle;
+    void* adc;
+    void (*on_block)(void* adc, bool upper_half);
+};
+static constexpr std::size_t kMaxStreamingAdcs = 3;
+static StreamSlot stream_slots[kMaxStreamingAdcs]{};
+
+static void RegisterStream(ADC_HandleTypeDef* handle, void* adc, void (*on_block)(void*, bool)) {
+    for (StreamSlot& slot : stream_slots) {
+        if (slot.handle == nullptr || slot.handle == handle) {
+            slot = {handle, adc, on_block};
+            return;
+        }
+    }
+}
+
+static void UnregisterStream(ADC_HandleTypeDef* handle) {
+    for (StreamSlot& slot : stream_slots) {
+        if (slot.handle == handle) {
+            slot = {};
+        }
+    }
+}
+
+static void DispatchStream(ADC_HandleTypeDef* handle, bool upper_half) {
+    for (const StreamSlot& slot : stream_slots) {
+        if (slot.handle == handle) {
+            slot.on_block(slot.adc, upper_half);
+            return;
+        }
+    }
+}
+
+// ADCs with an armed analog watchdog, looked up by handle from the HAL AWD callback
+struct WatchdogSlot {
+    ADC_HandleTypeDef* handle;
+    void* context;
+    void (*on_trip)(void* context, std::uint32_t value);
+};
+static constexpr std::size_t kMaxWatchdogAdcs = 3;
+static WatchdogSlot watchdog_slots[kMaxWatchdogAdcs]{};
+
+static void RegisterWatchdog(ADC_HandleTypeDef* handle, void* context, void (*on_trip)(void*, std::uint32_t)) {
+    for (WatchdogSlot& slot : watchdog_slots) {
+        if (slot.handle == nullptr || slot.handle == handle) {
+            slot = {handle, context, on_trip};
+            return;
+        }
+    }
+}
+
+static void UnregisterWatchdog(ADC_HandleTypeDef* handle) {
+    for (WatchdogSlot& slot : watchdog_slots) {
+        if (slot.handle == handle) {
+            slot = {};
+        }
+    }
+}
+
+static void DispatchWatchdog(ADC_HandleTypeDef* handle) {
+    for (const WatchdogSlot& slot : watchdog_slots) {
+        if (slot.handle == handle) {
+            slot.on_trip(slot.context, HAL_ADC_GetValue(handle));
+            break;
+        }
+    }
+
+    // One-shot: the flag re-asserts on every out-of-window conversion
+    __HAL_ADC_DISABLE_IT(handle, ADC_IT_AWD1);
+}
+
+// Sequencer rank for each position of a regular sequence
+static constexpr std::uint32_t kRegularRanks[kMaxAdcChannels] = {
+    ADC_REGULAR_RANK_1, ADC_REGULAR_RANK_2, ADC_REGULAR_RANK_3, ADC_REGULAR_RANK_4,
+    ADC_REGULAR_RANK_5, ADC_REGULAR_RANK_6, ADC_REGULAR_RANK_7, ADC_REGULAR_RANK_8,
+};
+
+// Oversampler ratio and shift settings, indexed by log2(ratio) - 1 and by shift
+static constexpr std::uint32_t kOversamplingRatios[] = {
+    ADC_OVERSAMPLING_RATIO_2,  ADC_OVERSAMPLING_RATIO_4,  ADC_OVERSAMPLING_RATIO_8,   ADC_OVERSAMPLING_RATIO_16,
+    ADC_OVERSAMPLING_RATIO_32, ADC_OVERSAMPLING_RATIO_64, ADC_OVERSAMPLING_RATIO_128, ADC_OVERSAMPLING_RATIO_256,
+};
+static constexpr std::uint32_t kOversamplingShifts[] = {
+    ADC_RIGHTBITSHIFT_NONE, ADC_RIGHTBITSHIFT_1, ADC_RIGHTBITSHIFT_2, ADC_RIGHTBITSHIFT_3, ADC_RIGHTBITSHIFT_4,
+    ADC_RIGHTBITSHIFT_5,    ADC_RIGHTBITSHIFT_6, ADC_RIGHTBITSHIFT_7, ADC_RIGHTBITSHIFT_8,
+};
+
+// Externally triggered: one trigger per accumulated conversion, or the whole burst runs at once
+static std::uint32_t TriggeredMode(std::uint32_t trigger) {
+    return (trigger == ADC_SOFTWARE_START) ? ADC_TRIGGEREDMODE_SINGLE_TRIGGER : ADC_TRIGGEREDMODE_MULTI_TRIGGER;
+}
+
+static unsigned ResolutionBits(std::uint32_t resolution) {
+    switch (resolution) {
+        case ADC_RESOLUTION_10B: return 10;
+        case ADC_RESOLUTION_8B: return 8;
+        case ADC_RESOLUTION_6B: return 6;
+        default: return 12;
+    }
+}
+
 template <typename SampleType>
 Adc<SampleType>::Adc(ADC_HandleTypeDef& handle) : handle_(handle) {
 }
@@ -17,6 +124,15 @@ bool Adc<SampleType>::Start(SampleType* buffer, std::size_t length) {
         return false;
     }
 
+    if (!SampleTypeFits()) {
+        return false;
+    }
+
+    // Every rank must land in the same column on every pass through the buffer
+    if (channel_count_ > 1 && (!IsDmaMode() || (length % channel_count_) != 0)) {
+        return false;
+    }
+
     // Ensure any previous operation is stopped
     Stop();
 
@@ -39,8 +155,208 @@ bool Adc<SampleType>::Start(SampleType* buffer, std::size_t length) {
     }
 }
 
+template <typename SampleType>
+bool Adc<SampleType>::StartStreaming(SampleType* buffer, std::size_t length, std::uint32_t decimation) {
+    if (!IsDmaMode() || length < 2 || (length % 2) != 0 || decimation == 0) {
+        return false;
+    }
+
+    // Each half must start at rank 1 so ProcessBlock() can de-interleave it
+    if (((length / 2) % channel_count_) != 0) {
+        return false;
+    }
+
+    if (!Start(buffer, length)) {
+        return false;
+    }
+
+    decimation_ = decimation;
+    publish_count_ = 0;
+    std::fill(std::begin(snapshots_[0]), std::end(snapshots_[0]), AdcSnapshot<SampleType>{});
+    std::fill(std::begin(snapshots_[1]), std::end(snapshots_[1]), AdcSnapshot<SampleType>{});
+    ResetAccumulator();
+    streaming_ = true;
+    RegisterStream(&handle_, this, &Adc::OnBlockComplete);
+    return true;
+}
+
+template <typename SampleType>
+bool Adc<SampleType>::ConfigureSequence(const std::uint32_t* channels, std::size_t count,
+                                        std::uint32_t sampling_time) {
+    if (channels == nullptr || count == 0 || count > kMaxAdcChannels) {
+        return false;
+    }
+    // Without DMA only the last conversion of a scan would be readable
+    if (count > 1 && !IsDmaMode()) {
+        return false;
+    }
+
+    Stop();
+
+    handle_.Init.ScanConvMode = (count > 1) ? ADC_SCAN_ENABLE : ADC_SCAN_DISABLE;
+    handle_.Init.NbrOfConversion = static_cast<std::uint32_t>(count);
+    if (HAL_ADC_Init(&handle_) != HAL_OK) {
+        return false;
+    }
+
+    ADC_ChannelConfTypeDef config = {};
+    config.SamplingTime = sampling_time;
+    config.SingleDiff = ADC_SINGLE_ENDED;
+    config.OffsetNumber = ADC_OFFSET_NONE;
+    config.Offset = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        config.Channel = channels[i];
+        config.Rank = kRegularRanks[i];
+        if (HAL_ADC_ConfigChannel(&handle_, &config) != HAL_OK) {
+            return false;
+        }
+    }
+
+    channel_count_ = count;
+    return true;
+}
+
+template <typename SampleType>
+bool Adc<SampleType>::ConfigureOversampling(std::uint32_t ratio, std::uint32_t right_shift) {
+    const bool enable = ratio > 1;
+    if (!std::has_single_bit(ratio) || ratio > 256 || right_shift > 8) {
+        return false;
+    }
+    if (AdcOversampledBits(ResolutionBits(handle_.Init.Resolution), ratio, right_shift) >
+        static_cast<unsigned>(std::numeric_limits<SampleType>::digits)) {
+        return false;
+    }
+
+    Stop();
+
+    handle_.Init.OversamplingMode = enable ? ENABLE : DISABLE;
+    if (enable) {
+        handle_.Init.Oversampling.Ratio = kOversamplingRatios[std::bit_width(ratio) - 2];
+        handle_.Init.Oversampling.RightBitShift = kOversamplingShifts[right_shift];
+        handle_.Init.Oversampling.TriggeredMode = TriggeredMode(handle_.Init.ExternalTrigConv);
+        handle_.Init.Oversampling.OversamplingStopReset = ADC_REGOVERSAMPLING_CONTINUED_MODE;
+    }
+    return HAL_ADC_Init(&handle_) == HAL_OK;
+}
+
+template <typename SampleType>
+bool Adc<SampleType>::ConfigureTrigger(std::uint32_t trigger, std::uint32_t edge) {
+    const bool external = trigger != ADC_SOFTWARE_START;
+
+    Stop();
+
+    handle_.Init.ExternalTrigConv = trigger;
+    handle_.Init.ExternalTrigConvEdge = external ? edge : ADC_EXTERNALTRIGCONVEDGE_NONE;
+    handle_.Init.ContinuousConvMode = external ? DISABLE : ENABLE;
+    handle_.Init.Oversampling.TriggeredMode = TriggeredMode(trigger);
+    return HAL_ADC_Init(&handle_) == HAL_OK;
+}
+
+template <typename SampleType>
+unsigned Adc<SampleType>::GetResultBits() const {
+    const unsigned resolution = ResolutionBits(handle_.Init.Resolution);
+    if (handle_.Init.OversamplingMode != ENABLE) {
+        return resolution;
+    }
+
+    // Read back from the handle so settings made in CubeMX are honoured too
+    const auto ratio = std::find(std::begin(kOversamplingRatios), std::end(kOversamplingRatios),
+                                 handle_.Init.Oversampling.Ratio);
+    const auto shift = std::find(std::begin(kOversamplingShifts), std::end(kOversamplingShifts),
+                                 handle_.Init.Oversampling.RightBitShift);
+    const std::uint32_t ratio_value = 2U << (ratio - std::begin(kOversamplingRatios));
+    const std::uint32_t shift_value = static_cast<std::uint32_t>(shift - std::begin(kOversamplingShifts));
+    return AdcOversampledBits(resolution, ratio_value, shift_value);
+}
+
+template <typename SampleType>
+bool Adc<SampleType>::SetCalibration(const AdcCalibration* calibration) {
+    if (calibration != nullptr && calibration->bits != GetResultBits()) {
+        return false;
+    }
+    calibration_ = calibration;
+    return true;
+}
+
+template <typename SampleType>
+bool Adc<SampleType>::SampleTypeFits() const {
+    if (GetResultBits() > static_cast<unsigned>(std::numeric_limits<SampleType>::digits)) {
+        return false;
+    }
+    if (!IsDmaMode()) {
+        return true;
+    }
+
+    // A narrower DMA element silently drops the top bits; a wider one interleaves garbage
+    switch (handle_.DMA_Handle->Init.MemDataAlignment) {
+        case DMA_MDATAALIGN_BYTE: return sizeof(SampleType) == 1;
+        case DMA_MDATAALIGN_HALFWORD: return sizeof(SampleType) == 2;
+        default: return sizeof(SampleType) == 4;
+    }
+}
+
+template <typename SampleType>
+std::expected<AdcChannelView<SampleType>, awb::Error> Adc<SampleType>::GetChannelView(std::size_t channel) const {
+    if (buffer_ == nullptr || !IsDmaMode() || channel >= channel_count_) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+    return AdcChannelView<SampleType>(buffer_ + channel, channel_count_, length_ / channel_count_);
+}
+
+template <typename SampleType>
+bool Adc<SampleType>::ConfigureInjected(std::uint32_t channel, std::uint32_t sampling_time) {
+    ADC_InjectionConfTypeDef config = {};
+    config.InjectedChannel = channel;
+    config.InjectedRank = ADC_INJECTED_RANK_1;
+    config.InjectedSamplingTime = sampling_time;
+    config.InjectedSingleDiff = ADC_SINGLE_ENDED;
+    config.InjectedOffsetNumber = ADC_OFFSET_NONE;
+    config.InjectedOffset = 0;
+    config.InjectedNbrOfConversion = 1;
+    config.InjectedDiscontinuousConvMode = DISABLE;
+    config.AutoInjectedConv = DISABLE;
+    config.QueueInjectedContext = DISABLE;
+    config.ExternalTrigInjecConv = ADC_INJECTED_SOFTWARE_START;
+    config.ExternalTrigInjecConvEdge = ADC_EXTERNALTRIGINJECCONV_EDGE_NONE;
+    config.InjecOversamplingMode = DISABLE;
+
+    injected_configured_ = HAL_ADCEx_InjectedConfigChannel(&handle_, &config) == HAL_OK;
+    return injected_configured_;
+}
+
+template <typename SampleType>
+std::expected<SampleType, awb::Error> Adc<SampleType>::ReadInjected() {
+    if (!injected_configured_) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    // Enables the ADC if it is idle; otherwise the conversion slots in between regular ranks
+    if (HAL_ADCEx_InjectedStart(&handle_) != HAL_OK) {
+        return std::unexpected(awb::Error::Busy);
+    }
+    if (HAL_ADCEx_InjectedPollForConversion(&handle_, MAX_TIMEOUT_MS_) != HAL_OK) {
+        return std::unexpected(awb::Error::Timeout);
+    }
+    return static_cast<SampleType>(HAL_ADCEx_InjectedGetValue(&handle_, ADC_INJECTED_RANK_1));
+}
+
+template <typename SampleType>
+void Adc<SampleType>::SetBlockHandler(void (*on_block)(void*, const SampleType*, std::size_t), void* context) {
+    // Cleared first so the interrupt never pairs the new handler with the old context
+    block_handler_ = nullptr;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    block_context_ = context;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    block_handler_ = on_block;
+}
+
 template <typename SampleType>
 void Adc<SampleType>::Stop() {
+    if (streaming_) {
+        UnregisterStream(&handle_);
+        streaming_ = false;
+    }
+
     if (handle_.DMA_Handle != nullptr) {
         HAL_ADC_Stop_DMA(&handle_);
     } else {
@@ -64,7 +380,7 @@ std::expected<SampleType, awb::Error> Adc<SampleType>::Read(std::size_t index) {
         }
 
         volatile SampleType* dma_view = buffer_;
-        return dma_view[index];
+        return Correct(dma_view[index]);
     } else {
         // Strictness Check: Polling logic here only supports the 'current' conversion.
         // Requesting index 1+ implies we have a history buffer, which polling doesn't provide.
@@ -78,24 +394,154 @@ std::expected<SampleType, awb::Error> Adc<SampleType>::Read(std::size_t index) {
         SampleType val = static_cast<SampleType>(HAL_ADC_GetValue(&handle_));
         buffer_[0] = val;
 
-        return val;
+        return Correct(val);
     }
 }
 
 template <typename SampleType>
-std::expected<SampleType, awb::Error> Adc<SampleType>::ReadAverage() {
-    if (buffer_ == nullptr || length_ == 0) {
+std::expected<SampleType, awb::Error> Adc<SampleType>::ReadAverage(std::size_t channel) {
+    if (buffer_ == nullptr || length_ == 0 || channel >= channel_count_) {
         return std::unexpected(awb::Error::InvalidParam);  // Not Started
     }
 
+    if (streaming_) {
+        auto snapshot = ReadSnapshot(channel);
+        if (snapshot.has_value()) {
+            return snapshot->average;
+        }
+    }
+
     uint64_t sum = 0;
 
     volatile SampleType* dma_view = buffer_;
-    for (std::size_t i = 0; i < length_; ++i) {
+    for (std::size_t i = channel; i < length_; i += channel_count_) {
         sum += dma_view[i];
     }
 
-    return static_cast<SampleType>(sum / length_);
+    return Correct(static_cast<SampleType>(sum / (length_ / channel_count_)));
+}
+
+template <typename SampleType>
+std::expected<AdcSnapshot<SampleType>, awb::Error> Adc<SampleType>::ReadSnapshot(std::size_t channel) const {
+    if (!streaming_ || channel >= channel_count_) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    // The ISR writes the slot *after* the published one. If it publishes while we
+    // copy, the slot we are reading may be next in line, so retry.
+    AdcSnapshot<SampleType> snapshot;
+    std::uint32_t count;
+    do {
+        count = publish_count_;
+        std::atomic_signal_fence(std::memory_order_acquire);
+        snapshot = snapshots_[count & 1][channel];
+        std::atomic_signal_fence(std::memory_order_acquire);
+    } while (count != publish_count_);
+
+    if (count == 0) {
+        return std::unexpected(awb::Error::Busy);  // No block completed yet
+    }
+    return snapshot;
+}
+
+template <typename SampleType>
+bool Adc<SampleType>::ArmWatchdog(std::uint32_t channel, SampleType low, SampleType high,
+                                  void (*on_trip)(void*, std::uint32_t), void* context) {
+    if (on_trip == nullptr || low > high) {
+        return false;
+    }
+
+    ADC_AnalogWDGConfTypeDef config = {};
+    config.WatchdogNumber = ADC_ANALOGWATCHDOG_1;
+    config.WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG;
+    config.Channel = channel;
+    config.ITMode = ENABLE;
+    config.HighThreshold = high;
+    config.LowThreshold = low;
+
+    // Register first so a conversion that is already out of window finds its handler
+    RegisterWatchdog(&handle_, context, on_trip);
+    if (HAL_ADC_AnalogWDGConfig(&handle_, &config) != HAL_OK) {
+        UnregisterWatchdog(&handle_);
+        return false;
+    }
+    return true;
+}
+
+template <typename SampleType>
+void Adc<SampleType>::RearmWatchdog() {
+    __HAL_ADC_CLEAR_FLAG(&handle_, ADC_FLAG_AWD1);
+    __HAL_ADC_ENABLE_IT(&handle_, ADC_IT_AWD1);
+}
+
+template <typename SampleType>
+void Adc<SampleType>::DisarmWatchdog() {
+    __HAL_ADC_DISABLE_IT(&handle_, ADC_IT_AWD1);
+    UnregisterWatchdog(&handle_);
+}
+
+template <typename SampleType>
+void Adc<SampleType>::ResetAccumulator() {
+    acc_blocks_ = 0;
+    for (ChannelAccumulator& acc : acc_) {
+        acc = {0, std::numeric_limits<SampleType>::max(), std::numeric_limits<SampleType>::min()};
+    }
+}
+
+template <typename SampleType>
+void Adc<SampleType>::ProcessBlock(bool upper_half) {
+    // DMA is now filling the other half, so this one is stable until the next interrupt
+    const std::size_t half = length_ / 2;
+    const SampleType* block = buffer_ + (upper_half ? half : 0);
+
+    // 32-bit sums are plenty for a half-buffer of 8/16-bit samples and keep the loop cheap
+    using BlockSum = std::conditional_t<sizeof(SampleType) <= 2, std::uint32_t, std::uint64_t>;
+    const std::size_t stride = channel_count_;
+    const AdcCalibration* calibration = calibration_;
+    for (std::size_t ch = 0; ch < stride; ++ch) {
+        ChannelAccumulator& acc = acc_[ch];
+        BlockSum sum = 0;
+        SampleType lo = acc.min;
+        SampleType hi = acc.max;
+        for (std::size_t i = ch; i < half; i += stride) {
+            // The branch is loop-invariant; corrected samples cost a table lookup and a multiply
+            const SampleType v = (calibration != nullptr) ? static_cast<SampleType>(calibration->Apply(block[i]))
+                                                          : block[i];
+            sum += v;
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+        }
+        acc.sum += sum;
+        acc.min = lo;
+        acc.max = hi;
+    }
+
+    if (block_handler_ != nullptr) {
+        block_handler_(block_context_, block, half);
+    }
+
+    if (++acc_blocks_ < decimation_) {
+        return;
+    }
+
+    const std::uint32_t next = publish_count_ + 1;
+    const std::uint64_t samples_per_channel = static_cast<std::uint64_t>(half / stride) * acc_blocks_;
+    for (std::size_t ch = 0; ch < stride; ++ch) {
+        AdcSnapshot<SampleType>& slot = snapshots_[next & 1][ch];
+        slot.average = static_cast<SampleType>(acc_[ch].sum / samples_per_channel);
+        slot.min = acc_[ch].min;
+        slot.max = acc_[ch].max;
+        slot.sequence = next;
+    }
+    std::atomic_signal_fence(std::memory_order_release);
+    publish_count_ = next;
+
+    ResetAccumulator();
+}
+
+template <typename SampleType>
+void Adc<SampleType>::OnBlockComplete(void* self, bool upper_half) {
+    static_cast<Adc*>(self)->ProcessBlock(upper_half);
 }
 
 // -----------------------------------------------------------------------------
@@ -109,3 +555,16 @@ template class Adc<uint16_t>;  // 16-bit DMA (Half-Word) - Most Common
 template class Adc<uint32_t>;  // 32-bit DMA (Word)
 
 }  // namespace hal
+
+// Override the HAL's weak callbacks
+extern "C" void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc) {
+    hal::DispatchStream(hadc, false);
+}
+
+extern "C" void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc) {
+    hal::DispatchStream(hadc, true);
+}
+
+extern "C" void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef* hadc) {
+    hal::DispatchWatchdog(hadc);
+}
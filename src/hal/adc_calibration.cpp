@@ -0,0 +1,91 @@
+#include "hal/adc_calibration.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "hal/adc.hpp"
+#include "hal/dac.hpp"
+#include "hal/flash.hpp"
+#include "util/crc.hpp"
+
+namespace hal {
+
+std::expected<AdcCalibration, awb::Error> RunLoopbackCalibration(Dac& dac, Adc<std::uint16_t>& adc,
+                                                                 const LoopbackSweep& sweep) {
+    if (sweep.steps < 2 || sweep.steps > kMaxLoopbackSteps || sweep.first_code >= sweep.last_code ||
+        sweep.last_code > kDacMaxCode || sweep.snapshots == 0) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    adc.SetCalibration(nullptr);
+    const unsigned bits = adc.GetResultBits();
+    const std::uint32_t max_code = (1U << bits) - 1U;
+
+    std::array<LoopbackPoint, kMaxLoopbackSteps> points{};
+    for (std::size_t step = 0; step < sweep.steps; ++step) {
+        const std::uint32_t span = sweep.last_code - sweep.first_code;
+        const auto code = static_cast<std::uint16_t>(sweep.first_code + span * step / (sweep.steps - 1));
+        if (!dac.SetValue(code)) {
+            dac.Stop();
+            return std::unexpected(awb::Error::InvalidParam);
+        }
+        HAL_Delay(sweep.settle_ms);
+
+        // The snapshot after the current one was already being accumulated, possibly
+        // from before the step; only the ones after that are clean
+        auto snapshot = adc.ReadSnapshot(sweep.channel);
+        if (!snapshot.has_value() && snapshot.error() != awb::Error::Busy) {
+            dac.Stop();
+            return std::unexpected(snapshot.error());
+        }
+        std::uint32_t last_sequence = snapshot.has_value() ? snapshot->sequence + 1 : 1;
+
+        std::uint64_t sum = 0;
+        std::uint32_t taken = 0;
+        const std::uint32_t start = HAL_GetTick();
+        while (taken < sweep.snapshots) {
+            if (HAL_GetTick() - start > sweep.timeout_ms) {
+                dac.Stop();
+                return std::unexpected(awb::Error::Timeout);
+            }
+            snapshot = adc.ReadSnapshot(sweep.channel);
+            if (snapshot.has_value() && snapshot->sequence > last_sequence) {
+                last_sequence = snapshot->sequence;
+                sum += snapshot->average;
+                ++taken;
+            } else {
+                HAL_Delay(1);  // Snapshots are milliseconds apart
+            }
+        }
+
+        points[step].expected = (static_cast<std::uint32_t>(code) * max_code + kDacMaxCode / 2) / kDacMaxCode;
+        points[step].measured = static_cast<std::uint32_t>((sum + taken / 2) / taken);
+    }
+    dac.Stop();
+
+    return ComputeAdcCalibration(points.data(), sweep.steps, bits);
+}
+
+// The CRC covers the record up to (not including) its own field
+static std::uint32_t RecordCrc(const AdcCalibration& calibration) {
+    return awb::Crc32(reinterpret_cast<const std::uint8_t*>(&calibration), offsetof(AdcCalibration, crc));
+}
+
+std::expected<AdcCalibration, awb::Error> LoadAdcCalibration(const FlashPage& page) {
+    AdcCalibration calibration;
+    std::memcpy(&calibration, page.Data(), sizeof(calibration));
+    if (calibration.magic != AdcCalibration::kMagic || calibration.version != AdcCalibration::kVersion ||
+        calibration.crc != RecordCrc(calibration)) {
+        return std::unexpected(awb::Error::NotCalibrated);
+    }
+    return calibration;
+}
+
+std::expected<void, awb::Error> SaveAdcCalibration(FlashPage& page, const AdcCalibration& calibration) {
+    AdcCalibration record = calibration;
+    record.crc = RecordCrc(record);
+    return page.Write(&record, sizeof(record));
+}
+
+}  // namespace hal
@@ -0,0 +1,55 @@
+#include "hal/board_map.hpp"
+
+#include <cstddef>
+
+#include "hal/fast_gpio.hpp"
+
+namespace hal {
+
+namespace {
+
+// Read-modify-write of the masked fields only; registers with nothing to change are not touched
+void Update(const std::uintptr_t address, const std::uint32_t mask, const std::uint32_t value) {
+    if (mask != 0) {
+        detail::Reg(address) = (detail::Reg(address) & ~mask) | value;
+    }
+}
+
+}  // namespace
+
+void ApplyGpioImage(const GpioImage& image) {
+    for (std::size_t i = 0; i < image.port_count; ++i) {
+        detail::EnableGpioClock(image.ports[i].port);
+    }
+
+    for (std::size_t i = 0; i < image.port_count; ++i) {
+        const GpioPortImage& p = image.ports[i];
+        if (p.bsrr != 0) {
+            detail::Reg(p.port + offsetof(GPIO_TypeDef, BSRR)) = p.bsrr;
+        }
+        Update(p.port + offsetof(GPIO_TypeDef, OSPEEDR), p.ospeedr_mask, p.ospeedr);
+        Update(p.port + offsetof(GPIO_TypeDef, OTYPER), p.otyper_mask, p.otyper);
+#ifdef GPIO_ASCR_ASC0
+        Update(p.port + offsetof(GPIO_TypeDef, ASCR), p.ascr_mask, p.ascr);
+#endif
+        Update(p.port + offsetof(GPIO_TypeDef, PUPDR), p.pupdr_mask, p.pupdr);
+        Update(p.port + offsetof(GPIO_TypeDef, AFR[0]), p.afr_mask[0], p.afr[0]);
+        Update(p.port + offsetof(GPIO_TypeDef, AFR[1]), p.afr_mask[1], p.afr[1]);
+        Update(p.port + offsetof(GPIO_TypeDef, MODER), p.moder_mask, p.moder);
+    }
+
+    if (image.exti_lines == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        if (image.exticr_mask[i] != 0) {
+            SYSCFG->EXTICR[i] = (SYSCFG->EXTICR[i] & ~image.exticr_mask[i]) | image.exticr[i];
+        }
+    }
+    EXTI->RTSR1 = (EXTI->RTSR1 & ~image.exti_lines) | image.rtsr;
+    EXTI->FTSR1 = (EXTI->FTSR1 & ~image.exti_lines) | image.ftsr;
+    EXTI->EMR1 &= ~image.exti_lines;
+    EXTI->IMR1 |= image.exti_lines;
+}
+
+}  // namespace hal
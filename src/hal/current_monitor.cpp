@@ -0,0 +1,48 @@
+#include "hal/current_monitor.hpp"
+
+#include <limits>
+
+namespace hal {
+
+template <typename SampleType>
+bool CurrentMonitor<SampleType>::Arm(std::uint32_t channel, SampleType trip_level) {
+    return adc_.ArmWatchdog(channel, std::numeric_limits<SampleType>::min(), trip_level, &CurrentMonitor::OnTrip,
+                            this);
+}
+
+template <typename SampleType>
+std::expected<void, awb::Error> CurrentMonitor<SampleType>::Check() const {
+    if (tripped_) {
+        return std::unexpected(awb::Error::MotorOvercurrent);
+    }
+    return {};
+}
+
+template <typename SampleType>
+void CurrentMonitor<SampleType>::Clear() {
+    tripped_ = false;
+    adc_.RearmWatchdog();
+}
+
+template <typename SampleType>
+void CurrentMonitor<SampleType>::OnTrip(void* self, std::uint32_t value) {
+    auto* monitor = static_cast<CurrentMonitor*>(self);
+
+    // Cut the drive before any bookkeeping
+    monitor->disable_outputs_();
+
+    monitor->trip_value_ = static_cast<SampleType>(value);
+    monitor->trip_count_ = monitor->trip_count_ + 1;
+    monitor->tripped_ = true;
+}
+
+// -----------------------------------------------------------------------------
+// Explicit Instantiation
+// -----------------------------------------------------------------------------
+// Must match the hal::Adc instantiations.
+
+template class CurrentMonitor<uint8_t>;
+template class CurrentMonitor<uint16_t>;
+template class CurrentMonitor<uint32_t>;
+
+}  // namespace hal
@@ -0,0 +1,239 @@
+#include "hal/dac.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace hal {
+
+// DAC channels in streaming mode, looked up by handle and channel from the HAL DMA callbacks
+struct DacStreamSlot {
+    DAC_HandleTypeDef* handle;
+    std::uint32_t channel;
+    void* dac;
+    void (*on_transfer)(void* dac, bool upper_half);
+};
+static constexpr std::size_t kMaxStreamingDacChannels = 2;
+static DacStreamSlot dac_stream_slots[kMaxStreamingDacChannels]{};
+
+static void RegisterStream(DAC_HandleTypeDef* handle, std::uint32_t channel, void* dac,
+                           void (*on_transfer)(void*, bool)) {
+    for (DacStreamSlot& slot : dac_stream_slots) {
+        if (slot.handle == nullptr || (slot.handle == handle && slot.channel == channel)) {
+            slot = {handle, channel, dac, on_transfer};
+            return;
+        }
+    }
+}
+
+static void UnregisterStream(DAC_HandleTypeDef* handle, std::uint32_t channel) {
+    for (DacStreamSlot& slot : dac_stream_slots) {
+        if (slot.handle == handle && slot.channel == channel) {
+            slot = {};
+        }
+    }
+}
+
+static void DispatchStream(DAC_HandleTypeDef* handle, std::uint32_t channel, bool upper_half) {
+    for (const DacStreamSlot& slot : dac_stream_slots) {
+        if (slot.handle == handle && slot.channel == channel) {
+            slot.on_transfer(slot.dac, upper_half);
+            return;
+        }
+    }
+}
+
+// MAMP settings indexed by bit count - 1 (the same field selects either generator's amplitude)
+static constexpr std::uint32_t kTriangleAmplitudes[] = {
+    DAC_TRIANGLEAMPLITUDE_1,   DAC_TRIANGLEAMPLITUDE_3,    DAC_TRIANGLEAMPLITUDE_7,    DAC_TRIANGLEAMPLITUDE_15,
+    DAC_TRIANGLEAMPLITUDE_31,  DAC_TRIANGLEAMPLITUDE_63,   DAC_TRIANGLEAMPLITUDE_127,  DAC_TRIANGLEAMPLITUDE_255,
+    DAC_TRIANGLEAMPLITUDE_511, DAC_TRIANGLEAMPLITUDE_1023, DAC_TRIANGLEAMPLITUDE_2047, DAC_TRIANGLEAMPLITUDE_4095,
+};
+static constexpr std::uint32_t kNoiseMasks[] = {
+    DAC_LFSRUNMASK_BIT0,    DAC_LFSRUNMASK_BITS1_0, DAC_LFSRUNMASK_BITS2_0,  DAC_LFSRUNMASK_BITS3_0,
+    DAC_LFSRUNMASK_BITS4_0, DAC_LFSRUNMASK_BITS5_0, DAC_LFSRUNMASK_BITS6_0,  DAC_LFSRUNMASK_BITS7_0,
+    DAC_LFSRUNMASK_BITS8_0, DAC_LFSRUNMASK_BITS9_0, DAC_LFSRUNMASK_BITS10_0, DAC_LFSRUNMASK_BITS11_0,
+};
+static constexpr unsigned kMaxWaveBits = std::size(kTriangleAmplitudes);
+
+void FillTriangle(std::uint16_t* table, std::size_t length, std::uint16_t low, std::uint16_t high) {
+    // Sample i sits min(i, length - i) steps from the start of the period
+    const std::size_t half = std::max<std::size_t>(length / 2, 1);
+    const std::int32_t span = static_cast<std::int32_t>(high) - static_cast<std::int32_t>(low);
+    for (std::size_t i = 0; i < length; ++i) {
+        const auto distance = static_cast<std::int32_t>(std::min(i, length - i));
+        table[i] = static_cast<std::uint16_t>(low + span * distance / static_cast<std::int32_t>(half));
+    }
+}
+
+bool Dac::SetSampleRate(std::uint32_t timer_hz, std::uint32_t sample_hz) {
+    if (timer_hz == 0 || sample_hz == 0) {
+        return false;
+    }
+
+    // Timer ticks per update (rounded), split into prescaler x auto-reload for a 16-bit timer
+    const std::uint64_t ticks = (static_cast<std::uint64_t>(timer_hz) + sample_hz / 2) / sample_hz;
+    if (ticks < 2) {
+        return false;
+    }
+    const std::uint64_t prescaler = (ticks - 1) / 0x10000;
+    const std::uint64_t period = (ticks + (prescaler + 1) / 2) / (prescaler + 1);
+    if (prescaler > 0xFFFF || period < 2) {
+        return false;
+    }
+
+    trigger_.Init.Prescaler = static_cast<std::uint32_t>(prescaler);
+    trigger_.Init.Period = static_cast<std::uint32_t>(period - 1);
+    __HAL_TIM_SET_PRESCALER(&trigger_, trigger_.Init.Prescaler);
+    __HAL_TIM_SET_AUTORELOAD(&trigger_, trigger_.Init.Period);
+    if (mode_ == Mode::Idle) {
+        // Both registers are preloaded; with the channel off, load them right away
+        trigger_.Instance->EGR = TIM_EGR_UG;
+    }
+    return true;
+}
+
+bool Dac::Start(std::uint16_t* buffer, std::size_t length) {
+    if (buffer == nullptr || length < 2 || length % 2 != 0 || length > 0xFFFF) {
+        return false;
+    }
+
+    Stop();
+
+    buffer_ = buffer;
+    length_ = length;
+    lower_swapped_ = false;
+    RegisterStream(&handle_, channel_, this, &Dac::OnTransferComplete);
+    if (HAL_DAC_Start_DMA(&handle_, channel_, reinterpret_cast<std::uint32_t*>(buffer), length, DAC_ALIGN_12B_R) !=
+        HAL_OK) {
+        UnregisterStream(&handle_, channel_);
+        return false;
+    }
+    mode_ = Mode::Stream;
+    return HAL_TIM_Base_Start(&trigger_) == HAL_OK;
+}
+
+bool Dac::QueueTable(const std::uint16_t* table, std::size_t length) {
+    if (mode_ != Mode::Stream || table == nullptr || table == buffer_ || length != length_ || IsTablePending()) {
+        return false;
+    }
+
+    lower_swapped_ = false;
+    pending_.store(table, std::memory_order_release);
+    return true;
+}
+
+bool Dac::StartTriangle(std::uint16_t base, unsigned amplitude_bits) {
+    return StartWave(Mode::Triangle, base, amplitude_bits);
+}
+
+bool Dac::StartNoise(std::uint16_t base, unsigned bits) {
+    return StartWave(Mode::Noise, base, bits);
+}
+
+bool Dac::SetValue(std::uint16_t code) {
+    if (code > kDacMaxCode) {
+        return false;
+    }
+
+    Stop();
+
+    if (HAL_DAC_SetValue(&handle_, channel_, DAC_ALIGN_12B_R, code) != HAL_OK ||
+        HAL_DAC_Start(&handle_, channel_) != HAL_OK) {
+        return false;
+    }
+    mode_ = Mode::Constant;
+    return HAL_TIM_Base_Start(&trigger_) == HAL_OK;
+}
+
+void Dac::Stop() {
+    HAL_TIM_Base_Stop(&trigger_);
+    if (mode_ == Mode::Stream) {
+        HAL_DAC_Stop_DMA(&handle_, channel_);
+        UnregisterStream(&handle_, channel_);
+    } else if (mode_ != Mode::Idle) {
+        HAL_DAC_Stop(&handle_, channel_);
+    }
+    SetWaveGeneration(Mode::Idle, 0);
+    pending_.store(nullptr, std::memory_order_release);
+    mode_ = Mode::Idle;
+}
+
+void Dac::Mute() {
+    // A streaming channel's DMA stays enabled but gets no more requests; HAL_DAC_Stop_DMA() tidies it up later
+    const std::uint32_t shift = channel_ & 0x10U;
+    handle_.Instance->CR = handle_.Instance->CR & ~((DAC_CR_DMAEN1 | DAC_CR_WAVE1 | DAC_CR_MAMP1) << shift);
+    ((channel_ == DAC_CHANNEL_1) ? handle_.Instance->DHR12R1 : handle_.Instance->DHR12R2) = 0;
+}
+
+bool Dac::StartWave(Mode mode, std::uint16_t base, unsigned bits) {
+    if (bits == 0 || bits > kMaxWaveBits || base + ((1U << bits) - 1U) > kDacMaxCode) {
+        return false;
+    }
+
+    Stop();
+
+    // The generator adds its counter to the held code on every trigger
+    SetWaveGeneration(mode, bits);
+    if (HAL_DAC_SetValue(&handle_, channel_, DAC_ALIGN_12B_R, base) != HAL_OK ||
+        HAL_DAC_Start(&handle_, channel_) != HAL_OK) {
+        SetWaveGeneration(Mode::Idle, 0);
+        return false;
+    }
+    mode_ = mode;
+    return HAL_TIM_Base_Start(&trigger_) == HAL_OK;
+}
+
+void Dac::SetWaveGeneration(Mode mode, unsigned bits) {
+    switch (mode) {
+        case Mode::Triangle: HAL_DACEx_TriangleWaveGenerate(&handle_, channel_, kTriangleAmplitudes[bits - 1]); break;
+        case Mode::Noise:    HAL_DACEx_NoiseWaveGenerate(&handle_, channel_, kNoiseMasks[bits - 1]); break;
+        default:
+            // The HAL has no call to turn the generators off; clear WAVEx/MAMPx directly
+            handle_.Instance->CR = handle_.Instance->CR & ~((DAC_CR_WAVE1 | DAC_CR_MAMP1) << (channel_ & 0x10U));
+            break;
+    }
+}
+
+void Dac::OnTransfer(bool upper_half) {
+    const std::uint16_t* table = pending_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        return;
+    }
+
+    // DMA has just moved on to the other half, so the one it finished can be rewritten.
+    // The lower half goes first; the upper half follows one half-period later, once DMA
+    // has wrapped around and is already playing the new lower half.
+    const std::size_t half = length_ / 2;
+    if (!upper_half) {
+        std::memcpy(buffer_, table, half * sizeof(std::uint16_t));
+        lower_swapped_ = true;
+    } else if (lower_swapped_) {
+        std::memcpy(buffer_ + half, table + half, half * sizeof(std::uint16_t));
+        lower_swapped_ = false;
+        pending_.store(nullptr, std::memory_order_release);
+    }
+}
+
+void Dac::OnTransferComplete(void* self, bool upper_half) {
+    static_cast<Dac*>(self)->OnTransfer(upper_half);
+}
+
+}  // namespace hal
+
+// Override the HAL's weak callbacks
+extern "C" void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef* hdac) {
+    hal::DispatchStream(hdac, DAC_CHANNEL_1, false);
+}
+
+extern "C" void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef* hdac) {
+    hal::DispatchStream(hdac, DAC_CHANNEL_1, true);
+}
+
+extern "C" void HAL_DACEx_ConvHalfCpltCallbackCh2(DAC_HandleTypeDef* hdac) {
+    hal::DispatchStream(hdac, DAC_CHANNEL_2, false);
+}
+
+extern "C" void HAL_DACEx_ConvCpltCallbackCh2(DAC_HandleTypeDef* hdac) {
+    hal::DispatchStream(hdac, DAC_CHANNEL_2, true);
+}
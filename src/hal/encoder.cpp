@@ -0,0 +1,44 @@
+#include "hal/encoder.hpp"
+
+namespace hal {
+
+void EncoderTracker::Reset(uint32_t raw_count, uint32_t timestamp_us, int64_t position) {
+    last_raw_ = raw_count;
+    position_ = position;
+    velocity_ = 0;
+    window_start_us_ = timestamp_us;
+    window_counts_ = 0;
+}
+
+void EncoderTracker::Update(uint32_t raw_count, uint32_t timestamp_us) {
+    // Signed difference of two 32-bit counts is correct across counter wrap-around
+    const int32_t delta = static_cast<int32_t>(raw_count - last_raw_);
+    last_raw_ = raw_count;
+    position_ += delta;
+    window_counts_ += delta;
+
+    const uint32_t window_us = timestamp_us - window_start_us_;
+    const int32_t magnitude = (window_counts_ < 0) ? -window_counts_ : window_counts_;
+    if (window_us == 0 || (magnitude < kMinWindowCounts && window_us < kMaxWindowUs)) {
+        return;
+    }
+
+    velocity_ = static_cast<int32_t>(static_cast<int64_t>(window_counts_) * 1'000'000 / window_us);
+    window_start_us_ = timestamp_us;
+    window_counts_ = 0;
+}
+
+bool Encoder::Start(uint32_t timestamp_us) {
+    if (HAL_TIM_Encoder_Start(&handle_, TIM_CHANNEL_ALL) != HAL_OK) {
+        return false;
+    }
+
+    tracker_.Reset(ReadRaw(), timestamp_us);
+    return true;
+}
+
+void Encoder::Stop() {
+    HAL_TIM_Encoder_Stop(&handle_, TIM_CHANNEL_ALL);
+}
+
+}  // namespace hal
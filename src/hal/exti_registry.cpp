@@ -1,5 +1,7 @@
 #include <stm32l4xx_hal.h>
 
+#include "hal/exti.hpp"
+
 // Array to hold callbacks for all 16 EXTI lines (0-15)
 static void (*exti_callbacks[16])(void){};
 
@@ -10,6 +12,20 @@ void RegisterExtiCallback(uint8_t index, void (*cb)(void)) {
         exti_callbacks[index] = cb;
     }
 }
+
+// Services lines that have no compile-time binding (see ExtiDispatcher)
+void DispatchExtiRuntime(uint32_t pending) {
+    EXTI->PR1 = pending;  // write-1-to-clear
+
+    while (pending != 0) {
+        // __builtin_ctz returns the number of trailing zeros (GCC intrinsic)
+        const uint32_t index = __builtin_ctz(pending);
+        if (exti_callbacks[index] != nullptr) {
+            exti_callbacks[index]();  // Call the registered function
+        }
+        pending &= pending - 1;
+    }
+}
 }  // namespace hal::detail
 
 // Override the HAL's weak callback
@@ -23,3 +39,26 @@ extern "C" void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
         exti_callbacks[index]();  // Call the registered function
     }
 }
+
+// Runtime-only EXTI vectors. AWB_EXTI_DISPATCH() replaces these with inline dispatch.
+extern "C" [[gnu::weak]] void EXTI0_IRQHandler(void) {
+    hal::detail::DispatchExtiRuntime(EXTI->PR1 & GPIO_PIN_0);
+}
+extern "C" [[gnu::weak]] void EXTI1_IRQHandler(void) {
+    hal::detail::DispatchExtiRuntime(EXTI->PR1 & GPIO_PIN_1);
+}
+extern "C" [[gnu::weak]] void EXTI2_IRQHandler(void) {
+    hal::detail::DispatchExtiRuntime(EXTI->PR1 & GPIO_PIN_2);
+}
+extern "C" [[gnu::weak]] void EXTI3_IRQHandler(void) {
+    hal::detail::DispatchExtiRuntime(EXTI->PR1 & GPIO_PIN_3);
+}
+extern "C" [[gnu::weak]] void EXTI4_IRQHandler(void) {
+    hal::detail::DispatchExtiRuntime(EXTI->PR1 & GPIO_PIN_4);
+}
+extern "C" [[gnu::weak]] void EXTI9_5_IRQHandler(void) {
+    hal::detail::DispatchExtiRuntime(EXTI->PR1 & hal::detail::kExti9_5Lines);
+}
+extern "C" [[gnu::weak]] void EXTI15_10_IRQHandler(void) {
+    hal::detail::DispatchExtiRuntime(EXTI->PR1 & hal::detail::kExti15_10Lines);
+}
@@ -0,0 +1,50 @@
+#include "hal/flash.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hal {
+
+const std::uint8_t* FlashPage::Data() const {
+#ifdef AWB_SIM_HAL
+    return sim::FlashMemory(address_);
+#else
+    return reinterpret_cast<const std::uint8_t*>(address_);
+#endif
+}
+
+std::expected<void, awb::Error> FlashPage::Write(const void* data, std::size_t size) {
+    const std::uintptr_t offset = address_ - FLASH_BASE;
+    if (address_ < FLASH_BASE || (offset % kSize) != 0 || offset >= 2 * FLASH_BANK_SIZE || size > kSize ||
+        (data == nullptr && size != 0)) {
+        return std::unexpected(awb::Error::InvalidParam);
+    }
+
+    FLASH_EraseInitTypeDef erase = {};
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = (offset < FLASH_BANK_SIZE) ? FLASH_BANK_1 : FLASH_BANK_2;
+    erase.Page = static_cast<std::uint32_t>((offset % FLASH_BANK_SIZE) / kSize);
+    erase.NbPages = 1;
+    std::uint32_t page_error = 0;
+
+    HAL_FLASH_Unlock();
+    // Stale error flags (e.g. from a debugger session) make the next operation fail
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    bool ok = HAL_FLASHEx_Erase(&erase, &page_error) == HAL_OK;
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t done = 0; ok && done < size; done += sizeof(std::uint64_t)) {
+        // A short tail is padded with the erased value
+        std::uint64_t word = ~0ULL;
+        std::memcpy(&word, bytes + done, std::min(sizeof(word), size - done));
+        ok = HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address_ + done, word) == HAL_OK;
+    }
+    HAL_FLASH_Lock();
+
+    if (!ok) {
+        return std::unexpected(awb::Error::FlashFailure);
+    }
+    return {};
+}
+
+}  // namespace hal
@@ -0,0 +1,137 @@
+#include "hal/power.hpp"
+
+namespace hal {
+namespace {
+// RTCCLK (LSE, 32768 Hz) / 16
+constexpr uint32_t kWakeupTimerHz = 2048;
+constexpr uint32_t kMsPerDay = 24U * 60U * 60U * 1000U;
+constexpr uint32_t kHsiMhz = HSI_VALUE / 1'000'000U;
+}  // namespace
+
+PowerManager& PowerManager::GetInstance() {
+    static PowerManager instance;
+    return instance;
+}
+
+void PowerManager::Init(RTC_HandleTypeDef* rtc) {
+    rtc_ = rtc;
+
+    // Read the counters directly: after STOP2 the shadow registers would need
+    // up to two RTCCLK periods (61 us) to resynchronize
+    HAL_RTCEx_EnableBypassShadow(rtc_);
+
+    // Wake on HSI16 (the PLL source) rather than MSI so RestoreClocks() only restarts the PLL
+    __HAL_RCC_WAKEUPSTOP_CLK_CONFIG(RCC_STOP_WAKEUPCLOCK_HSI);
+}
+
+bool PowerManager::AddHooks(const LowPowerHooks& hooks) {
+    if (hook_count_ >= kMaxHooks) {
+        return false;
+    }
+
+    hooks_[hook_count_++] = hooks;
+    return true;
+}
+
+std::expected<uint32_t, awb::Error> PowerManager::Sleep(uint32_t max_ms) {
+    if (!IsStopAllowed() || max_ms < kMinStopMs) {
+        __WFI();
+        return 0;
+    }
+    if (max_ms > kMaxStopMs) {
+        max_ms = kMaxStopMs;
+    }
+
+    for (std::size_t i = 0; i < hook_count_; ++i) {
+        if (hooks_[i].suspend != nullptr) {
+            hooks_[i].suspend();
+        }
+    }
+
+    const uint32_t wakeup_counter = max_ms * kWakeupTimerHz / 1000U - 1U;
+    if (HAL_RTCEx_SetWakeUpTimer_IT(rtc_, wakeup_counter, RTC_WAKEUPCLOCK_RTCCLK_DIV16) != HAL_OK) {
+        for (std::size_t i = hook_count_; i-- > 0;) {
+            if (hooks_[i].resume != nullptr) {
+                hooks_[i].resume();
+            }
+        }
+        return std::unexpected(awb::Error::Timeout);
+    }
+
+    // With PRIMASK set a pending interrupt still ends WFI, but its handler only
+    // runs once the clocks are back at full speed
+    __disable_irq();
+    const uint32_t rtc_before = ReadRtcMs();
+    HAL_SuspendTick();
+
+    HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+
+    const uint32_t wake_cycles = DWT->CYCCNT;
+    const uint32_t pll_cycles = RestoreClocks();
+
+    const bool timer_expired = __HAL_RTC_WAKEUPTIMER_GET_FLAG(rtc_, RTC_FLAG_WUTF) != 0U;
+    const uint32_t slept_ms = (ReadRtcMs() + kMsPerDay - rtc_before) % kMsPerDay;
+    uwTick = uwTick + slept_ms;
+    HAL_ResumeTick();
+    __enable_irq();
+
+    // Polls WUTWF against HAL_GetTick(), so only once the tick is running again
+    HAL_RTCEx_DeactivateWakeUpTimer(rtc_);
+
+    for (std::size_t i = hook_count_; i-- > 0;) {
+        if (hooks_[i].resume != nullptr) {
+            hooks_[i].resume();
+        }
+    }
+
+    // The core ran on HSI16 until the PLL switch and at SystemCoreClock after it
+    const uint32_t ready_cycles = DWT->CYCCNT;
+    const uint32_t latency_us =
+        (pll_cycles - wake_cycles) / kHsiMhz + (ready_cycles - pll_cycles) / (SystemCoreClock / 1'000'000U);
+
+    stats_.stop_entries++;
+    stats_.stop_ms += slept_ms;
+    stats_.last_wake_latency_us = latency_us;
+    if (latency_us > stats_.max_wake_latency_us) {
+        stats_.max_wake_latency_us = latency_us;
+    }
+    stats_.last_wake_source = timer_expired ? WakeSource::Timer : WakeSource::Interrupt;
+
+    return slept_ms;
+}
+
+uint32_t PowerManager::ReadRtcMs() const {
+    // Shadow registers are bypassed, so sample until two consecutive reads agree
+    uint32_t ssr;
+    uint32_t tr;
+    do {
+        ssr = rtc_->Instance->SSR;
+        tr = rtc_->Instance->TR;
+    } while (ssr != rtc_->Instance->SSR || tr != rtc_->Instance->TR);
+
+    const uint32_t hours = RTC_Bcd2ToByte(static_cast<uint8_t>((tr & (RTC_TR_HT | RTC_TR_HU)) >> RTC_TR_HU_Pos));
+    const uint32_t minutes = RTC_Bcd2ToByte(static_cast<uint8_t>((tr & (RTC_TR_MNT | RTC_TR_MNU)) >> RTC_TR_MNU_Pos));
+    const uint32_t seconds = RTC_Bcd2ToByte(static_cast<uint8_t>((tr & (RTC_TR_ST | RTC_TR_SU)) >> RTC_TR_SU_Pos));
+
+    // SSR counts down from PREDIV_S once per second
+    const uint32_t prediv_s = rtc_->Init.SynchPrediv;
+    const uint32_t sub_ms = (prediv_s - (ssr & RTC_SSR_SS)) * 1000U / (prediv_s + 1U);
+
+    return ((hours * 60U + minutes) * 60U + seconds) * 1000U + sub_ms;
+}
+
+uint32_t PowerManager::RestoreClocks() {
+    // Flash latency, voltage range and the PLL configuration survive STOP2,
+    // so restarting the PLL and switching SYSCLK back is all that is needed
+    __HAL_RCC_PLL_ENABLE();
+    while (__HAL_RCC_GET_FLAG(RCC_FLAG_PLLRDY) == 0U) {
+    }
+
+    __HAL_RCC_SYSCLK_CONFIG(RCC_SYSCLKSOURCE_PLLCLK);
+    while (__HAL_RCC_GET_SYSCLK_SOURCE() != RCC_SYSCLKSOURCE_STATUS_PLLCLK) {
+    }
+
+    return DWT->CYCCNT;
+}
+
+}  // namespace hal
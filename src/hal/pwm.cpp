@@ -0,0 +1,45 @@
+#include "hal/pwm.hpp"
+
+namespace hal {
+
+bool Pwm::Configure(std::uint8_t dead_time) {
+    const std::uint32_t mode = handle_.Init.CounterMode;
+    if (mode != TIM_COUNTERMODE_CENTERALIGNED1 && mode != TIM_COUNTERMODE_CENTERALIGNED2 &&
+        mode != TIM_COUNTERMODE_CENTERALIGNED3) {
+        return false;
+    }
+    if (handle_.Init.ClockDivision != TIM_CLOCKDIVISION_DIV1) {
+        return false;
+    }
+
+    TIM_TypeDef* const tim = handle_.Instance;
+    constexpr std::uint32_t kOutputs = TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC1NE | TIM_CCER_CC1NP |
+                                       TIM_CCER_CC2E | TIM_CCER_CC2P | TIM_CCER_CC2NE | TIM_CCER_CC2NP |
+                                       TIM_CCER_CC3E | TIM_CCER_CC3P | TIM_CCER_CC3NE | TIM_CCER_CC3NP;
+
+    // Outputs off before anything changes. The dead time and off-state bits stay
+    // writable because CubeMX leaves the lock off (TIM_LOCKLEVEL_OFF).
+    tim->BDTR &= ~TIM_BDTR_MOE;
+    tim->CCER &= ~kOutputs;
+    tim->BDTR = (tim->BDTR & ~(TIM_BDTR_DTG | TIM_BDTR_BKE | TIM_BDTR_AOE)) | TIM_BDTR_OSSR | TIM_BDTR_OSSI |
+                (static_cast<std::uint32_t>(dead_time) << TIM_BDTR_DTG_Pos);
+    tim->CR2 &= ~(TIM_CR2_OIS1 | TIM_CR2_OIS1N | TIM_CR2_OIS2 | TIM_CR2_OIS2N | TIM_CR2_OIS3 | TIM_CR2_OIS3N);
+
+    // Zero duty straight into the active compares, then PWM mode 1 with preload
+    tim->CCMR1 &= ~(TIM_CCMR1_OC1PE | TIM_CCMR1_OC2PE);
+    tim->CCMR2 &= ~TIM_CCMR2_OC3PE;
+    tim->CCR1 = 0;
+    tim->CCR2 = 0;
+    tim->CCR3 = 0;
+    tim->CCMR1 = (tim->CCMR1 & ~(TIM_CCMR1_CC1S | TIM_CCMR1_OC1M | TIM_CCMR1_CC2S | TIM_CCMR1_OC2M)) |
+                 TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE | TIM_CCMR1_OC2M_2 | TIM_CCMR1_OC2M_1 |
+                 TIM_CCMR1_OC2PE;
+    tim->CCMR2 = (tim->CCMR2 & ~(TIM_CCMR2_CC3S | TIM_CCMR2_OC3M)) | TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1 |
+                 TIM_CCMR2_OC3PE;
+
+    // Active-high pairs; with MOE clear and OSSI set they sit at their idle level (low)
+    tim->CCER |= TIM_CCER_CC1E | TIM_CCER_CC1NE | TIM_CCER_CC2E | TIM_CCER_CC2NE | TIM_CCER_CC3E | TIM_CCER_CC3NE;
+    return true;
+}
+
+}  // namespace hal
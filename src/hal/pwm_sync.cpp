@@ -0,0 +1,32 @@
+#include "hal/pwm_sync.hpp"
+
+namespace hal {
+
+bool PwmSync::Start(const PwmSyncTiming& timing) {
+    const std::uint32_t mode = handle_.Init.CounterMode;
+    if (mode != TIM_COUNTERMODE_CENTERALIGNED1 && mode != TIM_COUNTERMODE_CENTERALIGNED2 &&
+        mode != TIM_COUNTERMODE_CENTERALIGNED3) {
+        return false;
+    }
+    if (timing.period < 2 || timing.trigger_compare == 0 || timing.trigger_compare >= timing.period) {
+        return false;
+    }
+
+    Stop();
+
+    timing_ = timing;
+    handle_.Init.Period = timing.period;
+    __HAL_TIM_SET_AUTORELOAD(&handle_, timing.period);
+    __HAL_TIM_SET_COMPARE(&handle_, TIM_CHANNEL_4, timing.trigger_compare);
+    __HAL_TIM_SET_COUNTER(&handle_, 0);
+    // Load the preloaded period and compares, and the repetition counter, so the
+    // first period already runs with them and update events fall on the peaks
+    handle_.Instance->EGR = TIM_EGR_UG;
+    return HAL_TIM_PWM_Start(&handle_, TIM_CHANNEL_4) == HAL_OK;
+}
+
+void PwmSync::Stop() {
+    HAL_TIM_PWM_Stop(&handle_, TIM_CHANNEL_4);
+}
+
+}  // namespace hal
@@ -1,10 +1,76 @@
 #include "hal/uart.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
 namespace hal {
 
+// UARTs transmitting (UartMode::Dma) or receiving (StartReceive()) by DMA, looked up by handle from the HAL callbacks
+static constexpr std::size_t kMaxDmaUarts = 4;
+static Uart* dma_uarts[kMaxDmaUarts]{};
+
+static bool RegisterDmaUart(Uart* uart) {
+    if (std::find(std::begin(dma_uarts), std::end(dma_uarts), uart) != std::end(dma_uarts)) {
+        return true;
+    }
+    for (Uart*& slot : dma_uarts) {
+        if (slot == nullptr) {
+            slot = uart;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void UnregisterDmaUart(const Uart* uart) {
+    std::replace(std::begin(dma_uarts), std::end(dma_uarts), const_cast<Uart*>(uart), static_cast<Uart*>(nullptr));
+}
+
+static Uart* FindDmaUart(const UART_HandleTypeDef* huart) {
+    for (Uart* uart : dma_uarts) {
+        if (uart != nullptr && uart->GetHandle() == huart) {
+            return uart;
+        }
+    }
+    return nullptr;
+}
+
+Uart::Uart(UART_HandleTypeDef& huart, UartMode mode) : huart_(huart), mode_(mode) {
+    // No free slot: the TX callbacks could never find us, so stay blocking
+    if (mode_ == UartMode::Dma && !RegisterDmaUart(this)) {
+        mode_ = UartMode::Blocking;
+    }
+}
+
+Uart::~Uart() {
+    StopReceive();
+    if (tx_in_flight_ != 0) {
+        HAL_UART_AbortTransmit(&huart_);
+    }
+    UnregisterDmaUart(this);
+}
+
 void Uart::Write(const uint8_t* data, size_t len) {
     if (len == 0) return;
-    HAL_UART_Transmit(&huart_, data, len, 100);
+
+    if (!IsDmaMode()) {
+        HAL_UART_Transmit(&huart_, data, len, 100);
+        return;
+    }
+
+    const std::size_t written = tx_ring_.Push(data, len);
+    if (written < len) {
+        dropped_bytes_.fetch_add(len - written, std::memory_order_relaxed);
+    }
+
+    // Mask interrupts so the TX-complete ISR cannot chain the same chunk while we kick an idle channel
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (tx_in_flight_ == 0) {
+        StartNextTransfer();
+    }
+    __set_PRIMASK(primask);
 }
 
 bool Uart::Read(uint8_t* buffer, size_t len, uint32_t timeout) {
@@ -13,4 +79,161 @@ bool Uart::Read(uint8_t* buffer, size_t len, uint32_t timeout) {
     return HAL_UART_Receive(&huart_, buffer, len, timeout) == HAL_OK;
 }
 
+bool Uart::StartReceive(uint8_t* buffer, size_t length,
+                        void (*on_frame)(void* context, const uint8_t* frame, size_t length), void* context) {
+    if (buffer == nullptr || length < 2 || length > UINT16_MAX || on_frame == nullptr) {
+        return false;
+    }
+    // In normal mode the DMA would stop at the end of the ring
+    if (huart_.hdmarx == nullptr || huart_.hdmarx->Init.Mode != DMA_CIRCULAR || !RegisterDmaUart(this)) {
+        return false;
+    }
+
+    StopReceive();
+
+    rx_buffer_ = buffer;
+    rx_length_ = length;
+    on_frame_ = on_frame;
+    frame_context_ = context;
+    return RestartReceive();
+}
+
+void Uart::StopReceive() {
+    if (rx_buffer_ == nullptr) {
+        return;
+    }
+
+    HAL_UART_AbortReceive(&huart_);
+    rx_buffer_ = nullptr;
+    rx_length_ = 0;
+    on_frame_ = nullptr;
+}
+
+UartRxStats Uart::GetRxStats() const {
+    // Every counter is a single 32-bit store in the interrupt, so no field can be torn
+    std::atomic_signal_fence(std::memory_order_acquire);
+    return rx_stats_;
+}
+
+bool Uart::Flush(uint32_t timeout) {
+    const uint32_t start = HAL_GetTick();
+    while (tx_in_flight_ != 0 || !tx_ring_.Empty()) {
+        if (HAL_GetTick() - start >= timeout) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Uart::OnTxHalfComplete() {
+    // DMA has already read the first half, so the producer may reuse it
+    const std::size_t half = tx_in_flight_ / 2;
+    tx_ring_.Consume(half);
+    tx_released_ = half;
+}
+
+void Uart::OnTxComplete() {
+    tx_ring_.Consume(tx_in_flight_ - tx_released_);
+    StartNextTransfer();
+}
+
+void Uart::OnRxEvent(size_t position, bool idle) {
+    if (rx_buffer_ == nullptr || position > rx_length_) {
+        return;
+    }
+
+    // DMA has written up to position; if it wrapped since the last event, take the end of the ring first
+    if (position < rx_tail_) {
+        AppendToFrame(rx_buffer_ + rx_tail_, rx_length_ - rx_tail_);
+        rx_tail_ = 0;
+    }
+    AppendToFrame(rx_buffer_ + rx_tail_, position - rx_tail_);
+    rx_tail_ = (position == rx_length_) ? 0 : position;
+
+    if (!idle || frame_length_ == 0) {
+        return;
+    }
+
+    ++rx_stats_.frames;
+    rx_stats_.bytes += frame_length_;
+    if (frame_truncated_) {
+        ++rx_stats_.truncated;
+    }
+    on_frame_(frame_context_, frame_, frame_length_);
+    frame_length_ = 0;
+    frame_truncated_ = false;
+}
+
+void Uart::OnError() {
+    const uint32_t errors = huart_.ErrorCode;
+    if ((errors & HAL_UART_ERROR_ORE) != 0) ++rx_stats_.overruns;
+    if ((errors & HAL_UART_ERROR_FE) != 0) ++rx_stats_.framing_errors;
+    if ((errors & HAL_UART_ERROR_NE) != 0) ++rx_stats_.noise_errors;
+    if ((errors & HAL_UART_ERROR_PE) != 0) ++rx_stats_.parity_errors;
+
+    // With RX DMA (DMAR) every error is blocking: the HAL has already ended reception and aborted the DMA
+    if (rx_buffer_ != nullptr && huart_.RxState == HAL_UART_STATE_READY) {
+        RestartReceive();
+    }
+}
+
+bool Uart::RestartReceive() {
+    rx_tail_ = 0;
+    frame_length_ = 0;
+    frame_truncated_ = false;
+    return HAL_UARTEx_ReceiveToIdle_DMA(&huart_, rx_buffer_, static_cast<uint16_t>(rx_length_)) == HAL_OK;
+}
+
+void Uart::AppendToFrame(const uint8_t* data, size_t len) {
+    const size_t count = std::min(len, kRxFrameSize - frame_length_);
+    std::memcpy(frame_ + frame_length_, data, count);
+    frame_length_ += count;
+    frame_truncated_ = frame_truncated_ || count < len;
+}
+
+void Uart::StartNextTransfer() {
+    const auto chunk = tx_ring_.PeekContiguous();
+    if (chunk.empty()) {
+        tx_in_flight_ = 0;
+        return;
+    }
+
+    // HAL transfer sizes are 16-bit
+    const std::size_t len = std::min<std::size_t>(chunk.size(), UINT16_MAX);
+    tx_in_flight_ = len;
+    tx_released_ = 0;
+
+    if (HAL_UART_Transmit_DMA(&huart_, chunk.data(), len) != HAL_OK) {
+        // Drop the chunk rather than wedging the ring; the next Write() retries
+        tx_ring_.Consume(len);
+        dropped_bytes_.fetch_add(len, std::memory_order_relaxed);
+        tx_in_flight_ = 0;
+    }
+}
+
 }  // namespace hal
+
+// Override the HAL's weak callbacks
+extern "C" void HAL_UART_TxHalfCpltCallback(UART_HandleTypeDef* huart) {
+    if (hal::Uart* uart = hal::FindDmaUart(huart)) {
+        uart->OnTxHalfComplete();
+    }
+}
+
+extern "C" void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart) {
+    if (hal::Uart* uart = hal::FindDmaUart(huart)) {
+        uart->OnTxComplete();
+    }
+}
+
+extern "C" void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t Size) {
+    if (hal::Uart* uart = hal::FindDmaUart(huart)) {
+        uart->OnRxEvent(Size, HAL_UARTEx_GetRxEventType(huart) == HAL_UART_RXEVENT_IDLE);
+    }
+}
+
+extern "C" void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart) {
+    if (hal::Uart* uart = hal::FindDmaUart(huart)) {
+        uart->OnError();
+    }
+}
@@ -0,0 +1,90 @@
+#include "util/benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+
+#include "util/logger.hpp"
+
+namespace awb {
+
+// Called through the same pointer path as a real body to measure timing overhead
+[[gnu::noinline]] static void EmptyBody() {
+    asm volatile("");
+}
+
+[[gnu::noinline]] static uint32_t TimeCall(void (*body)()) {
+    const uint32_t start = BenchClock::Now();
+    body();
+    return BenchClock::Now() - start;
+}
+
+static uint32_t MeasureOverhead() {
+    uint32_t overhead = UINT32_MAX;
+    for (std::size_t i = 0; i < Benchmark::kMaxIterations; ++i) {
+        overhead = std::min(overhead, TimeCall(&EmptyBody));
+    }
+    return overhead;
+}
+
+Benchmark::Benchmark(const char* name, void (*body)(), const BenchFixture& fixture)
+    : name_(name), body_(body), fixture_(fixture) {
+    if (tail_ == nullptr) {
+        head_ = this;
+    } else {
+        tail_->next_ = this;
+    }
+    tail_ = this;
+}
+
+BenchResult Benchmark::Run(uint32_t iterations) const {
+    iterations = std::clamp<uint32_t>(iterations, 1, kMaxIterations);
+    const uint32_t overhead = MeasureOverhead();
+
+    if (fixture_.setup != nullptr) {
+        fixture_.setup();
+    }
+
+    std::array<uint32_t, kMaxIterations> samples{};
+    for (uint32_t i = 0; i < iterations; ++i) {
+        if (fixture_.before_each != nullptr) {
+            fixture_.before_each();
+        }
+        const uint32_t elapsed = TimeCall(body_);
+        samples[i] = elapsed > overhead ? elapsed - overhead : 0;
+    }
+
+    if (fixture_.teardown != nullptr) {
+        fixture_.teardown();
+    }
+
+    const auto first = samples.begin();
+    const auto last = samples.begin() + iterations;
+    const auto middle = first + iterations / 2;
+    std::nth_element(first, middle, last);
+
+    return {
+        .iterations = iterations,
+        .min = *std::min_element(first, last),
+        .median = *middle,
+        .max = *std::max_element(first, last),
+    };
+}
+
+std::size_t RunBenchmarks(Logger& logger, uint32_t iterations) {
+    BenchClock::Init();
+
+    // Formatted directly (not AWB_LOGF) so the report stays text in every build
+    logger.Logf("BENCH,name,unit,iterations,min,median,max\r\n");
+
+    std::size_t count = 0;
+    for (const Benchmark* bench = Benchmark::First(); bench != nullptr; bench = bench->Next()) {
+        const BenchResult result = bench->Run(iterations);
+        logger.Logf("BENCH,%s,%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\r\n", bench->GetName(),
+                    BenchClock::kUnit, result.iterations, result.min, result.median, result.max);
+        count++;
+    }
+    return count;
+}
+
+}  // namespace awb
@@ -60,7 +60,7 @@ void Logger::LogBuffer(const uint32_t* data, size_t length) {
 
 // TODO: Maybe want to template this? Make an unsigned version?
 void Logger::Plot(const char* name, long value) {
-    Logf(">%s:%" PRIi32 "\r\n", name, value);
+    Logf(">%s:%ld\r\n", name, value);
 }
 
 void Logger::Clear() {
@@ -0,0 +1,25 @@
+#include "util/telemetry.hpp"
+
+#include "util/cobs.hpp"
+#include "util/crc.hpp"
+
+namespace awb::telemetry {
+
+void Send(Logger& logger, std::uint8_t* packet, std::size_t length) {
+    if (length > kMaxPacketSize) {
+        return;
+    }
+    const std::uint16_t crc = Crc16(packet, length);
+    packet[length++] = static_cast<std::uint8_t>(crc);
+    packet[length++] = static_cast<std::uint8_t>(crc >> 8);
+
+    // Leading zero too: it ends whatever partial frame a receiver may have been holding
+    std::uint8_t frame[CobsMaxEncodedSize(kMaxPacketSize + 2) + 2];
+    std::size_t size = 0;
+    frame[size++] = 0;
+    size += CobsEncode(packet, length, &frame[size]);
+    frame[size++] = 0;
+    logger.Write(reinterpret_cast<const char*>(frame), size);
+}
+
+}  // namespace awb::telemetry
@@ -0,0 +1,127 @@
+// ADC loopback calibration: ComputeAdcCalibration() on synthetic 12-bit transfers
+// (33-step sweeps like the default one), and the flash record round trip.
+
+#include <unity.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "board_defs.hpp"
+#include "hal/adc_calibration.hpp"
+#include "hal/dac.hpp"
+#include "hal/flash.hpp"
+#include "sim_hal.hpp"
+
+namespace {
+
+using Transfer = std::uint32_t (*)(std::uint32_t code);
+
+std::array<hal::LoopbackPoint, 33> MakeSweep(Transfer transfer) {
+    std::array<hal::LoopbackPoint, 33> points{};
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const std::uint32_t code = std::min<std::uint32_t>(static_cast<std::uint32_t>(i) * 128, hal::kDacMaxCode);
+        points[i] = {code, transfer(code)};
+    }
+    return points;
+}
+
+std::expected<hal::AdcCalibration, awb::Error> Fit(Transfer transfer) {
+    const auto points = MakeSweep(transfer);
+    return hal::ComputeAdcCalibration(points.data(), points.size(), 12);
+}
+
+// Largest correction error over every raw code that the sweep covered
+std::uint32_t WorstError(Transfer transfer) {
+    const auto calibration = Fit(transfer);
+    if (!calibration.has_value()) {
+        return ~0U;
+    }
+    std::uint32_t worst = 0;
+    for (std::uint32_t code = 128; code <= 3968; ++code) {
+        const std::uint32_t corrected = calibration->Apply(transfer(code));
+        worst = std::max(worst, corrected > code ? corrected - code : code - corrected);
+    }
+    return worst;
+}
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    sim::EraseFlash();
+}
+
+void tearDown() {}
+
+void test_ideal_converter_passes_through() {
+    TEST_ASSERT_EQUAL_UINT32(0, WorstError([](std::uint32_t code) { return code; }));
+}
+
+void test_corrects_gain_and_offset() {
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, WorstError([](std::uint32_t code) { return code * 1010 / 1000 + 12; }));
+}
+
+void test_corrects_bowed_transfer() {
+    // Bowed by up to 8 codes mid-scale (INL)
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, WorstError([](std::uint32_t code) {
+                                         return code + 8 * code * (4095 - code) / (2048 * 2048);
+                                     }));
+}
+
+void test_ignores_readings_clipped_at_rail() {
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(
+        1, WorstError([](std::uint32_t code) { return std::min<std::uint32_t>(code + 40, 4095); }));
+}
+
+void test_rejects_disconnected_input() {
+    TEST_ASSERT_FALSE(Fit([](std::uint32_t) { return 0U; }).has_value());
+}
+
+void test_rejects_floating_input() {
+    TEST_ASSERT_FALSE(Fit([](std::uint32_t code) { return 2048 + (code * 7919) % 512; }).has_value());
+}
+
+void test_record_round_trips_through_flash() {
+    hal::FlashPage page(board::flash::kCalibrationPage);
+    TEST_ASSERT_FALSE(hal::LoadAdcCalibration(page).has_value());
+
+    const auto calibration = Fit([](std::uint32_t code) { return code * 1010 / 1000 + 12; });
+    TEST_ASSERT_TRUE(calibration.has_value());
+    TEST_ASSERT_TRUE(hal::SaveAdcCalibration(page, *calibration).has_value());
+
+    const auto loaded = hal::LoadAdcCalibration(page);
+    TEST_ASSERT_TRUE(loaded.has_value());
+    for (std::uint32_t raw = 0; raw <= 4095; raw += 13) {
+        TEST_ASSERT_EQUAL_UINT32(calibration->Apply(raw), loaded->Apply(raw));
+    }
+}
+
+void test_rejects_corrupted_record() {
+    hal::FlashPage page(board::flash::kCalibrationPage);
+    auto calibration = Fit([](std::uint32_t code) { return code; });
+    TEST_ASSERT_TRUE(calibration.has_value());
+    TEST_ASSERT_TRUE(hal::SaveAdcCalibration(page, *calibration).has_value());
+
+    // Same record with one field changed after the CRC was computed
+    hal::AdcCalibration record;
+    std::memcpy(&record, page.Data(), sizeof(record));
+    record.offset += 1.0f;
+    TEST_ASSERT_TRUE(page.Write(&record, sizeof(record)).has_value());
+    TEST_ASSERT_EQUAL(awb::Error::NotCalibrated, hal::LoadAdcCalibration(page).error());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ideal_converter_passes_through);
+    RUN_TEST(test_corrects_gain_and_offset);
+    RUN_TEST(test_corrects_bowed_transfer);
+    RUN_TEST(test_ignores_readings_clipped_at_rail);
+    RUN_TEST(test_rejects_disconnected_input);
+    RUN_TEST(test_rejects_floating_input);
+    RUN_TEST(test_record_round_trips_through_flash);
+    RUN_TEST(test_rejects_corrupted_record);
+    return UNITY_END();
+}
@@ -0,0 +1,122 @@
+// Board description validators (hal/board_map.hpp): the pin, EXTI line and DMA channel
+// checks that a board's static_asserts rely on, against good and broken lists.
+
+#include <unity.h>
+
+#include <array>
+
+#include "board_defs.hpp"
+#include "hal/board_map.hpp"
+
+namespace {
+
+constexpr hal::PinAssignment Pin(hal::PortBase port, hal::PinMask pin, hal::PinMode mode, std::uint8_t af = 0) {
+    return {.owner = "test", .port = port, .pin = pin, .mode = mode, .af = af};
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_board_maps_are_valid() {
+    TEST_ASSERT_TRUE(hal::PinsAreWellFormed(board::pins::kPinMap));
+    TEST_ASSERT_TRUE(hal::PinsAreUnique(board::pins::kPinMap));
+    TEST_ASSERT_TRUE(hal::ExtiLinesAreUnique(board::pins::kPinMap));
+    TEST_ASSERT_TRUE(hal::DmaAssignmentsAreValid(board::dma::kChannelMap));
+}
+
+void test_pin_must_be_one_pin_of_a_port() {
+    TEST_ASSERT_TRUE(hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE, GPIO_PIN_0, hal::PinMode::Input),
+                                                       Pin(GPIOH_BASE, GPIO_PIN_15, hal::PinMode::Output)}));
+
+    // No pin, two pins
+    TEST_ASSERT_FALSE(hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE, 0, hal::PinMode::Input)}));
+    TEST_ASSERT_FALSE(
+        hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE, GPIO_PIN_0 | GPIO_PIN_1, hal::PinMode::Input)}));
+
+    // Below GPIOA, beyond GPIOH, and between two ports
+    TEST_ASSERT_FALSE(hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE - 0x400, GPIO_PIN_0, hal::PinMode::Input)}));
+    TEST_ASSERT_FALSE(hal::PinsAreWellFormed(std::array{Pin(GPIOH_BASE + 0x400, GPIO_PIN_0, hal::PinMode::Input)}));
+    TEST_ASSERT_FALSE(hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE + 0x10, GPIO_PIN_0, hal::PinMode::Input)}));
+}
+
+void test_alternate_function_only_on_alternate_pins() {
+    TEST_ASSERT_TRUE(
+        hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE, GPIO_PIN_2, hal::PinMode::Alternate, GPIO_AF7_USART2)}));
+    TEST_ASSERT_TRUE(hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE, GPIO_PIN_2, hal::PinMode::Alternate, 15)}));
+    TEST_ASSERT_FALSE(hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE, GPIO_PIN_2, hal::PinMode::Alternate, 16)}));
+    TEST_ASSERT_FALSE(
+        hal::PinsAreWellFormed(std::array{Pin(GPIOA_BASE, GPIO_PIN_2, hal::PinMode::Output, GPIO_AF7_USART2)}));
+}
+
+void test_pin_claimed_twice_rejected() {
+    // The same pin number on two ports is two pins
+    TEST_ASSERT_TRUE(hal::PinsAreUnique(std::array{Pin(GPIOA_BASE, GPIO_PIN_5, hal::PinMode::Output),
+                                                   Pin(GPIOB_BASE, GPIO_PIN_5, hal::PinMode::Output)}));
+    TEST_ASSERT_FALSE(hal::PinsAreUnique(std::array{Pin(GPIOA_BASE, GPIO_PIN_5, hal::PinMode::Output),
+                                                    Pin(GPIOB_BASE, GPIO_PIN_1, hal::PinMode::Input),
+                                                    Pin(GPIOA_BASE, GPIO_PIN_5, hal::PinMode::Reserved)}));
+}
+
+void test_exti_line_shared_between_ports_rejected() {
+    // Line 5 serves PA5 or PC5, not both; a plain input on the other port is fine
+    TEST_ASSERT_TRUE(hal::ExtiLinesAreUnique(std::array{Pin(GPIOA_BASE, GPIO_PIN_5, hal::PinMode::ExtiRising),
+                                                        Pin(GPIOC_BASE, GPIO_PIN_5, hal::PinMode::Input),
+                                                        Pin(GPIOC_BASE, GPIO_PIN_6, hal::PinMode::ExtiBoth)}));
+    TEST_ASSERT_FALSE(hal::ExtiLinesAreUnique(std::array{Pin(GPIOA_BASE, GPIO_PIN_5, hal::PinMode::ExtiRising),
+                                                         Pin(GPIOC_BASE, GPIO_PIN_5, hal::PinMode::ExtiFalling)}));
+}
+
+void test_has_exti_line() {
+    constexpr std::array kPins = {Pin(GPIOC_BASE, GPIO_PIN_13, hal::PinMode::ExtiFalling),
+                                  Pin(GPIOA_BASE, GPIO_PIN_5, hal::PinMode::Output)};
+    TEST_ASSERT_TRUE(hal::HasExtiLine(kPins, GPIOC_BASE, GPIO_PIN_13));
+    TEST_ASSERT_FALSE(hal::HasExtiLine(kPins, GPIOA_BASE, GPIO_PIN_5));   // listed, not EXTI
+    TEST_ASSERT_FALSE(hal::HasExtiLine(kPins, GPIOA_BASE, GPIO_PIN_13));  // not listed
+}
+
+void test_dma_request_routing() {
+    // RM0351 tables 41 and 42: the channel and the CSELR selection
+    TEST_ASSERT_EQUAL_INT(0, hal::DmaRequestSelection(hal::DmaRequest::Adc1, 1, 1));
+    TEST_ASSERT_EQUAL_INT(2, hal::DmaRequestSelection(hal::DmaRequest::Usart2Rx, 1, 6));
+    TEST_ASSERT_EQUAL_INT(2, hal::DmaRequestSelection(hal::DmaRequest::Usart2Tx, 1, 7));
+    TEST_ASSERT_EQUAL_INT(3, hal::DmaRequestSelection(hal::DmaRequest::DacCh1, 2, 4));
+    TEST_ASSERT_EQUAL_INT(7, hal::DmaRequestSelection(hal::DmaRequest::Tim1Up, 1, 6));
+    TEST_ASSERT_EQUAL_INT(-1, hal::DmaRequestSelection(hal::DmaRequest::Usart2Rx, 1, 7));
+    TEST_ASSERT_EQUAL_INT(-1, hal::DmaRequestSelection(hal::DmaRequest::Adc1, 2, 1));
+}
+
+void test_dma_assignments_rejected() {
+    // A channel that cannot serve the request
+    TEST_ASSERT_FALSE(
+        hal::DmaAssignmentsAreValid(std::array{hal::DmaAssignment{"rx", hal::DmaRequest::Usart2Rx, 1, 5}}));
+
+    // One channel for two requests (both routable to DMA1 channel 6)
+    TEST_ASSERT_FALSE(
+        hal::DmaAssignmentsAreValid(std::array{hal::DmaAssignment{"rx", hal::DmaRequest::Usart2Rx, 1, 6},
+                                               hal::DmaAssignment{"timer", hal::DmaRequest::Tim1Up, 1, 6}}));
+
+    // One request on two channels
+    TEST_ASSERT_FALSE(
+        hal::DmaAssignmentsAreValid(std::array{hal::DmaAssignment{"adc", hal::DmaRequest::Adc1, 1, 1},
+                                               hal::DmaAssignment{"adc again", hal::DmaRequest::Adc1, 2, 3}}));
+
+    TEST_ASSERT_TRUE(
+        hal::DmaAssignmentsAreValid(std::array{hal::DmaAssignment{"adc", hal::DmaRequest::Adc1, 2, 3},
+                                               hal::DmaAssignment{"timer", hal::DmaRequest::Tim1Up, 1, 6}}));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_board_maps_are_valid);
+    RUN_TEST(test_pin_must_be_one_pin_of_a_port);
+    RUN_TEST(test_alternate_function_only_on_alternate_pins);
+    RUN_TEST(test_pin_claimed_twice_rejected);
+    RUN_TEST(test_exti_line_shared_between_ports_rejected);
+    RUN_TEST(test_has_exti_line);
+    RUN_TEST(test_dma_request_routing);
+    RUN_TEST(test_dma_assignments_rejected);
+    return UNITY_END();
+}
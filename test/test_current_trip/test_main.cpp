@@ -0,0 +1,209 @@
+// hal::CurrentMonitor on the simulated ADC1 analog watchdog (AWD1), fed with
+// injected current-sense sample streams.
+
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "adc.h"
+#include "hal/adc.hpp"
+#include "hal/current_monitor.hpp"
+#include "hal/dac.hpp"
+#include "sim_hal.hpp"
+
+namespace {
+
+constexpr std::uint16_t kTripLevel = 3000;
+
+int disable_calls = 0;
+std::size_t conversions_at_disable = 0;
+std::size_t conversions = 0;
+
+void DisableOutputs() {
+    ++disable_calls;
+    conversions_at_disable = conversions;
+}
+
+// Plays the samples in order, then holds the last one
+sim::Waveform Stream(std::vector<std::uint32_t> samples) {
+    return [samples](std::uint32_t n) { return samples[n < samples.size() ? n : samples.size() - 1]; };
+}
+
+// Converts one sample at a time, so the trip can be pinned to the sample that caused it
+void Convert(std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        ++conversions;
+        sim::RunAdc(hadc1, 1);
+    }
+}
+
+std::uint16_t buffer[16];
+
+// The bench drive: a DAC stream that the trip mutes from the ADC interrupt
+hal::Dac* drive_dac = nullptr;
+
+void MuteDrive() {
+    ++disable_calls;
+    drive_dac->Mute();
+}
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    MX_ADC1_Init();
+    disable_calls = 0;
+    conversions_at_disable = 0;
+    conversions = 0;
+}
+
+void tearDown() {}
+
+void test_trips_on_first_sample_over_threshold() {
+    hal::Adc<std::uint16_t> adc(hadc1);
+    hal::CurrentMonitor<std::uint16_t> monitor(adc, DisableOutputs);
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({100, 2000, 2999, kTripLevel + 1, 100}));
+    TEST_ASSERT_TRUE(monitor.Arm(ADC_CHANNEL_5, kTripLevel));
+    TEST_ASSERT_TRUE(adc.Start(buffer, 16));
+
+    Convert(3);
+    TEST_ASSERT_FALSE(monitor.IsTripped());
+    TEST_ASSERT_TRUE(monitor.Check().has_value());
+
+    Convert(1);
+    TEST_ASSERT_TRUE(monitor.IsTripped());
+    TEST_ASSERT_EQUAL_INT(1, disable_calls);
+    TEST_ASSERT_EQUAL(4, conversions_at_disable);  // In the same conversion, not at the next poll
+    TEST_ASSERT_EQUAL_UINT16(kTripLevel + 1, monitor.GetTripValue());
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.GetTripCount());
+    TEST_ASSERT_FALSE(monitor.Check().has_value());
+    TEST_ASSERT_EQUAL(awb::Error::MotorOvercurrent, monitor.Check().error());
+    adc.Stop();
+}
+
+void test_trip_latches_once() {
+    hal::Adc<std::uint16_t> adc(hadc1);
+    hal::CurrentMonitor<std::uint16_t> monitor(adc, DisableOutputs);
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({3500, 4000, 4095, 100, 3900}));
+    TEST_ASSERT_TRUE(monitor.Arm(ADC_CHANNEL_5, kTripLevel));
+    TEST_ASSERT_TRUE(adc.Start(buffer, 16));
+
+    // The watchdog goes quiet after the first trip, whatever follows
+    Convert(5);
+    TEST_ASSERT_EQUAL_INT(1, disable_calls);
+    TEST_ASSERT_EQUAL_UINT16(3500, monitor.GetTripValue());
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.GetTripCount());
+
+    // Falling back under the threshold does not clear the latch either
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({100}));
+    Convert(4);
+    TEST_ASSERT_TRUE(monitor.IsTripped());
+
+    // Only Clear() re-arms it
+    monitor.Clear();
+    TEST_ASSERT_TRUE(monitor.Check().has_value());
+    Convert(2);
+    TEST_ASSERT_EQUAL_INT(1, disable_calls);
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({3100}));
+    Convert(1);
+    TEST_ASSERT_EQUAL_INT(2, disable_calls);
+    TEST_ASSERT_EQUAL_UINT16(3100, monitor.GetTripValue());
+    TEST_ASSERT_EQUAL_UINT32(2, monitor.GetTripCount());
+    adc.Stop();
+}
+
+void test_no_trip_at_or_just_below_threshold() {
+    hal::Adc<std::uint16_t> adc(hadc1);
+    hal::CurrentMonitor<std::uint16_t> monitor(adc, DisableOutputs);
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5,
+                               [](std::uint32_t n) { return (n % 2 == 0) ? kTripLevel : kTripLevel - 1; });
+    TEST_ASSERT_TRUE(monitor.Arm(ADC_CHANNEL_5, kTripLevel));
+    TEST_ASSERT_TRUE(adc.Start(buffer, 16));
+
+    Convert(1000);
+    TEST_ASSERT_FALSE(monitor.IsTripped());
+    TEST_ASSERT_EQUAL_INT(0, disable_calls);
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.GetTripCount());
+    adc.Stop();
+}
+
+void test_other_channels_do_not_trip() {
+    hal::Adc<std::uint16_t> adc(hadc1);
+    hal::CurrentMonitor<std::uint16_t> monitor(adc, DisableOutputs);
+    using Sequence = hal::AdcSequence<ADC_CHANNEL_5, ADC_CHANNEL_2>;
+    TEST_ASSERT_TRUE(adc.ConfigureSequence<Sequence>(ADC_SAMPLETIME_24CYCLES_5));
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({1000}));
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_2, Stream({4095}));
+    TEST_ASSERT_TRUE(monitor.Arm(ADC_CHANNEL_5, kTripLevel));
+    TEST_ASSERT_TRUE(adc.Start(buffer, 16));
+
+    Convert(10);
+    TEST_ASSERT_FALSE(monitor.IsTripped());
+
+    // The watched channel is every other conversion
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({3001}));
+    Convert(2);
+    TEST_ASSERT_TRUE(monitor.IsTripped());
+    TEST_ASSERT_EQUAL_UINT16(3001, monitor.GetTripValue());
+    adc.Stop();
+}
+
+void test_disarm_stops_supervision() {
+    hal::Adc<std::uint16_t> adc(hadc1);
+    hal::CurrentMonitor<std::uint16_t> monitor(adc, DisableOutputs);
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({4000}));
+    TEST_ASSERT_TRUE(monitor.Arm(ADC_CHANNEL_5, kTripLevel));
+    monitor.Disarm();
+    TEST_ASSERT_TRUE(adc.Start(buffer, 16));
+
+    Convert(5);
+    TEST_ASSERT_FALSE(monitor.IsTripped());
+    TEST_ASSERT_EQUAL_INT(0, disable_calls);
+    adc.Stop();
+}
+
+void test_trip_mutes_dac_stream() {
+    DAC_HandleTypeDef hdac = {};
+    hdac.Instance = DAC1;
+    TIM_HandleTypeDef htim = {};
+    htim.Instance = TIM6;
+    hal::Dac dac(hdac, htim);
+    drive_dac = &dac;
+    std::uint16_t table[8];
+    hal::FillTriangle(table, 8, 1000, 3000);
+    TEST_ASSERT_TRUE(dac.Start(table, 8));
+    sim::RunDac(hdac, 3);
+    TEST_ASSERT_EQUAL_UINT16(2000, dac.GetOutput());
+
+    hal::Adc<std::uint16_t> adc(hadc1);
+    hal::CurrentMonitor<std::uint16_t> monitor(adc, MuteDrive);
+    sim::SetAdcChannelWaveform(hadc1, ADC_CHANNEL_5, Stream({kTripLevel + 1}));
+    TEST_ASSERT_TRUE(monitor.Arm(ADC_CHANNEL_5, kTripLevel));
+    TEST_ASSERT_TRUE(adc.Start(buffer, 16));
+    Convert(1);
+    TEST_ASSERT_EQUAL_INT(1, disable_calls);
+
+    // 0 from the next trigger on, across the table's end; the object still thinks it streams
+    sim::RunDac(hdac, 10);
+    TEST_ASSERT_EQUAL_UINT16(0, dac.GetOutput());
+    TEST_ASSERT_TRUE(dac.IsRunning());
+
+    // The thread-context follow-up
+    TEST_ASSERT_TRUE(dac.SetValue(0));
+    sim::RunDac(hdac, 1);
+    TEST_ASSERT_EQUAL_UINT16(0, dac.GetOutput());
+    adc.Stop();
+    dac.Stop();
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_trips_on_first_sample_over_threshold);
+    RUN_TEST(test_trip_latches_once);
+    RUN_TEST(test_no_trip_at_or_just_below_threshold);
+    RUN_TEST(test_other_channels_do_not_trip);
+    RUN_TEST(test_disarm_stops_supervision);
+    RUN_TEST(test_trip_mutes_dac_stream);
+    return UNITY_END();
+}
@@ -0,0 +1,181 @@
+// Quadrature position/velocity tracking: EncoderTracker fed raw counts, and
+// hal::Encoder reading a simulated TIM2 counter (the mock timer).
+
+#include <unity.h>
+
+#include <cstdint>
+
+#include "hal/encoder.hpp"
+#include "sim_hal.hpp"
+
+namespace {
+
+TIM_HandleTypeDef htim;
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    htim = {};
+    htim.Instance = TIM2;
+}
+
+void tearDown() {}
+
+void test_counter_wraps_up_through_zero() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0xFFFFFFF0U, 0);
+
+    tracker.Update(0x00000010U, 1000);
+    TEST_ASSERT_EQUAL_INT64(32, tracker.GetPosition());
+}
+
+void test_counter_wraps_down_through_zero() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0x00000010U, 0);
+
+    tracker.Update(0xFFFFFFF0U, 1000);
+    TEST_ASSERT_EQUAL_INT64(-32, tracker.GetPosition());
+}
+
+void test_position_extends_past_32_bits() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0, 0);
+
+    // Four times round the 32-bit counter, in steps under 2^31
+    uint32_t raw = 0;
+    for (int i = 0; i < 16; ++i) {
+        raw += 0x40000000U;
+        tracker.Update(raw, (i + 1) * 1000U);
+    }
+    TEST_ASSERT_EQUAL_INT64(INT64_C(4) << 32, tracker.GetPosition());
+
+    for (int i = 0; i < 24; ++i) {
+        raw -= 0x40000000U;
+        tracker.Update(raw, (i + 17) * 1000U);
+    }
+    TEST_ASSERT_EQUAL_INT64(-(INT64_C(2) << 32), tracker.GetPosition());
+}
+
+void test_reset_assigns_position() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(1234, 0, INT64_C(5'000'000'000));
+
+    tracker.Update(1230, 100);
+    TEST_ASSERT_EQUAL_INT64(INT64_C(4'999'999'996), tracker.GetPosition());
+}
+
+void test_velocity_at_speed_uses_short_window() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0, 0);
+
+    // 10 counts per ms = 10000 counts/s, refreshed on every 1 ms update
+    for (uint32_t ms = 1; ms <= 5; ++ms) {
+        tracker.Update(ms * 10, ms * 1000);
+        TEST_ASSERT_EQUAL_INT32(10'000, tracker.GetVelocity());
+    }
+}
+
+void test_velocity_follows_direction_reversal() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0, 0);
+    uint32_t raw = 0;
+
+    for (uint32_t ms = 1; ms <= 10; ++ms) {
+        raw += 20;
+        tracker.Update(raw, ms * 1000);
+    }
+    TEST_ASSERT_EQUAL_INT32(20'000, tracker.GetVelocity());
+
+    for (uint32_t ms = 11; ms <= 20; ++ms) {
+        raw -= 20;
+        tracker.Update(raw, ms * 1000);
+    }
+    TEST_ASSERT_EQUAL_INT32(-20'000, tracker.GetVelocity());
+    TEST_ASSERT_EQUAL_INT64(0, tracker.GetPosition());
+}
+
+void test_slow_speed_resolves_to_one_count_per_window() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0, 0);
+
+    // 3 counts in 100 ms: below kMinWindowCounts, so the long window decides
+    tracker.Update(1, 30'000);
+    tracker.Update(2, 60'000);
+    TEST_ASSERT_EQUAL_INT32(0, tracker.GetVelocity());
+    tracker.Update(3, hal::EncoderTracker::kMaxWindowUs);
+    TEST_ASSERT_EQUAL_INT32(30, tracker.GetVelocity());
+
+    // One count per window is the finest step
+    tracker.Update(4, 2 * hal::EncoderTracker::kMaxWindowUs);
+    TEST_ASSERT_EQUAL_INT32(10, tracker.GetVelocity());
+}
+
+void test_stall_reads_zero_after_timeout() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0, 0);
+    tracker.Update(100, 1000);
+    TEST_ASSERT_EQUAL_INT32(100'000, tracker.GetVelocity());
+
+    // No edges: the old estimate stands until the window times out
+    tracker.Update(100, 1000 + hal::EncoderTracker::kMaxWindowUs - 1);
+    TEST_ASSERT_EQUAL_INT32(100'000, tracker.GetVelocity());
+    tracker.Update(100, 1000 + hal::EncoderTracker::kMaxWindowUs);
+    TEST_ASSERT_EQUAL_INT32(0, tracker.GetVelocity());
+}
+
+void test_velocity_survives_timestamp_wrap() {
+    hal::EncoderTracker tracker;
+    tracker.Reset(0, 0xFFFFFC18U);  // 1 ms before the microsecond counter wraps
+
+    tracker.Update(50, 0x000003E8U);  // 2 ms later
+    TEST_ASSERT_EQUAL_INT32(25'000, tracker.GetVelocity());
+}
+
+void test_encoder_reads_timer_counter() {
+    hal::Encoder encoder(htim);
+    TIM2->CNT = 0xFFFFFFFEU;
+    TEST_ASSERT_TRUE(encoder.Start(0));
+    TEST_ASSERT_EQUAL_INT64(0, encoder.GetPosition());
+
+    TIM2->CNT = 3;  // Counted up through the wrap
+    encoder.Update(1000);
+    TEST_ASSERT_EQUAL_UINT32(3, encoder.ReadRaw());
+    TEST_ASSERT_EQUAL_INT64(5, encoder.GetPosition());
+    TEST_ASSERT_EQUAL_INT32(0, encoder.GetVelocity());  // Fewer than kMinWindowCounts so far
+
+    TIM2->CNT = 0xFFFFFFF0U;  // And back down through it: -14 counts net over the 2 ms window
+    encoder.Update(2000);
+    TEST_ASSERT_EQUAL_INT64(-14, encoder.GetPosition());
+    TEST_ASSERT_EQUAL_INT32(-7'000, encoder.GetVelocity());
+
+    encoder.Stop();
+}
+
+void test_encoder_set_position_rebases_count() {
+    hal::Encoder encoder(htim);
+    TIM2->CNT = 500;
+    TEST_ASSERT_TRUE(encoder.Start(0));
+
+    encoder.SetPosition(-1000, 0);
+    TIM2->CNT = 510;
+    encoder.Update(1000);
+    TEST_ASSERT_EQUAL_INT64(-990, encoder.GetPosition());
+    TEST_ASSERT_EQUAL_INT32(10'000, encoder.GetVelocity());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_counter_wraps_up_through_zero);
+    RUN_TEST(test_counter_wraps_down_through_zero);
+    RUN_TEST(test_position_extends_past_32_bits);
+    RUN_TEST(test_reset_assigns_position);
+    RUN_TEST(test_velocity_at_speed_uses_short_window);
+    RUN_TEST(test_velocity_follows_direction_reversal);
+    RUN_TEST(test_slow_speed_resolves_to_one_count_per_window);
+    RUN_TEST(test_stall_reads_zero_after_timeout);
+    RUN_TEST(test_velocity_survives_timestamp_wrap);
+    RUN_TEST(test_encoder_reads_timer_counter);
+    RUN_TEST(test_encoder_set_position_rebases_count);
+    return UNITY_END();
+}
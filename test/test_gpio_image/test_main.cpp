@@ -0,0 +1,224 @@
+// ComputeGpioImage()/ApplyGpioImage() against HAL_GPIO_Init(): the same pin list is
+// configured both ways on the simulated ports and every GPIO, EXTI and SYSCFG register compared.
+
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+
+#include "board_defs.hpp"
+#include "hal/board_map.hpp"
+#include "sim_hal.hpp"
+
+namespace {
+
+constexpr std::array<hal::PortBase, hal::GpioImage::kMaxPorts> kPorts = {
+    GPIOA_BASE, GPIOB_BASE, GPIOC_BASE, GPIOD_BASE, GPIOE_BASE, GPIOF_BASE, GPIOG_BASE, GPIOH_BASE};
+
+struct Registers {
+    struct Port {
+        std::uint32_t moder, otyper, ospeedr, pupdr, odr, afr[2], ascr;
+    };
+    std::array<Port, kPorts.size()> ports;
+    std::uint32_t rtsr, ftsr, imr, emr;
+    std::uint32_t exticr[4];
+};
+
+Registers Snapshot() {
+    Registers r{};
+    for (std::size_t i = 0; i < kPorts.size(); ++i) {
+        const GPIO_TypeDef* const gpio = hal::detail::PortPtr(kPorts[i]);
+        r.ports[i] = {gpio->MODER, gpio->OTYPER, gpio->OSPEEDR, gpio->PUPDR, gpio->ODR, {gpio->AFR[0], gpio->AFR[1]},
+                      gpio->ASCR};
+    }
+    r.rtsr = EXTI->RTSR1;
+    r.ftsr = EXTI->FTSR1;
+    r.imr = EXTI->IMR1;
+    r.emr = EXTI->EMR1;
+    for (std::size_t i = 0; i < 4; ++i) {
+        r.exticr[i] = SYSCFG->EXTICR[i];
+    }
+    return r;
+}
+
+void AssertSameRegisters(const Registers& expected, const Registers& actual) {
+    for (std::size_t i = 0; i < kPorts.size(); ++i) {
+        const Registers::Port& e = expected.ports[i];
+        const Registers::Port& a = actual.ports[i];
+        TEST_ASSERT_EQUAL_HEX32(e.moder, a.moder);
+        TEST_ASSERT_EQUAL_HEX32(e.otyper, a.otyper);
+        TEST_ASSERT_EQUAL_HEX32(e.ospeedr, a.ospeedr);
+        TEST_ASSERT_EQUAL_HEX32(e.pupdr, a.pupdr);
+        TEST_ASSERT_EQUAL_HEX32(e.odr, a.odr);
+        TEST_ASSERT_EQUAL_HEX32(e.afr[0], a.afr[0]);
+        TEST_ASSERT_EQUAL_HEX32(e.afr[1], a.afr[1]);
+        TEST_ASSERT_EQUAL_HEX32(e.ascr, a.ascr);
+    }
+    TEST_ASSERT_EQUAL_HEX32(expected.rtsr, actual.rtsr);
+    TEST_ASSERT_EQUAL_HEX32(expected.ftsr, actual.ftsr);
+    TEST_ASSERT_EQUAL_HEX32(expected.imr, actual.imr);
+    TEST_ASSERT_EQUAL_HEX32(expected.emr, actual.emr);
+    for (std::size_t i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL_HEX32(expected.exticr[i], actual.exticr[i]);
+    }
+}
+
+// What CubeMX generates for the pin: the output level first, then one HAL_GPIO_Init() call
+void InitWithHal(const hal::PinAssignment& p) {
+    if (p.mode == hal::PinMode::Reserved) {
+        return;
+    }
+    GPIO_TypeDef* const gpio = hal::detail::PortPtr(p.port);
+    const bool open_drain = p.type == hal::OutputType::OpenDrain;
+
+    GPIO_InitTypeDef init = {};
+    init.Pin = p.pin;
+    init.Pull = (p.pull == hal::Pull::Up) ? GPIO_PULLUP : (p.pull == hal::Pull::Down) ? GPIO_PULLDOWN : GPIO_NOPULL;
+    init.Speed = (p.speed == hal::Speed::VeryHigh) ? GPIO_SPEED_FREQ_VERY_HIGH
+                 : (p.speed == hal::Speed::High)   ? GPIO_SPEED_FREQ_HIGH
+                 : (p.speed == hal::Speed::Medium) ? GPIO_SPEED_FREQ_MEDIUM
+                                                   : GPIO_SPEED_FREQ_LOW;
+    switch (p.mode) {
+        case hal::PinMode::Input: init.Mode = GPIO_MODE_INPUT; break;
+        case hal::PinMode::Output:
+            HAL_GPIO_WritePin(gpio, p.pin, (p.initial == hal::Level::High) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+            init.Mode = open_drain ? GPIO_MODE_OUTPUT_OD : GPIO_MODE_OUTPUT_PP;
+            break;
+        case hal::PinMode::Alternate:
+            init.Mode = open_drain ? GPIO_MODE_AF_OD : GPIO_MODE_AF_PP;
+            init.Alternate = p.af;
+            break;
+        case hal::PinMode::Analog: init.Mode = GPIO_MODE_ANALOG; break;
+        case hal::PinMode::AdcInput: init.Mode = GPIO_MODE_ANALOG_ADC_CONTROL; break;
+        case hal::PinMode::ExtiRising: init.Mode = GPIO_MODE_IT_RISING; break;
+        case hal::PinMode::ExtiFalling: init.Mode = GPIO_MODE_IT_FALLING; break;
+        case hal::PinMode::ExtiBoth: init.Mode = GPIO_MODE_IT_RISING_FALLING; break;
+        case hal::PinMode::Reserved: break;
+    }
+    HAL_GPIO_Init(gpio, &init);
+}
+
+// Leaves every port, EXTI and SYSCFG register in a non-reset state, so a field the image
+// forgets to write (or writes when the HAL would not) shows up as a difference
+void Scribble() {
+    for (const hal::PortBase port : kPorts) {
+        GPIO_TypeDef* const gpio = hal::detail::PortPtr(port);
+        gpio->MODER = 0x5A5A'A5A5;
+        gpio->OTYPER = 0x0000'C3C3;
+        gpio->OSPEEDR = 0x9696'6969;
+        gpio->PUPDR = 0x4949'9498;
+        gpio->AFR[0] = 0x1234'5678;
+        gpio->AFR[1] = 0x8765'4321;
+        gpio->ASCR = 0x0000'F00F;
+    }
+    EXTI->RTSR1 = 0x0000'0F0F;
+    EXTI->FTSR1 = 0x0000'F0F0;
+    EXTI->EMR1 = 0x0000'FFFF;
+    for (std::size_t i = 0; i < 4; ++i) {
+        SYSCFG->EXTICR[i] = 0x0000'7531;
+    }
+}
+
+template <std::size_t N>
+void AssertImageMatchesHal(const std::array<hal::PinAssignment, N>& pins) {
+    sim::Reset();
+    Scribble();
+    for (const hal::PinAssignment& p : pins) {
+        InitWithHal(p);
+    }
+    const Registers expected = Snapshot();
+
+    sim::Reset();
+    Scribble();
+    hal::ApplyGpioImage(hal::ComputeGpioImage(pins));
+    AssertSameRegisters(expected, Snapshot());
+}
+
+constexpr hal::PinAssignment Pin(hal::PortBase port, hal::PinMask pin, hal::PinAssignment settings) {
+    settings.owner = "test";
+    settings.port = port;
+    settings.pin = pin;
+    return settings;
+}
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+}
+
+void tearDown() {}
+
+void test_board_pin_map() {
+    AssertImageMatchesHal(board::pins::kPinMap);
+}
+
+void test_outputs() {
+    AssertImageMatchesHal(std::array{
+        Pin(GPIOA_BASE, GPIO_PIN_5, {.mode = hal::PinMode::Output}),
+        Pin(GPIOA_BASE, GPIO_PIN_6,
+            {.mode = hal::PinMode::Output, .speed = hal::Speed::VeryHigh, .initial = hal::Level::High}),
+        Pin(GPIOB_BASE, GPIO_PIN_9,
+            {.mode = hal::PinMode::Output, .pull = hal::Pull::Up, .type = hal::OutputType::OpenDrain,
+             .initial = hal::Level::High}),
+    });
+}
+
+void test_alternate_functions_both_afr_halves() {
+    AssertImageMatchesHal(std::array{
+        Pin(GPIOA_BASE, GPIO_PIN_2, {.mode = hal::PinMode::Alternate, .speed = hal::Speed::High, .af = 7}),
+        Pin(GPIOA_BASE, GPIO_PIN_15, {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Down, .af = 1}),
+        Pin(GPIOB_BASE, GPIO_PIN_8,
+            {.mode = hal::PinMode::Alternate, .pull = hal::Pull::Up, .type = hal::OutputType::OpenDrain, .af = 4}),
+    });
+}
+
+void test_inputs_and_exti_lines() {
+    AssertImageMatchesHal(std::array{
+        Pin(GPIOC_BASE, GPIO_PIN_13, {.mode = hal::PinMode::ExtiFalling}),
+        Pin(GPIOB_BASE, GPIO_PIN_0, {.mode = hal::PinMode::ExtiRising, .pull = hal::Pull::Down}),
+        Pin(GPIOH_BASE, GPIO_PIN_1, {.mode = hal::PinMode::ExtiBoth, .pull = hal::Pull::Up}),
+        Pin(GPIOA_BASE, GPIO_PIN_0, {.mode = hal::PinMode::Input, .pull = hal::Pull::Up}),
+    });
+}
+
+void test_analog_pins() {
+    AssertImageMatchesHal(std::array{
+        Pin(GPIOA_BASE, GPIO_PIN_0, {.mode = hal::PinMode::AdcInput}),
+        Pin(GPIOA_BASE, GPIO_PIN_4, {.mode = hal::PinMode::Analog}),
+        Pin(GPIOC_BASE, GPIO_PIN_3, {.mode = hal::PinMode::AdcInput, .pull = hal::Pull::Down}),
+    });
+}
+
+void test_analog_pin_with_pull_up_keeps_pupdr() {
+    // The HAL skips PUPDR for an analog pin asked to pull up; so must the image
+    AssertImageMatchesHal(std::array{
+        Pin(GPIOA_BASE, GPIO_PIN_1, {.mode = hal::PinMode::Analog, .pull = hal::Pull::Up}),
+        Pin(GPIOA_BASE, GPIO_PIN_7, {.mode = hal::PinMode::AdcInput, .pull = hal::Pull::Up}),
+    });
+
+    // Both keep the pull-down (0b10) Scribble() left in their PUPDR fields
+    TEST_ASSERT_EQUAL_HEX32(0x2U << 2, GPIOA->PUPDR & (0x3U << 2));
+    TEST_ASSERT_EQUAL_HEX32(0x2U << 14, GPIOA->PUPDR & (0x3U << 14));
+    TEST_ASSERT_EQUAL_HEX32(0x3U << 2, GPIOA->MODER & (0x3U << 2));
+}
+
+void test_reserved_pins_untouched() {
+    AssertImageMatchesHal(std::array{
+        Pin(GPIOA_BASE, GPIO_PIN_13, {.mode = hal::PinMode::Reserved}),
+        Pin(GPIOA_BASE, GPIO_PIN_14, {.mode = hal::PinMode::Reserved}),
+        Pin(GPIOA_BASE, GPIO_PIN_5, {.mode = hal::PinMode::Output}),
+    });
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_board_pin_map);
+    RUN_TEST(test_outputs);
+    RUN_TEST(test_alternate_functions_both_afr_halves);
+    RUN_TEST(test_inputs_and_exti_lines);
+    RUN_TEST(test_analog_pins);
+    RUN_TEST(test_analog_pin_with_pull_up_keeps_pupdr);
+    RUN_TEST(test_reserved_pins_untouched);
+    return UNITY_END();
+}
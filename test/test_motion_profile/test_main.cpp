@@ -0,0 +1,179 @@
+// MotionProfile moves stepped tick by tick with blind-like limits at a 1 kHz control rate:
+// speed, acceleration and jerk limits, rest-to-rest timing, retargets and rejected moves.
+
+#include <unity.h>
+
+#include <cstdint>
+
+#include "util/motion_profile.hpp"
+
+namespace {
+
+constexpr std::uint32_t kTickHz = 1000;
+constexpr awb::MotionLimits kSCurve = {.velocity = 2000, .acceleration = 4000, .jerk = 40000,
+                                       .min_position = -50000, .max_position = 50000};
+constexpr awb::MotionLimits kTrapezoid = {.velocity = 2000, .acceleration = 4000};
+
+std::int32_t Abs(std::int32_t x) {
+    return x < 0 ? -x : x;
+}
+
+struct Retarget {
+    std::uint32_t tick;
+    std::int32_t target;
+};
+
+// Steps a move from `start` to `target` (then to the retarget, if any) and checks every
+// setpoint: speed, acceleration and jerk within a rounding margin of the limits, position
+// moving by the velocity, and the move ending at rest on the final target.
+void AssertMovesSmoothly(const awb::MotionLimits& limits, std::int32_t start, std::int32_t target,
+                         Retarget retarget = {0, 0}, std::uint32_t max_ticks = 20000) {
+    awb::MotionProfile profile(kTickHz, limits);
+    profile.Reset(start);
+    TEST_ASSERT_TRUE(profile.MoveTo(target).has_value());
+
+    const auto margin = [](float limit, std::int32_t rounding) {
+        return static_cast<std::int32_t>(limit * 1.01f) + rounding;
+    };
+    const std::int32_t max_speed = margin(limits.velocity, 1);
+    const std::int32_t max_acceleration = margin(limits.acceleration, 1);
+    const std::int32_t max_speed_step = margin(limits.acceleration / kTickHz, 1);
+    const std::int32_t max_acceleration_step = margin(limits.jerk / kTickHz, 1);
+
+    awb::MotionSetpoint previous = profile.GetSetpoint();
+    for (std::uint32_t tick = 1; tick <= max_ticks; ++tick) {
+        if (tick == retarget.tick) {
+            TEST_ASSERT_TRUE(profile.MoveTo(retarget.target).has_value());
+        }
+        const awb::MotionSetpoint now = profile.Step();
+        TEST_ASSERT_TRUE(Abs(now.velocity) <= max_speed);
+        TEST_ASSERT_TRUE(Abs(now.acceleration) <= max_acceleration);
+        TEST_ASSERT_TRUE(Abs(now.velocity - previous.velocity) <= max_speed_step);
+        TEST_ASSERT_TRUE(Abs((now.position - previous.position) * static_cast<std::int32_t>(kTickHz) - now.velocity) <=
+                         static_cast<std::int32_t>(kTickHz) + 1);
+        // A trapezoid steps its acceleration by design
+        if (limits.jerk > 0) {
+            TEST_ASSERT_TRUE(Abs(now.acceleration - previous.acceleration) <= max_acceleration_step);
+        }
+        if (profile.IsDone()) {
+            const std::int32_t final_target = (retarget.tick != 0) ? retarget.target : target;
+            TEST_ASSERT_EQUAL_INT32(final_target, now.position);
+            TEST_ASSERT_EQUAL_INT32(0, now.velocity);
+            TEST_ASSERT_EQUAL_INT32(0, now.acceleration);
+            return;
+        }
+        previous = now;
+    }
+    TEST_FAIL_MESSAGE("move did not finish");
+}
+
+// Ticks from rest to rest
+std::uint32_t MoveTicks(const awb::MotionLimits& limits, std::int32_t distance) {
+    awb::MotionProfile profile(kTickHz, limits);
+    profile.Reset(0);
+    if (!profile.MoveTo(distance).has_value()) {
+        return 0;
+    }
+    std::uint32_t ticks = 0;
+    while (!profile.IsDone() && ticks < 100000) {
+        profile.Step();
+        ++ticks;
+    }
+    return ticks;
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_block_sums_are_exact() {
+    // The block sums used by the planner against a tick-by-tick count
+    for (std::int64_t n1 = 1; n1 <= 9; ++n1) {
+        for (std::int64_t n2 = 0; n2 <= 9; ++n2) {
+            const awb::detail::MotionBlock block{n1, n2};
+            std::int64_t acceleration = 0;
+            std::int64_t velocity = 0;
+            std::int64_t position = 0;
+            for (std::int64_t t = 0; t < block.Ticks(); ++t) {
+                acceleration += (t < n1) ? 1 : (t < n1 + n2) ? 0 : -1;
+                velocity += acceleration;
+                position += velocity;
+            }
+            TEST_ASSERT_EQUAL_INT64(0, acceleration);
+            TEST_ASSERT_EQUAL_INT64(block.Gain(), velocity);
+            TEST_ASSERT_EQUAL_INT64(block.Reach(), position);
+        }
+    }
+}
+
+void test_s_curve_moves() {
+    // Long move with a cruise, short moves that never reach full speed, the smallest move, and reverse
+    AssertMovesSmoothly(kSCurve, 0, 20000);
+    AssertMovesSmoothly(kSCurve, 0, 300);
+    AssertMovesSmoothly(kSCurve, 0, 1);
+    AssertMovesSmoothly(kSCurve, 10000, -3000);
+}
+
+void test_trapezoidal_move() {
+    AssertMovesSmoothly(kTrapezoid, 0, 5000);
+}
+
+void test_s_curve_move_time() {
+    // 20000 counts at 2000 counts/s is 10 s of cruise-speed travel; speeding up and slowing
+    // down (0.1 s ramps around 0.4 s of constant acceleration, 0.6 s each) add half their time
+    const std::uint32_t ticks = MoveTicks(kSCurve, 20000);
+    TEST_ASSERT_TRUE(ticks >= 10600);
+    TEST_ASSERT_TRUE(ticks <= 10602);
+}
+
+void test_retarget_while_accelerating() {
+    AssertMovesSmoothly(kSCurve, 0, 20000, {50, 15000});
+}
+
+void test_retarget_at_cruise() {
+    // To a nearer point, and to a point behind the axis
+    AssertMovesSmoothly(kSCurve, 0, 20000, {3000, 12000});
+    AssertMovesSmoothly(kSCurve, 0, 20000, {3000, 1000});
+}
+
+void test_retarget_near_stopping_distance() {
+    // The stopping distance from 5400 counts is 600: closer than it, and just beyond it
+    // (whole-tick rounding leaves a few counts of cruise at most, and the nearest of these
+    // stop short and creep)
+    AssertMovesSmoothly(kSCurve, 0, 20000, {3000, 5200});
+    AssertMovesSmoothly(kSCurve, 0, 20000, {3000, 6020});
+    AssertMovesSmoothly(kSCurve, 0, 20000, {3000, 6100});
+}
+
+void test_retarget_while_decelerating() {
+    AssertMovesSmoothly(kSCurve, 0, 20000, {10300, 25000});
+}
+
+void test_trapezoidal_retarget() {
+    AssertMovesSmoothly(kTrapezoid, 0, 5000, {1500, -2000});
+}
+
+void test_rejected_moves() {
+    awb::MotionProfile profile(kTickHz, kSCurve);
+    TEST_ASSERT_TRUE(profile.MoveTo(60000).error() == awb::Error::TargetUnreachable);
+
+    awb::MotionProfile stalled(kTickHz, {.velocity = 0, .acceleration = 4000});
+    TEST_ASSERT_TRUE(stalled.MoveTo(10).error() == awb::Error::InvalidParam);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_block_sums_are_exact);
+    RUN_TEST(test_s_curve_moves);
+    RUN_TEST(test_trapezoidal_move);
+    RUN_TEST(test_s_curve_move_time);
+    RUN_TEST(test_retarget_while_accelerating);
+    RUN_TEST(test_retarget_at_cruise);
+    RUN_TEST(test_retarget_near_stopping_distance);
+    RUN_TEST(test_retarget_while_decelerating);
+    RUN_TEST(test_trapezoidal_retarget);
+    RUN_TEST(test_rejected_moves);
+    return UNITY_END();
+}
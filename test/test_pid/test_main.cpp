@@ -0,0 +1,381 @@
+// Pid closed-loop against a DC motor and blind model: a cascaded position/velocity loop
+// following MotionProfile moves as the blind axis will run it, plus the controller details.
+// Each move reports its overshoot, settling time and (after a jam) windup recovery.
+
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+#include "dsp/pid.hpp"
+#include "util/motion_profile.hpp"
+
+namespace {
+
+using dsp::FloatToQ31;
+using dsp::q31_t;
+
+// -----------------------------------------------------------------------------
+// Plant: a 12 V gearmotor with a 512-line encoder (2048 counts/rev) winding a
+// 1.5 kg blind on a 15 mm tube through a 50:1 gearbox, all referred to the motor
+// -----------------------------------------------------------------------------
+constexpr double kResistance = 2.0;       // ohm
+constexpr double kInductance = 1e-3;      // H
+constexpr double kTorqueConstant = 0.02;  // N*m/A, also the back-EMF constant in V*s/rad
+constexpr double kInertia = 6e-6;         // kg*m^2, rotor plus the reflected blind
+constexpr double kViscous = 2e-6;         // N*m*s/rad
+constexpr double kCoulomb = 1e-3;         // N*m, gearbox and tube friction
+constexpr double kGravity = 4.4e-3;       // N*m, the blind's weight, toward lower counts
+constexpr double kSupply = 12.0;          // V across the H-bridge at full duty
+constexpr double kCountsPerRad = 2048 / 6.283185307179586;
+
+constexpr std::uint32_t kTickHz = 1000;
+constexpr int kSubsteps = 5;  // 200 us, under half the electrical time constant
+constexpr double kSubstep = 1.0 / (kTickHz * kSubsteps);
+
+class Plant {
+public:
+    // Holds a duty (-1..1) for one control tick
+    void Run(double duty) {
+        for (int i = 0; i < kSubsteps; ++i) {
+            const double friction = kCoulomb * Limit(speed_);  // smoothed over +-1 rad/s
+            const double torque = kTorqueConstant * current_ - kViscous * speed_ - friction - kGravity;
+            current_ += (duty * kSupply - kResistance * current_ - kTorqueConstant * speed_) / kInductance * kSubstep;
+            speed_ += torque / kInertia * kSubstep;
+            angle_ += speed_ * kSubstep;
+            if (jammed_) {
+                speed_ = 0;
+                angle_ = jam_angle_;
+            }
+        }
+    }
+
+    // Encoder reading
+    std::int32_t Counts() const {
+        const double counts = angle_ * kCountsPerRad;
+        const auto truncated = static_cast<std::int32_t>(counts);
+        return (counts < truncated) ? truncated - 1 : truncated;
+    }
+
+    // Holds the tube still (e.g., the blind caught on something), or lets go
+    void Jam(bool jammed) {
+        jammed_ = jammed;
+        jam_angle_ = angle_;
+    }
+
+private:
+    static double Limit(double x) { return (x > 1) ? 1 : (x < -1) ? -1 : x; }
+
+    double current_ = 0;
+    double speed_ = 0;
+    double angle_ = 0;
+    bool jammed_ = false;
+    double jam_angle_ = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Controller: position loop (counts -> counts/s) feeding a velocity loop (counts/s -> duty),
+// with the profile's velocity and acceleration fed forward into each
+// -----------------------------------------------------------------------------
+constexpr double kCountsPerSecondPerDuty = kSupply / kTorqueConstant * kCountsPerRad;  // no-load speed
+constexpr double kVelocityFeedForward = 1 / kCountsPerSecondPerDuty;                   // duty per count/s
+// Duty per count/s^2: the current that accelerates the inertia, across the winding resistance
+constexpr double kAccelerationFeedForward = kInertia / kCountsPerRad / kTorqueConstant * kResistance / kSupply;
+
+constexpr dsp::PidGains kPositionGains = {.kp = 30};
+// Duty per count/s; the Q31 loop scales them to full-scale duty
+constexpr dsp::PidGains kVelocityGains = {.kp = 3e-5f, .ki = 1.5e-3f};
+constexpr float kMaxCorrection = 20000;  // counts/s the position loop may add to the profile
+
+constexpr awb::MotionLimits kBlindLimits = {.velocity = 60000, .acceleration = 200000, .jerk = 4'000'000};
+
+// Signal and duty scaling per sample type: counts and counts/s as they are, duty as a Q31 fraction
+template <typename Sample>
+Sample Signal(double x) {
+    if constexpr (std::is_same_v<Sample, float>) {
+        return static_cast<float>(x);
+    } else {
+        return static_cast<q31_t>(x < 0 ? x - 0.5 : x + 0.5);
+    }
+}
+
+template <typename Sample>
+Sample Duty(double duty) {
+    if constexpr (std::is_same_v<Sample, float>) {
+        return static_cast<float>(duty);
+    } else {
+        return FloatToQ31(static_cast<float>(duty));
+    }
+}
+
+template <typename Sample>
+double FromDuty(Sample duty) {
+    if constexpr (std::is_same_v<Sample, float>) {
+        return duty;
+    } else {
+        return static_cast<double>(duty) / 2147483648.0;
+    }
+}
+
+template <typename Sample>
+dsp::PidGains DutyGains(const dsp::PidGains& gains) {
+    if constexpr (std::is_same_v<Sample, float>) {
+        return gains;
+    } else {
+        return {gains.kp * 2147483648.0f, gains.ki * 2147483648.0f, gains.kd * 2147483648.0f, gains.derivative_hz};
+    }
+}
+
+template <typename Sample>
+const char* TypeName() {
+    return std::is_same_v<Sample, float> ? "float" : "q31";
+}
+
+std::int32_t Abs(std::int32_t x) {
+    return x < 0 ? -x : x;
+}
+
+struct MoveResult {
+    std::int32_t worst_following;  // counts, while the profile runs
+    std::int32_t overshoot;        // counts past the target
+    std::int32_t lead;             // counts ahead of the profile
+    std::int32_t final_error;      // counts, 0.2 s after the profile ends
+    std::uint32_t settling_ticks;  // from the profile ending until the axis stays within a count of the target
+    std::uint32_t recovery_ticks;  // from a jam letting go until the axis is back on the profile
+    double peak_duty;
+};
+
+constexpr std::uint32_t kHoldTicks = 200;
+constexpr std::int32_t kOnProfile = 8;  // counts of following error the moves stay within
+
+// Holds the blind at 0 for 0.2 s (the loop takes up its weight), then moves it to the target,
+// jammed for jam_ticks from jam_from ticks into the move if asked
+template <typename Sample>
+MoveResult RunMove(std::int32_t target, std::uint32_t jam_from = 0, std::uint32_t jam_ticks = 0) {
+    Plant plant;
+    awb::MotionProfile profile(kTickHz, kBlindLimits);
+    profile.Reset(0);
+    dsp::Pid<Sample> position_loop(kPositionGains, kTickHz, Signal<Sample>(-kMaxCorrection - kBlindLimits.velocity),
+                                   Signal<Sample>(kMaxCorrection + kBlindLimits.velocity));
+    dsp::Pid<Sample> velocity_loop(DutyGains<Sample>(kVelocityGains), kTickHz, Duty<Sample>(-1), Duty<Sample>(1));
+
+    const std::uint32_t release = kHoldTicks + jam_from + jam_ticks;
+    MoveResult result{};
+    std::int32_t counts = plant.Counts();
+    std::uint32_t settle = 0;
+    std::uint32_t done_tick = 0;
+    bool recovered = (jam_ticks == 0);
+    for (std::uint32_t tick = 0; settle < 200 && tick < 100000; ++tick) {
+        if (tick == kHoldTicks) {
+            (void)profile.MoveTo(target);
+        }
+        if (jam_ticks != 0 && (tick == kHoldTicks + jam_from || tick == release)) {
+            plant.Jam(tick == kHoldTicks + jam_from);
+        }
+        const awb::MotionSetpoint setpoint = profile.Step();
+        const std::int32_t previous = counts;
+        counts = plant.Counts();
+        const std::int32_t speed = (counts - previous) * static_cast<std::int32_t>(kTickHz);
+
+        const Sample velocity = position_loop.Update(Signal<Sample>(setpoint.position), Signal<Sample>(counts),
+                                                     Signal<Sample>(setpoint.velocity));
+        const double feed_forward = kVelocityFeedForward * setpoint.velocity +
+                                    kAccelerationFeedForward * setpoint.acceleration;
+        const Sample duty = velocity_loop.Update(velocity, Signal<Sample>(speed), Duty<Sample>(feed_forward));
+        plant.Run(FromDuty(duty));
+
+        if (tick < kHoldTicks) {
+            continue;
+        }
+        const std::int32_t error = setpoint.position - counts;
+        const std::int32_t past = (target < 0) ? target - counts : counts - target;
+        const std::int32_t ahead = (target < 0) ? error : -error;
+        const double magnitude = FromDuty(duty) < 0 ? -FromDuty(duty) : FromDuty(duty);
+        result.peak_duty = (magnitude > result.peak_duty) ? magnitude : result.peak_duty;
+        result.overshoot = (past > result.overshoot) ? past : result.overshoot;
+        result.lead = (ahead > result.lead) ? ahead : result.lead;
+        if (!recovered && tick >= release && Abs(error) <= kOnProfile) {
+            recovered = true;
+            result.recovery_ticks = tick - release;
+        }
+        if (profile.IsDone()) {
+            done_tick = (settle == 0) ? tick : done_tick;
+            ++settle;
+            result.final_error = error;
+            if (Abs(error) > 1) {
+                result.settling_ticks = tick - done_tick + 1;
+            }
+        } else if (Abs(error) > result.worst_following) {
+            result.worst_following = Abs(error);
+        }
+    }
+    if (!recovered) {
+        result.recovery_ticks = UINT32_MAX;
+    }
+    return result;
+}
+
+template <typename Sample>
+void Report(const char* move, const MoveResult& result) {
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "%s %s: overshoot %ld counts, settling %lu ms, following %ld counts, peak duty %.2f, "
+                  "recovery %lu ms",
+                  TypeName<Sample>(), move, static_cast<long>(result.overshoot),
+                  static_cast<unsigned long>(result.settling_ticks), static_cast<long>(result.worst_following),
+                  result.peak_duty, static_cast<unsigned long>(result.recovery_ticks));
+    TEST_MESSAGE(line);
+}
+
+// The loops stay well inside the duty range and on the profile, and settle on the target
+template <typename Sample>
+void AssertTracks(const char* move, std::int32_t target) {
+    const MoveResult result = RunMove<Sample>(target);
+    Report<Sample>(move, result);
+    TEST_ASSERT_TRUE(result.worst_following <= kOnProfile);
+    TEST_ASSERT_TRUE(result.overshoot <= 5);
+    TEST_ASSERT_TRUE(result.settling_ticks <= 100);
+    TEST_ASSERT_EQUAL_INT32(0, result.final_error);
+    TEST_ASSERT_TRUE(result.peak_duty < 0.5);
+}
+
+// Jammed for 0.3 s while accelerating: both loops saturate, then catch the profile up without
+// running past it or lingering on a wound-up integral, and are within a count of the target by the end
+template <typename Sample>
+void AssertRecoversFromJam() {
+    const MoveResult result = RunMove<Sample>(50'000, 200, 300);
+    Report<Sample>("jam", result);
+    TEST_ASSERT_TRUE(result.worst_following > 10'000);
+    // Unwound, the loops close the gap as fast as the position loop's correction limit allows
+    TEST_ASSERT_TRUE(result.recovery_ticks <= result.worst_following * kTickHz / kMaxCorrection);
+    TEST_ASSERT_TRUE(result.lead <= 5);
+    TEST_ASSERT_TRUE(result.overshoot <= 5);
+    TEST_ASSERT_TRUE(Abs(result.final_error) <= 1);
+}
+
+// -----------------------------------------------------------------------------
+// Controller details, on unit signals (Q31: 2^24 LSBs per unit)
+// -----------------------------------------------------------------------------
+template <typename Sample>
+Sample Unit(float x) {
+    if constexpr (std::is_same_v<Sample, float>) {
+        return x;
+    } else {
+        return static_cast<q31_t>(x * (1 << 24));
+    }
+}
+
+template <typename Sample>
+float FromUnit(Sample value) {
+    return std::is_same_v<Sample, float> ? static_cast<float>(value) : static_cast<float>(value) / (1 << 24);
+}
+
+// Anti-windup: 1 s against the limit, then the error reverses. The integral stopped where it
+// took the output to the limit (0.8, with kp*e = 0.2), so the output drops straight to
+// 0.8 - 0.2 - ki*Ts*2 = 0.58; a wound-up integral would leave it at 0.78.
+template <typename Sample>
+void AssertHoldsIntegralAtLimit() {
+    dsp::Pid<Sample> pid({.kp = 0.1f, .ki = 10}, kTickHz, Unit<Sample>(-1), Unit<Sample>(1));
+    for (int i = 0; i < 1000; ++i) {
+        pid.Update(Unit<Sample>(2), 0);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, FromUnit(pid.GetOutput()));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.58f, FromUnit(pid.Update(Unit<Sample>(-2), 0)));
+}
+
+// Derivative on the measurement: a setpoint step is kp*e only; a measurement step of 0.001
+// in one tick is -kd * 1/s, through the low-pass (alpha = w / (1 + w), w = 2*pi*100/1000)
+template <typename Sample>
+void AssertDerivativeOnMeasurement() {
+    dsp::Pid<Sample> pid({.kp = 1, .kd = 0.1f}, kTickHz, Unit<Sample>(-100), Unit<Sample>(100));
+    dsp::Pid<Sample> filtered({.kp = 1, .kd = 0.1f, .derivative_hz = 100}, kTickHz, Unit<Sample>(-100),
+                              Unit<Sample>(100));
+    constexpr float w = 6.2831853f * 100 / 1000;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, FromUnit(pid.Update(Unit<Sample>(1), 0)));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.999f - 0.1f, FromUnit(pid.Update(Unit<Sample>(1), Unit<Sample>(0.001f))));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.999f - 0.1f * w / (1 + w),
+                             FromUnit(filtered.Update(Unit<Sample>(1), Unit<Sample>(0.001f))));
+}
+
+// Reset() hands over without a bump: the first output continues from the one given
+template <typename Sample>
+void AssertResetsBumplessly() {
+    dsp::Pid<Sample> pid({.kp = 2, .ki = 5, .kd = 0.1f}, kTickHz, Unit<Sample>(-1), Unit<Sample>(1));
+    pid.Update(Unit<Sample>(3), 0);
+    pid.Reset(Unit<Sample>(0.5f), Unit<Sample>(0.3f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.3f, FromUnit(pid.Update(Unit<Sample>(0.5f), Unit<Sample>(0.5f))));
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_long_move() {
+    AssertTracks<float>("long move", 50'000);
+    AssertTracks<q31_t>("long move", 50'000);
+}
+
+void test_long_move_down() {
+    AssertTracks<float>("long move down", -20'000);
+    AssertTracks<q31_t>("long move down", -20'000);
+}
+
+void test_short_move() {
+    AssertTracks<float>("short move", 2'000);
+    AssertTracks<q31_t>("short move", 2'000);
+}
+
+void test_one_count_move() {
+    AssertTracks<float>("one-count move", 1);
+    AssertTracks<q31_t>("one-count move", 1);
+}
+
+void test_jam_recovery() {
+    AssertRecoversFromJam<float>();
+    AssertRecoversFromJam<q31_t>();
+}
+
+void test_anti_windup() {
+    AssertHoldsIntegralAtLimit<float>();
+    AssertHoldsIntegralAtLimit<q31_t>();
+}
+
+void test_derivative_on_measurement() {
+    AssertDerivativeOnMeasurement<float>();
+    AssertDerivativeOnMeasurement<q31_t>();
+}
+
+void test_q31_integrates_one_lsb() {
+    // A one-LSB error integrates to one LSB of output per 1 / (ki*Ts) ticks, with no stall
+    dsp::Pid<q31_t> pid({.kp = 0, .ki = 1}, kTickHz, INT32_MIN, INT32_MAX);
+    for (int i = 0; i < 1000; ++i) {
+        pid.Update(1, 0);
+    }
+    TEST_ASSERT_EQUAL_INT32(1, pid.GetOutput());
+    for (int i = 0; i < 1000; ++i) {
+        pid.Update(1, 0);
+    }
+    TEST_ASSERT_EQUAL_INT32(2, pid.GetOutput());
+}
+
+void test_bumpless_reset() {
+    AssertResetsBumplessly<float>();
+    AssertResetsBumplessly<q31_t>();
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_long_move);
+    RUN_TEST(test_long_move_down);
+    RUN_TEST(test_short_move);
+    RUN_TEST(test_one_count_move);
+    RUN_TEST(test_jam_recovery);
+    RUN_TEST(test_anti_windup);
+    RUN_TEST(test_derivative_on_measurement);
+    RUN_TEST(test_q31_integrates_one_lsb);
+    RUN_TEST(test_bumpless_reset);
+    return UNITY_END();
+}
@@ -0,0 +1,239 @@
+// Complementary PWM: the BDTR DTG encoding from ComputeDeadTime() (80 MHz TIM1 clock),
+// and the registers Pwm programs on the simulated TIM1, played out over a PWM period.
+
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "hal/pwm.hpp"
+#include "sim_hal.hpp"
+
+namespace {
+
+constexpr std::uint32_t kTimerHz = 80'000'000;
+constexpr std::uint32_t kPeriod = 200;
+
+TIM_HandleTypeDef htim;
+
+void AssertDeadTime(std::uint32_t dead_time_ns, std::uint8_t dtg) {
+    const auto dead_time = hal::ComputeDeadTime(kTimerHz, dead_time_ns);
+    TEST_ASSERT_TRUE(dead_time.has_value());
+    TEST_ASSERT_EQUAL_HEX8(dtg, *dead_time);
+}
+
+struct Outputs {
+    std::vector<bool> high;      // CHx, one entry per timer tick
+    std::vector<bool> low_side;  // CHxN
+};
+
+// Plays one centre-aligned period (counter 0 -> ARR -> 0) through the output stage as
+// RM0351 describes it: PWM mode 1 reference (high below the compare), each output's
+// rising edge delayed by the dead time, and both outputs at their idle level while
+// MOE is clear. Only the register values Pwm wrote are used.
+Outputs PlayPeriod(std::size_t channel) {
+    const TIM_TypeDef* const tim = htim.Instance;
+    const std::uint32_t compare = (&tim->CCR1)[channel];
+    const std::uint32_t dead_time = hal::DeadTimeTicks(tim->BDTR & TIM_BDTR_DTG);
+    const bool enabled = (tim->BDTR & TIM_BDTR_MOE) != 0;
+
+    std::vector<bool> reference;
+    for (std::uint32_t count = 0; count < tim->ARR; ++count) {
+        reference.push_back(count < compare);
+    }
+    // Counting down, the compare match at CNT = CCR is where the reference goes high again
+    for (std::uint32_t count = tim->ARR; count > 0; --count) {
+        reference.push_back(count <= compare);
+    }
+
+    // An output goes high only once its side of the reference has held for the dead time
+    Outputs outputs;
+    std::uint32_t held_high = 0;
+    std::uint32_t held_low = 0;
+    for (std::size_t i = 0; i < reference.size() * 2; ++i) {  // second pass: steady state
+        const bool ref = reference[i % reference.size()];
+        held_high = ref ? held_high + 1 : 0;
+        held_low = ref ? 0 : held_low + 1;
+        if (i >= reference.size()) {
+            outputs.high.push_back(enabled && held_high > dead_time);
+            outputs.low_side.push_back(enabled && held_low > dead_time);
+        }
+    }
+    return outputs;
+}
+
+std::uint32_t Count(const std::vector<bool>& levels) {
+    std::uint32_t count = 0;
+    for (const bool level : levels) {
+        count += level ? 1 : 0;
+    }
+    return count;
+}
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    htim = {};
+    htim.Instance = TIM1;
+    htim.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+    htim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim.Instance->ARR = kPeriod;
+}
+
+void tearDown() {}
+
+void test_dead_time_encoding() {
+    // 12.5 ns ticks: 500 ns = 40 ticks, straight into the 1-tick range
+    AssertDeadTime(500, 40);
+    AssertDeadTime(0, 0);
+    // Rounded up, never down: 10 ns is under one tick
+    AssertDeadTime(10, 1);
+    // 2 us = 160 ticks = (64 + 16) * 2
+    AssertDeadTime(2'000, 0x90);
+    // 5 us = 400 ticks = (32 + 18) * 8
+    AssertDeadTime(5'000, 0xD2);
+    // 10 us = 800 ticks = (32 + 18) * 16
+    AssertDeadTime(10'000, 0xF2);
+}
+
+void test_dead_time_beyond_dtg_rejected() {
+    // 1008 ticks (12.6 us) is the longest the field holds
+    TEST_ASSERT_TRUE(hal::ComputeDeadTime(kTimerHz, 12'600).has_value());
+    TEST_ASSERT_FALSE(hal::ComputeDeadTime(kTimerHz, 12'700).has_value());
+    TEST_ASSERT_FALSE(hal::ComputeDeadTime(0, 500).has_value());
+}
+
+void test_dead_time_encoding_rounds_up() {
+    // Every tick count encodes to the shortest step that is not shorter than asked for
+    for (std::uint32_t ticks = 0; ticks <= hal::kMaxDeadTimeTicks; ++ticks) {
+        const auto dead_time = hal::ComputeDeadTime(1'000'000'000, ticks);  // 1 ns ticks
+        TEST_ASSERT_TRUE(dead_time.has_value());
+        const std::uint32_t step = (ticks <= 127) ? 1 : (ticks <= 254) ? 2 : (ticks <= 504) ? 8 : 16;
+        const std::uint32_t encoded = hal::DeadTimeTicks(*dead_time);
+        TEST_ASSERT_TRUE(encoded >= ticks);
+        TEST_ASSERT_TRUE(encoded < ticks + step);
+    }
+}
+
+void test_configure_rejects_edge_aligned_and_divided_clock() {
+    hal::Pwm pwm(htim);
+    htim.Init.CounterMode = TIM_COUNTERMODE_UP;
+    TEST_ASSERT_FALSE(pwm.Configure(40));
+
+    htim.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+    htim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV2;
+    TEST_ASSERT_FALSE(pwm.Configure(40));
+    TEST_ASSERT_EQUAL_HEX32(0, TIM1->CCER);
+}
+
+void test_configure_sets_complementary_pairs() {
+    hal::Pwm pwm(htim);
+    TIM1->BDTR = TIM_BDTR_MOE | TIM_BDTR_BKE | TIM_BDTR_AOE;  // as HAL_TIM_PWM_Start() may leave it
+    TIM1->CCR1 = 50;
+    TIM1->CR2 = TIM_CR2_OIS1 | TIM_CR2_OIS1N;
+    TIM1->CCER = TIM_CCER_CC1P | TIM_CCER_CC2NP;
+
+    TEST_ASSERT_TRUE(pwm.Configure(40));
+    TEST_ASSERT_FALSE(pwm.IsEnabled());
+    TEST_ASSERT_EQUAL_UINT32(40, TIM1->BDTR & TIM_BDTR_DTG);
+    TEST_ASSERT_EQUAL_HEX32(TIM_BDTR_OSSI | TIM_BDTR_OSSR, TIM1->BDTR & (TIM_BDTR_OSSI | TIM_BDTR_OSSR));
+    TEST_ASSERT_EQUAL_HEX32(0, TIM1->BDTR & (TIM_BDTR_BKE | TIM_BDTR_AOE));
+    TEST_ASSERT_EQUAL_HEX32(0, TIM1->CR2 & (TIM_CR2_OIS1 | TIM_CR2_OIS1N));
+
+    // Both outputs of every pair enabled and active high
+    TEST_ASSERT_EQUAL_HEX32(TIM_CCER_CC1E | TIM_CCER_CC1NE | TIM_CCER_CC2E | TIM_CCER_CC2NE | TIM_CCER_CC3E |
+                                TIM_CCER_CC3NE,
+                            TIM1->CCER);
+
+    // PWM mode 1 with preload on CH1-CH3, and every duty at zero
+    TEST_ASSERT_EQUAL_HEX32(TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1, TIM1->CCMR1 & TIM_CCMR1_OC1M);
+    TEST_ASSERT_TRUE((TIM1->CCMR1 & TIM_CCMR1_OC1PE) != 0);
+    TEST_ASSERT_TRUE((TIM1->CCMR1 & TIM_CCMR1_OC2PE) != 0);
+    TEST_ASSERT_EQUAL_HEX32(TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1, TIM1->CCMR2 & TIM_CCMR2_OC3M);
+    TEST_ASSERT_TRUE((TIM1->CCMR2 & TIM_CCMR2_OC3PE) != 0);
+    TEST_ASSERT_EQUAL_UINT32(0, TIM1->CCR1);
+    TEST_ASSERT_EQUAL_UINT32(0, TIM1->CCR2);
+    TEST_ASSERT_EQUAL_UINT32(0, TIM1->CCR3);
+}
+
+void test_outputs_never_overlap_and_gap_is_dead_time() {
+    hal::Pwm pwm(htim);
+    constexpr std::uint32_t kDeadTicks = 40;  // 500 ns
+    TEST_ASSERT_TRUE(pwm.Configure(*hal::ComputeDeadTime(kTimerHz, 500)));
+    pwm.Enable();
+    pwm.SetDuties(50, 100, 150);
+
+    for (std::size_t channel = 0; channel < hal::Pwm::kChannels; ++channel) {
+        const std::uint32_t compare = (&TIM1->CCR1)[channel];
+        const Outputs outputs = PlayPeriod(channel);
+        for (std::size_t i = 0; i < outputs.high.size(); ++i) {
+            TEST_ASSERT_FALSE(outputs.high[i] && outputs.low_side[i]);
+        }
+        // The reference is high for 2 * compare ticks; each output loses the dead time
+        // from its rising edge, so a dead time's worth of both-off sits at each edge
+        TEST_ASSERT_EQUAL_UINT32(2 * compare - kDeadTicks, Count(outputs.high));
+        TEST_ASSERT_EQUAL_UINT32(2 * kPeriod - 2 * compare - kDeadTicks, Count(outputs.low_side));
+    }
+}
+
+void test_high_side_pulse_centred_on_valley() {
+    hal::Pwm pwm(htim);
+    TEST_ASSERT_TRUE(pwm.Configure(0));
+    pwm.Enable();
+    pwm.SetDuty(0, 30);
+
+    // Counter at 0 at both ends of the period: the pulse wraps the valley symmetrically
+    const Outputs outputs = PlayPeriod(0);
+    TEST_ASSERT_EQUAL_UINT32(60, Count(outputs.high));
+    TEST_ASSERT_TRUE(outputs.high.front());
+    TEST_ASSERT_TRUE(outputs.high[29]);
+    TEST_ASSERT_FALSE(outputs.high[30]);
+    TEST_ASSERT_TRUE(outputs.high[outputs.high.size() - 30]);
+    TEST_ASSERT_FALSE(outputs.high[outputs.high.size() - 31]);
+}
+
+void test_disable_drives_both_outputs_low() {
+    hal::Pwm pwm(htim);
+    TEST_ASSERT_TRUE(pwm.Configure(40));
+    pwm.SetDuties(50, 100, 150);
+
+    // Configured but not enabled: every output idles low
+    TEST_ASSERT_EQUAL_UINT32(0, Count(PlayPeriod(1).high) + Count(PlayPeriod(1).low_side));
+
+    pwm.Enable();
+    TEST_ASSERT_TRUE(pwm.IsEnabled());
+    TEST_ASSERT_TRUE(Count(PlayPeriod(1).high) > 0);
+
+    pwm.Disable();
+    TEST_ASSERT_FALSE(pwm.IsEnabled());
+    for (std::size_t channel = 0; channel < hal::Pwm::kChannels; ++channel) {
+        const Outputs outputs = PlayPeriod(channel);
+        TEST_ASSERT_EQUAL_UINT32(0, Count(outputs.high) + Count(outputs.low_side));
+    }
+}
+
+void test_set_duty_ignores_out_of_range_channel() {
+    hal::Pwm pwm(htim);
+    TEST_ASSERT_TRUE(pwm.Configure(40));
+    TIM1->CCR4 = 123;  // PwmSync's ADC trigger compare
+    pwm.SetDuty(3, 77);
+    TEST_ASSERT_EQUAL_UINT32(123, TIM1->CCR4);
+    pwm.SetDuty(2, 77);
+    TEST_ASSERT_EQUAL_UINT32(77, TIM1->CCR3);
+    TEST_ASSERT_EQUAL_UINT32(kPeriod, pwm.GetPeriod());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_dead_time_encoding);
+    RUN_TEST(test_dead_time_beyond_dtg_rejected);
+    RUN_TEST(test_dead_time_encoding_rounds_up);
+    RUN_TEST(test_configure_rejects_edge_aligned_and_divided_clock);
+    RUN_TEST(test_configure_sets_complementary_pairs);
+    RUN_TEST(test_outputs_never_overlap_and_gap_is_dead_time);
+    RUN_TEST(test_high_side_pulse_centred_on_valley);
+    RUN_TEST(test_disable_drives_both_outputs_low);
+    RUN_TEST(test_set_duty_ignores_out_of_range_channel);
+    return UNITY_END();
+}
@@ -0,0 +1,121 @@
+// PWM-synchronised ADC triggering: ComputePwmSyncTiming() across the PWM range we
+// expect to drive (80 MHz TIM1 clock, 4 MHz ADC clock), and PwmSync on the simulated TIM1.
+
+#include <unity.h>
+
+#include <cstdint>
+
+#include "hal/pwm_sync.hpp"
+#include "sim_hal.hpp"
+
+namespace {
+
+constexpr std::uint32_t kTimerHz = 80'000'000;
+constexpr std::uint32_t kAdcHz = 4'000'000;
+
+std::expected<hal::PwmSyncTiming, awb::Error> Timing(std::uint32_t pwm_hz, std::uint32_t sampling_time) {
+    return hal::ComputePwmSyncTiming({kTimerHz, pwm_hz, kAdcHz, sampling_time});
+}
+
+void AssertTiming(std::uint32_t pwm_hz, std::uint32_t sampling_time, std::uint32_t period, std::uint32_t compare) {
+    const auto timing = Timing(pwm_hz, sampling_time);
+    TEST_ASSERT_TRUE(timing.has_value());
+    TEST_ASSERT_EQUAL_UINT32(period, timing->period);
+    TEST_ASSERT_EQUAL_UINT32(compare, timing->trigger_compare);
+}
+
+TIM_HandleTypeDef htim;
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    htim = {};
+    htim.Instance = TIM1;
+    htim.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+}
+
+void tearDown() {}
+
+void test_trigger_lead_is_a_fixed_time() {
+    // 24.5-cycle window: lead = (2.5 + 12.25) cycles at 4 MHz = 3.6875 us = 295 ticks at 80 MHz
+    AssertTiming(10'000, ADC_SAMPLETIME_24CYCLES_5, 4000, 295);
+    AssertTiming(20'000, ADC_SAMPLETIME_24CYCLES_5, 2000, 295);
+    AssertTiming(40'000, ADC_SAMPLETIME_24CYCLES_5, 1000, 295);
+}
+
+void test_non_integer_period_rounds() {
+    // The lead is a time, so it stays 295 ticks while the period shrinks
+    AssertTiming(33'000, ADC_SAMPLETIME_24CYCLES_5, 1212, 295);
+}
+
+void test_long_sampling_window() {
+    // 92.5-cycle window: lead = (2.5 + 46.25) cycles = 12.1875 us = 975 ticks
+    AssertTiming(20'000, ADC_SAMPLETIME_92CYCLES_5, 2000, 975);
+}
+
+void test_rejects_conversion_longer_than_period() {
+    // At 40 kHz a 92.5-cycle conversion (26.9 us) no longer fits in the 25 us period
+    TEST_ASSERT_FALSE(Timing(40'000, ADC_SAMPLETIME_92CYCLES_5).has_value());
+}
+
+void test_rejects_window_wider_than_half_period() {
+    // Half the sampling window plus latency exceeds half the period
+    TEST_ASSERT_FALSE(Timing(100'000, ADC_SAMPLETIME_47CYCLES_5).has_value());
+}
+
+void test_rejects_out_of_range_frequency() {
+    // Below ~610 Hz the period overflows TIM1's 16-bit auto-reload
+    TEST_ASSERT_FALSE(Timing(500, ADC_SAMPLETIME_24CYCLES_5).has_value());
+    TEST_ASSERT_FALSE(Timing(0, ADC_SAMPLETIME_24CYCLES_5).has_value());
+    TEST_ASSERT_EQUAL(awb::Error::InvalidParam, Timing(0, ADC_SAMPLETIME_24CYCLES_5).error());
+}
+
+void test_start_programs_timer() {
+    hal::PwmSync pwm(htim);
+    const auto timing = Timing(20'000, ADC_SAMPLETIME_24CYCLES_5);
+    TEST_ASSERT_TRUE(timing.has_value());
+
+    TIM1->CNT = 1234;
+    TEST_ASSERT_TRUE(pwm.Start(*timing));
+    TEST_ASSERT_EQUAL_UINT32(2000, TIM1->ARR);
+    TEST_ASSERT_EQUAL_UINT32(295, TIM1->CCR4);
+    TEST_ASSERT_EQUAL_UINT32(0, TIM1->CNT);
+    TEST_ASSERT_EQUAL_UINT32(TIM_EGR_UG, TIM1->EGR);
+    TEST_ASSERT_EQUAL_UINT32(2000, pwm.GetPeriod());
+    TEST_ASSERT_TRUE(TIM1->CR1 & 0x1U);
+
+    pwm.Stop();
+    TEST_ASSERT_FALSE(TIM1->CR1 & 0x1U);
+}
+
+void test_start_rejects_edge_aligned_timer() {
+    hal::PwmSync pwm(htim);
+    htim.Init.CounterMode = TIM_COUNTERMODE_UP;
+
+    TEST_ASSERT_FALSE(pwm.Start({2000, 295}));
+    TEST_ASSERT_FALSE(TIM1->CR1 & 0x1U);
+}
+
+void test_start_rejects_compare_outside_period() {
+    hal::PwmSync pwm(htim);
+
+    TEST_ASSERT_FALSE(pwm.Start({2000, 0}));
+    TEST_ASSERT_FALSE(pwm.Start({2000, 2000}));
+    TEST_ASSERT_FALSE(pwm.Start({1, 1}));
+    TEST_ASSERT_FALSE(TIM1->CR1 & 0x1U);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_trigger_lead_is_a_fixed_time);
+    RUN_TEST(test_non_integer_period_rounds);
+    RUN_TEST(test_long_sampling_window);
+    RUN_TEST(test_rejects_conversion_longer_than_period);
+    RUN_TEST(test_rejects_window_wider_than_half_period);
+    RUN_TEST(test_rejects_out_of_range_frequency);
+    RUN_TEST(test_start_programs_timer);
+    RUN_TEST(test_start_rejects_edge_aligned_timer);
+    RUN_TEST(test_start_rejects_compare_outside_period);
+    return UNITY_END();
+}
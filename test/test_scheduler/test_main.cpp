@@ -0,0 +1,243 @@
+// awb::Scheduler driven by a fake Clock policy: simulated ticks and cycles, and
+// task bodies that consume a chosen number of cycles.
+
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "util/scheduler.hpp"
+
+namespace {
+
+constexpr uint32_t kCyclesPerTick = 1000;
+
+// The cycle counter is derived from the tick, so the two always agree (and wrap independently)
+struct FakeClock {
+    static inline uint32_t tick = 0;
+    static inline uint32_t into = 0;  // Cycles since the tick began
+
+    static uint32_t Now() { return tick; }
+    static uint32_t Cycles() { return tick * kCyclesPerTick + into; }
+    static uint32_t CyclesPerTick() { return kCyclesPerTick; }
+    static uint32_t CyclesIntoTick() { return into; }
+    static void Idle(uint32_t /*max_ticks*/) { GoTo(tick + 1); }
+
+    static void GoTo(uint32_t new_tick, uint32_t new_into = 0) {
+        tick = new_tick;
+        into = new_into;
+    }
+    static void Burn(uint32_t cycles) {
+        tick += (into + cycles) / kCyclesPerTick;
+        into = (into + cycles) % kCyclesPerTick;
+    }
+};
+
+struct Run {
+    int task;
+    uint32_t tick;
+};
+
+std::vector<Run> runs;
+std::array<uint32_t, 3> burn{};  // Cycles each task consumes
+
+template <int Id>
+void Body() {
+    runs.push_back({Id, FakeClock::Now()});
+    FakeClock::Burn(burn[Id]);
+}
+
+using Scheduler = awb::Scheduler<3, FakeClock>;
+
+// Listed out of priority order on purpose
+constexpr std::array<awb::Task, 3> kTasks{{
+    {"slow", Body<2>, 10, 2},
+    {"fast", Body<0>, 1, 0},
+    {"mid", Body<1>, 3, 1},
+}};
+
+// GetStats() indexes tasks in priority order: fast, mid, slow
+constexpr std::size_t kFast = 0;
+constexpr std::size_t kMid = 1;
+constexpr std::size_t kSlow = 2;
+
+}  // namespace
+
+void setUp() {
+    FakeClock::GoTo(0);
+    runs.clear();
+    burn = {};
+}
+
+void tearDown() {}
+
+void test_tasks_sorted_by_priority() {
+    Scheduler scheduler(kTasks);
+    TEST_ASSERT_EQUAL_STRING("fast", scheduler.GetTasks()[kFast].name);
+    TEST_ASSERT_EQUAL_STRING("mid", scheduler.GetTasks()[kMid].name);
+    TEST_ASSERT_EQUAL_STRING("slow", scheduler.GetTasks()[kSlow].name);
+
+    scheduler.Start();
+    TEST_ASSERT_TRUE(scheduler.Poll());
+    TEST_ASSERT_EQUAL(3, runs.size());
+    TEST_ASSERT_EQUAL_INT(0, runs[0].task);
+    TEST_ASSERT_EQUAL_INT(1, runs[1].task);
+    TEST_ASSERT_EQUAL_INT(2, runs[2].task);
+}
+
+void test_poll_runs_once_per_tick() {
+    Scheduler scheduler(kTasks);
+    scheduler.Start();
+    TEST_ASSERT_TRUE(scheduler.Poll());
+    FakeClock::GoTo(0, 500);
+    TEST_ASSERT_FALSE(scheduler.Poll());
+    TEST_ASSERT_EQUAL(3, runs.size());
+}
+
+void test_periods_are_stable() {
+    Scheduler scheduler(kTasks);
+    burn = {50, 200, 400};
+    scheduler.Start();
+
+    for (uint32_t tick = 0; tick < 100; ++tick) {
+        FakeClock::GoTo(tick, 10);
+        TEST_ASSERT_TRUE(scheduler.Poll());
+    }
+
+    // Every release lands exactly one period after the previous one
+    constexpr uint32_t kPeriods[] = {1, 3, 10};
+    for (int task = 0; task < 3; ++task) {
+        uint32_t expected = 0;
+        for (const Run& run : runs) {
+            if (run.task == task) {
+                TEST_ASSERT_EQUAL_UINT32(expected, run.tick);
+                expected += kPeriods[task];
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.GetStats(kFast).runs);
+    TEST_ASSERT_EQUAL_UINT32(34, scheduler.GetStats(kMid).runs);
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.GetStats(kSlow).runs);
+    for (std::size_t i = 0; i < 3; ++i) {
+        TEST_ASSERT_EQUAL_UINT32(0, scheduler.GetStats(i).deadline_misses);
+        TEST_ASSERT_EQUAL_UINT32(0, scheduler.GetStats(i).overruns);
+    }
+}
+
+void test_late_start_counts_misses_without_catching_up() {
+    Scheduler scheduler(kTasks);
+    scheduler.Start();
+    scheduler.Poll();
+
+    // 35 ticks pass unpolled: slow (period 10) missed its releases at 10 and 20, runs once for 30
+    FakeClock::GoTo(35);
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.GetStats(kSlow).deadline_misses);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.GetStats(kSlow).runs);
+    TEST_ASSERT_EQUAL_UINT32(34, scheduler.GetStats(kFast).deadline_misses);
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.GetStats(kMid).deadline_misses);
+
+    // The schedule stays on its original grid: next release at 40, not 45
+    for (uint32_t tick = 36; tick < 40; ++tick) {
+        FakeClock::GoTo(tick);
+        scheduler.Poll();
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.GetStats(kSlow).runs);
+    FakeClock::GoTo(40);
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(3, scheduler.GetStats(kSlow).runs);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.GetStats(kSlow).deadline_misses);
+}
+
+void test_overrun_is_longer_than_one_period() {
+    Scheduler scheduler(kTasks);
+    scheduler.Start();
+
+    burn[0] = kCyclesPerTick;  // Exactly one period: not an overrun
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.GetStats(kFast).overruns);
+    TEST_ASSERT_EQUAL_UINT32(kCyclesPerTick, scheduler.GetStats(kFast).last_cycles);
+
+    burn[0] = kCyclesPerTick + 1;
+    FakeClock::GoTo(1);
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.GetStats(kFast).overruns);
+    TEST_ASSERT_EQUAL_UINT32(kCyclesPerTick + 1, scheduler.GetStats(kFast).max_cycles);
+
+    // The overrun pushed fast past tick 2 (started at 1, ran into 2): polling at 3 counts a miss
+    burn[0] = 0;
+    FakeClock::GoTo(3);
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.GetStats(kFast).deadline_misses);
+}
+
+void test_latency_measured_from_release() {
+    Scheduler scheduler(kTasks);
+    burn = {100, 300, 0};
+    scheduler.Start();
+
+    // Polled 250 cycles after the release tick began
+    FakeClock::GoTo(0, 250);
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.GetStats(kFast).max_latency_cycles);
+    TEST_ASSERT_EQUAL_UINT32(350, scheduler.GetStats(kMid).max_latency_cycles);
+    TEST_ASSERT_EQUAL_UINT32(650, scheduler.GetStats(kSlow).max_latency_cycles);
+
+    // mid is due at 3; a poll at 4 is late by a whole tick but not a full period
+    scheduler.ResetStats();
+    for (uint32_t tick = 1; tick <= 2; ++tick) {
+        FakeClock::GoTo(tick);
+        scheduler.Poll();
+    }
+    FakeClock::GoTo(4, 20);
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.GetStats(kMid).deadline_misses);
+    TEST_ASSERT_EQUAL_UINT32(kCyclesPerTick + 20 + 100, scheduler.GetStats(kMid).max_latency_cycles);
+}
+
+void test_idle_until_next_release() {
+    Scheduler scheduler({{
+        {"a", Body<0>, 5, 0},
+        {"b", Body<1>, 7, 1},
+        {"c", Body<2>, 20, 2},
+    }});
+    scheduler.Start();
+    scheduler.Poll();
+
+    FakeClock::GoTo(2);
+    TEST_ASSERT_EQUAL_UINT32(3, scheduler.TicksUntilNextRelease());
+    FakeClock::GoTo(5);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.TicksUntilNextRelease());
+    scheduler.Poll();
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.TicksUntilNextRelease());
+}
+
+void test_tick_counter_wrap() {
+    Scheduler scheduler(kTasks);
+    FakeClock::GoTo(UINT32_MAX - 5);
+    burn = {100, 100, 100};
+    scheduler.Start();
+
+    // The tick counter wraps part way through
+    for (uint32_t i = 0; i < 20; ++i) {
+        FakeClock::GoTo(UINT32_MAX - 5 + i, 30);
+        scheduler.Poll();
+    }
+    TEST_ASSERT_EQUAL_UINT32(20, scheduler.GetStats(kFast).runs);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.GetStats(kSlow).runs);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.GetStats(kFast).deadline_misses);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tasks_sorted_by_priority);
+    RUN_TEST(test_poll_runs_once_per_tick);
+    RUN_TEST(test_periods_are_stable);
+    RUN_TEST(test_late_start_counts_misses_without_catching_up);
+    RUN_TEST(test_overrun_is_longer_than_one_period);
+    RUN_TEST(test_latency_measured_from_release);
+    RUN_TEST(test_idle_until_next_release);
+    RUN_TEST(test_tick_counter_wrap);
+    return UNITY_END();
+}
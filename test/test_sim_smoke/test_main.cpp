@@ -0,0 +1,94 @@
+// Smoke test of the host simulation (env:native): the HAL drivers run unchanged
+// against boards/native and the simulated peripherals respond as they do on target.
+
+#include <unity.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "adc.h"
+#include "gpio.h"
+#include "hal/adc.hpp"
+#include "hal/gpio.hpp"
+#include "hal/uart.hpp"
+#include "sim_hal.hpp"
+#include "usart.h"
+
+void setUp() {
+    sim::Reset();
+    MX_GPIO_Init();
+    MX_ADC1_Init();
+    MX_USART2_UART_Init();
+}
+
+void tearDown() {}
+
+void test_gpio_output_reads_back() {
+    hal::Gpio led(GPIOA_BASE, GPIO_PIN_5);
+    TEST_ASSERT_FALSE(led.IsHigh());
+
+    led.Set();
+    TEST_ASSERT_TRUE(led.IsHigh());
+    led.Toggle();
+    TEST_ASSERT_EQUAL(hal::Level::Low, led.ReadLevel());
+    led.Write(1);
+    TEST_ASSERT_EQUAL_INT(1, led.Read());
+}
+
+void test_gpio_input_follows_driven_level() {
+    hal::Gpio button(GPIOC_BASE, GPIO_PIN_13);
+
+    sim::SetInput(GPIOC, GPIO_PIN_13, true);
+    TEST_ASSERT_TRUE(button.IsHigh());
+    sim::SetInput(GPIOC, GPIO_PIN_13, false);
+    TEST_ASSERT_FALSE(button.IsHigh());
+}
+
+void test_adc_dma_fills_buffer_from_waveform() {
+    hal::Adc<std::uint16_t> adc(hadc1);
+    std::uint16_t buffer[8]{};
+    sim::SetAdcWaveform(hadc1, [](std::uint32_t n) { return 1000 + n; });
+
+    TEST_ASSERT_TRUE(adc.Start(buffer, 8));
+    sim::RunAdc(hadc1, 8);
+
+    for (std::uint16_t i = 0; i < 8; ++i) {
+        TEST_ASSERT_EQUAL_UINT16(1000 + i, buffer[i]);
+    }
+    const auto average = adc.ReadAverage();
+    TEST_ASSERT_TRUE(average.has_value());
+    TEST_ASSERT_EQUAL_UINT16(1003, *average);
+    adc.Stop();
+}
+
+void test_uart_blocking_write_and_read() {
+    hal::Uart uart(huart2);
+    const char message[] = "hello";
+    uart.Write(reinterpret_cast<const std::uint8_t*>(message), std::strlen(message));
+    TEST_ASSERT_EQUAL_STRING("hello", sim::UartOutput(huart2).c_str());
+
+    sim::InjectUartRx(huart2, "ok");
+    std::uint8_t reply[2]{};
+    TEST_ASSERT_TRUE(uart.Read(reply, sizeof(reply), 10));
+    TEST_ASSERT_EQUAL_MEMORY("ok", reply, 2);
+}
+
+void test_uart_dma_write_completes_on_flush() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    const char message[] = "dma";
+    uart.Write(reinterpret_cast<const std::uint8_t*>(message), std::strlen(message));
+
+    TEST_ASSERT_TRUE(uart.Flush(10));
+    TEST_ASSERT_EQUAL_STRING("dma", sim::UartOutput(huart2).c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, uart.GetDroppedBytes());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_gpio_output_reads_back);
+    RUN_TEST(test_gpio_input_follows_driven_level);
+    RUN_TEST(test_adc_dma_fills_buffer_from_waveform);
+    RUN_TEST(test_uart_blocking_write_and_read);
+    RUN_TEST(test_uart_dma_write_completes_on_flush);
+    return UNITY_END();
+}
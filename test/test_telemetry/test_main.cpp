@@ -0,0 +1,204 @@
+// Binary telemetry framing: known answers for the COBS and CRC primitives the host
+// decoder mirrors, and packets sent through the Logger decoded back on the host side.
+
+#include <unity.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "hal/uart.hpp"
+#include "sim_hal.hpp"
+#include "usart.h"
+#include "util/cobs.hpp"
+#include "util/crc.hpp"
+#include "util/logger.hpp"
+#include "util/telemetry.hpp"
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+Bytes Encode(const Bytes& in) {
+    Bytes out(awb::CobsMaxEncodedSize(in.size()));
+    out.resize(awb::CobsEncode(in.data(), in.size(), out.data()));
+    return out;
+}
+
+// Reference decoder, as tools/telemetry_decoder.py does it
+Bytes Decode(const Bytes& in) {
+    Bytes out;
+    std::size_t i = 0;
+    while (i < in.size()) {
+        const std::uint8_t code = in[i++];
+        for (std::uint8_t k = 1; k < code && i < in.size(); ++k) {
+            out.push_back(in[i++]);
+        }
+        if (code != 0xFF && i < in.size()) {
+            out.push_back(0);
+        }
+    }
+    return out;
+}
+
+// Splits the console output into packets: COBS-decoded, CRC checked and stripped. A
+// packet that fails the check is dropped, which the tests see as a missing packet.
+std::vector<Bytes> ReceivePackets() {
+    const std::string& output = sim::UartOutput(huart2);
+    std::vector<Bytes> packets;
+    Bytes frame;
+    for (const char c : output) {
+        if (c != 0) {
+            frame.push_back(static_cast<std::uint8_t>(c));
+            continue;
+        }
+        if (!frame.empty()) {
+            Bytes packet = Decode(frame);
+            if (packet.size() >= 3) {
+                const std::uint16_t crc = packet[packet.size() - 2] | (packet[packet.size() - 1] << 8);
+                packet.resize(packet.size() - 2);
+                if (awb::Crc16(packet.data(), packet.size()) == crc) {
+                    packets.push_back(packet);
+                }
+            }
+        }
+        frame.clear();
+    }
+    return packets;
+}
+
+constexpr std::uint8_t kCheck[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    MX_USART2_UART_Init();
+}
+
+void tearDown() {}
+
+void test_cobs_known_answers() {
+    TEST_ASSERT_TRUE(Encode({0x00}) == Bytes({0x01, 0x01}));
+    TEST_ASSERT_TRUE(Encode({0x11, 0x22, 0x00, 0x33}) == Bytes({0x03, 0x11, 0x22, 0x02, 0x33}));
+    TEST_ASSERT_TRUE(Encode({0x11, 0x00, 0x00}) == Bytes({0x02, 0x11, 0x01, 0x01}));
+}
+
+void test_cobs_full_block_has_no_phantom_zero() {
+    Bytes in(254);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<std::uint8_t>(i + 1);
+    }
+    const Bytes out = Encode(in);
+    TEST_ASSERT_EQUAL(256, out.size());
+    TEST_ASSERT_EQUAL_HEX8(0xFF, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, out[255]);
+    TEST_ASSERT_TRUE(Decode(out) == in);
+}
+
+void test_cobs_output_has_no_zeros() {
+    Bytes in(600);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<std::uint8_t>((i * 37) % 7 == 0 ? 0 : i);
+    }
+    const Bytes out = Encode(in);
+    TEST_ASSERT_LESS_OR_EQUAL(awb::CobsMaxEncodedSize(in.size()), out.size());
+    for (const std::uint8_t b : out) {
+        TEST_ASSERT_NOT_EQUAL(0, b);
+    }
+    TEST_ASSERT_TRUE(Decode(out) == in);
+}
+
+void test_crc_check_values() {
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, awb::Crc16(kCheck, sizeof(kCheck)));
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, awb::Crc32(kCheck, sizeof(kCheck)));
+}
+
+void test_schema_and_samples_round_trip() {
+    hal::Uart uart(huart2);
+    Logger::GetInstance().Init(&uart);
+    sim::AdvanceTime(1234);
+
+    using awb::telemetry::SignalType;
+    awb::Telemetry<2> telemetry(Logger::GetInstance(),
+                                {{{"current", SignalType::I16}, {"position", SignalType::I32}}}, 10, 2);
+    telemetry.Begin();
+    telemetry.Record({40000, -5});  // Saturated to int16
+    telemetry.Record({-7});         // Missing values are 0
+
+    const auto packets = ReceivePackets();
+    TEST_ASSERT_EQUAL(2, packets.size());
+
+    const Bytes& schema = packets[0];
+    const Bytes expected_schema = {awb::telemetry::kSchemaPacket, awb::telemetry::kVersion, 10, 0, 2, 2,
+                                   1, 7, 'c', 'u', 'r', 'r', 'e', 'n', 't',
+                                   2, 8, 'p', 'o', 's', 'i', 't', 'i', 'o', 'n'};
+    TEST_ASSERT_TRUE(schema == expected_schema);
+
+    const Bytes& samples = packets[1];
+    TEST_ASSERT_EQUAL(awb::telemetry::kSamplesHeaderSize + 2 * 6, samples.size());
+    TEST_ASSERT_EQUAL_HEX8(awb::telemetry::kSamplesPacket, samples[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, samples[1] | (samples[2] << 8));
+    std::uint32_t tick;
+    std::memcpy(&tick, &samples[3], sizeof(tick));
+    TEST_ASSERT_EQUAL_UINT32(1234, tick);
+    TEST_ASSERT_EQUAL_UINT8(2, samples[7]);
+
+    std::int16_t current;
+    std::int32_t position;
+    std::memcpy(&current, &samples[8], sizeof(current));
+    std::memcpy(&position, &samples[10], sizeof(position));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, current);
+    TEST_ASSERT_EQUAL_INT32(-5, position);
+    std::memcpy(&current, &samples[14], sizeof(current));
+    std::memcpy(&position, &samples[16], sizeof(position));
+    TEST_ASSERT_EQUAL_INT16(-7, current);
+    TEST_ASSERT_EQUAL_INT32(0, position);
+}
+
+void test_flush_sends_short_packet_and_counts_sequence() {
+    hal::Uart uart(huart2);
+    Logger::GetInstance().Init(&uart);
+
+    awb::Telemetry<1> telemetry(Logger::GetInstance(), {{{"x", awb::telemetry::SignalType::I32}}}, 1, 4);
+    telemetry.Begin();
+    telemetry.Flush();  // Nothing recorded: nothing sent
+    telemetry.Record({1});
+    telemetry.Flush();
+    telemetry.Record({2});
+    telemetry.Flush();
+
+    const auto packets = ReceivePackets();
+    TEST_ASSERT_EQUAL(3, packets.size());
+    TEST_ASSERT_EQUAL_UINT8(1, packets[1][7]);
+    TEST_ASSERT_EQUAL_UINT16(0, packets[1][1]);
+    TEST_ASSERT_EQUAL_UINT16(1, packets[2][1]);
+}
+
+void test_rows_per_packet_clamped_to_packet_size() {
+    hal::Uart uart(huart2);
+    Logger::GetInstance().Init(&uart);
+
+    // 12 bytes per row: (250 - 8) / 12 = 20 rows fit
+    awb::Telemetry<3> telemetry(Logger::GetInstance(),
+                           {{{"a", awb::telemetry::SignalType::I32},
+                             {"b", awb::telemetry::SignalType::I32},
+                             {"c", awb::telemetry::SignalType::I32}}},
+                           1, 1000);
+    TEST_ASSERT_EQUAL(20, telemetry.GetRowsPerPacket());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cobs_known_answers);
+    RUN_TEST(test_cobs_full_block_has_no_phantom_zero);
+    RUN_TEST(test_cobs_output_has_no_zeros);
+    RUN_TEST(test_crc_check_values);
+    RUN_TEST(test_schema_and_samples_round_trip);
+    RUN_TEST(test_flush_sends_short_packet_and_counts_sequence);
+    RUN_TEST(test_rows_per_packet_clamped_to_packet_size);
+    return UNITY_END();
+}
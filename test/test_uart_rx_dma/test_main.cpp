@@ -0,0 +1,225 @@
+// hal::Uart background reception: circular DMA with idle-line detection on the simulated
+// USART2, frames split across the ring's half, end and wrap, and receive errors.
+
+#include <unity.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hal/uart.hpp"
+#include "sim_hal.hpp"
+#include "usart.h"
+
+namespace {
+
+constexpr std::size_t kRing = 16;
+
+std::uint8_t ring[kRing];
+std::vector<std::string> frames;
+
+void OnFrame(void* /*context*/, const std::uint8_t* frame, std::size_t length) {
+    frames.emplace_back(reinterpret_cast<const char*>(frame), length);
+}
+
+bool Start(hal::Uart& uart) {
+    return uart.StartReceive(ring, kRing, OnFrame, nullptr);
+}
+
+// Distinct bytes so a misplaced copy out of the ring shows up in the frame
+std::string Pattern(std::size_t length, std::size_t seed) {
+    std::string bytes(length, '\0');
+    for (std::size_t i = 0; i < length; ++i) {
+        bytes[i] = static_cast<char>('A' + (seed + i * 7) % 53);
+    }
+    return bytes;
+}
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    MX_USART2_UART_Init();
+    frames.clear();
+}
+
+void tearDown() {}
+
+void test_frame_delivered_on_idle_line() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    sim::ReceiveUart(huart2, "hello\r\n");
+    TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("hello\r\n", frames[0].c_str());
+
+    sim::ReceiveUart(huart2, "world");
+    TEST_ASSERT_EQUAL_UINT32(2, frames.size());
+    TEST_ASSERT_EQUAL_STRING("world", frames[1].c_str());
+
+    const hal::UartRxStats stats = uart.GetRxStats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.frames);
+    TEST_ASSERT_EQUAL_UINT32(12, stats.bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.truncated);
+}
+
+void test_half_ring_is_not_end_of_frame() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    // Crosses the half-transfer point (8 bytes in): still one frame, delivered at the idle
+    const std::string bytes = Pattern(11, 1);
+    sim::ReceiveUart(huart2, bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING(bytes.c_str(), frames[0].c_str());
+}
+
+void test_frame_across_ring_wrap() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    // The second frame starts at offset 10 and wraps past the end of the 16-byte ring
+    const std::string first = Pattern(10, 2);
+    const std::string second = Pattern(12, 3);
+    sim::ReceiveUart(huart2, first);
+    sim::ReceiveUart(huart2, second);
+    TEST_ASSERT_EQUAL_UINT32(2, frames.size());
+    TEST_ASSERT_EQUAL_STRING(first.c_str(), frames[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(second.c_str(), frames[1].c_str());
+}
+
+void test_frame_longer_than_ring() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    // Copied out at every half and end, so the ring only has to cover the interrupt latency
+    const std::string bytes = Pattern(3 * kRing + 5, 4);
+    sim::ReceiveUart(huart2, bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING(bytes.c_str(), frames[0].c_str());
+}
+
+void test_frame_longer_than_frame_buffer_truncated() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    const std::string bytes = Pattern(hal::Uart::kRxFrameSize + 20, 5);
+    sim::ReceiveUart(huart2, bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING(bytes.substr(0, hal::Uart::kRxFrameSize).c_str(), frames[0].c_str());
+
+    // The next frame starts clean
+    sim::ReceiveUart(huart2, "ok");
+    TEST_ASSERT_EQUAL_UINT32(2, frames.size());
+    TEST_ASSERT_EQUAL_STRING("ok", frames[1].c_str());
+
+    const hal::UartRxStats stats = uart.GetRxStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.truncated);
+    TEST_ASSERT_EQUAL_UINT32(hal::Uart::kRxFrameSize + 2, stats.bytes);
+}
+
+void test_frame_ending_at_ring_end_joins_next() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    // No idle event at position 0, so these 16 bytes wait for the next frame's idle
+    const std::string first = Pattern(kRing, 6);
+    sim::ReceiveUart(huart2, first);
+    TEST_ASSERT_EQUAL_UINT32(0, frames.size());
+
+    sim::ReceiveUart(huart2, "next");
+    TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING((first + "next").c_str(), frames[0].c_str());
+}
+
+void test_overrun_drops_partial_frame_and_restarts() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    // Past the half-transfer point, so part of the frame is already copied out
+    sim::ReceiveUart(huart2, Pattern(9, 7), false);
+    sim::RaiseUartError(huart2, HAL_UART_ERROR_ORE);
+    TEST_ASSERT_EQUAL(HAL_UART_STATE_BUSY_RX, huart2.RxState);
+    TEST_ASSERT_EQUAL_UINT32(0, frames.size());
+
+    sim::ReceiveUart(huart2, "after");
+    TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("after", frames[0].c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, uart.GetRxStats().overruns);
+}
+
+void test_line_errors_drop_partial_frame_and_restart() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_TRUE(Start(uart));
+
+    // With DMA reception the HAL aborts on framing, noise and parity errors as on an overrun
+    sim::ReceiveUart(huart2, "lost ", false);
+    sim::RaiseUartError(huart2, HAL_UART_ERROR_FE);
+    TEST_ASSERT_EQUAL(HAL_UART_STATE_BUSY_RX, huart2.RxState);
+    sim::ReceiveUart(huart2, "lost ", false);
+    sim::RaiseUartError(huart2, HAL_UART_ERROR_NE | HAL_UART_ERROR_PE);
+    sim::ReceiveUart(huart2, "lost ", false);
+    sim::RaiseUartError(huart2, HAL_UART_ERROR_PE);
+    TEST_ASSERT_EQUAL(HAL_UART_STATE_BUSY_RX, huart2.RxState);
+
+    sim::ReceiveUart(huart2, "here");
+    TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("here", frames[0].c_str());
+
+    const hal::UartRxStats stats = uart.GetRxStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.framing_errors);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.noise_errors);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.parity_errors);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overruns);
+}
+
+void test_start_receive_rejects_bad_setup() {
+    hal::Uart uart(huart2);
+    TEST_ASSERT_FALSE(uart.StartReceive(nullptr, kRing, OnFrame, nullptr));
+    TEST_ASSERT_FALSE(uart.StartReceive(ring, 1, OnFrame, nullptr));
+    TEST_ASSERT_FALSE(uart.StartReceive(ring, kRing, nullptr, nullptr));
+
+    // A normal-mode channel would stop at the end of the ring
+    huart2.hdmarx->Init.Mode = DMA_NORMAL;
+    TEST_ASSERT_FALSE(Start(uart));
+    huart2.hdmarx = nullptr;
+    TEST_ASSERT_FALSE(Start(uart));
+    TEST_ASSERT_EQUAL(HAL_UART_STATE_READY, huart2.RxState);
+}
+
+void test_stop_receive_drops_partial_frame() {
+    {
+        hal::Uart uart(huart2);
+        TEST_ASSERT_TRUE(Start(uart));
+        sim::ReceiveUart(huart2, "partial", false);
+
+        uart.StopReceive();
+        TEST_ASSERT_EQUAL(HAL_UART_STATE_READY, huart2.RxState);
+        sim::ReceiveUart(huart2, "lost");
+        TEST_ASSERT_EQUAL_UINT32(0, frames.size());
+
+        // Restarts from the top of the ring with an empty frame
+        TEST_ASSERT_TRUE(Start(uart));
+        sim::ReceiveUart(huart2, "again");
+        TEST_ASSERT_EQUAL_UINT32(1, frames.size());
+        TEST_ASSERT_EQUAL_STRING("again", frames[0].c_str());
+    }
+    // The destructor stops reception too
+    TEST_ASSERT_EQUAL(HAL_UART_STATE_READY, huart2.RxState);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_delivered_on_idle_line);
+    RUN_TEST(test_half_ring_is_not_end_of_frame);
+    RUN_TEST(test_frame_across_ring_wrap);
+    RUN_TEST(test_frame_longer_than_ring);
+    RUN_TEST(test_frame_longer_than_frame_buffer_truncated);
+    RUN_TEST(test_frame_ending_at_ring_end_joins_next);
+    RUN_TEST(test_overrun_drops_partial_frame_and_restarts);
+    RUN_TEST(test_line_errors_drop_partial_frame_and_restart);
+    RUN_TEST(test_start_receive_rejects_bad_setup);
+    RUN_TEST(test_stop_receive_drops_partial_frame);
+    return UNITY_END();
+}
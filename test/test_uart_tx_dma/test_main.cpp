@@ -0,0 +1,166 @@
+// hal::Uart in UartMode::Dma: the TX ring (util/ring_buffer.hpp) drained by the
+// simulated DMA, with every half-transfer and transfer-complete interrupt stepped by hand.
+
+#include <unity.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "hal/uart.hpp"
+#include "sim_hal.hpp"
+#include "usart.h"
+
+namespace {
+
+constexpr std::size_t kRing = hal::Uart::kTxBufferSize;
+
+// Distinct, non-repeating-per-ring bytes so a misplaced chunk shows up in the output
+std::string Pattern(std::size_t length, std::size_t seed) {
+    std::string bytes(length, '\0');
+    for (std::size_t i = 0; i < length; ++i) {
+        bytes[i] = static_cast<char>((seed + i * 7) % 251);
+    }
+    return bytes;
+}
+
+void Write(hal::Uart& uart, const std::string& bytes) {
+    uart.Write(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size());
+}
+
+// Completes transfers until the channel goes idle; returns how many there were
+int DrainDma() {
+    int transfers = 0;
+    while (sim::CompleteUartDma(huart2)) {
+        ++transfers;
+    }
+    return transfers;
+}
+
+}  // namespace
+
+void setUp() {
+    sim::Reset();
+    MX_USART2_UART_Init();
+    sim::SetUartDmaAutoComplete(huart2, false);
+}
+
+void tearDown() {}
+
+void test_write_starts_one_transfer() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    Write(uart, "hello");
+
+    TEST_ASSERT_TRUE(sim::UartOutput(huart2).empty());
+    TEST_ASSERT_EQUAL_INT(1, DrainDma());
+    TEST_ASSERT_EQUAL_STRING("hello", sim::UartOutput(huart2).c_str());
+}
+
+void test_wrap_around_splits_into_two_transfers() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    const std::string first = Pattern(400, 1);
+    const std::string second = Pattern(200, 2);  // Crosses the end of the ring
+
+    Write(uart, first);
+    TEST_ASSERT_EQUAL_INT(1, DrainDma());
+    Write(uart, second);
+
+    // DMA cannot wrap: the tail of the ring goes first, the chained transfer takes the rest
+    TEST_ASSERT_EQUAL_INT(2, DrainDma());
+    TEST_ASSERT_TRUE(sim::UartOutput(huart2) == first + second);
+    TEST_ASSERT_EQUAL_UINT32(0, uart.GetDroppedBytes());
+}
+
+void test_full_ring_drops_the_excess() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    const std::string bytes = Pattern(kRing + 88, 3);
+
+    Write(uart, bytes);
+    TEST_ASSERT_EQUAL_UINT32(88, uart.GetDroppedBytes());
+
+    // The whole ring is in flight, so nothing more fits until the DMA releases some
+    Write(uart, "x");
+    TEST_ASSERT_EQUAL_UINT32(89, uart.GetDroppedBytes());
+
+    TEST_ASSERT_EQUAL_INT(1, DrainDma());
+    TEST_ASSERT_TRUE(sim::UartOutput(huart2) == bytes.substr(0, kRing));
+    TEST_ASSERT_TRUE(uart.Flush(0));
+}
+
+void test_half_complete_releases_first_half() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    const std::string first = Pattern(kRing, 4);
+    const std::string refill = Pattern(kRing / 2, 5);
+
+    Write(uart, first);
+    TEST_ASSERT_TRUE(sim::HalfCompleteUartDma(huart2));
+
+    // Exactly the half the DMA has read is free again; one byte more is dropped
+    Write(uart, refill);
+    Write(uart, "x");
+    TEST_ASSERT_EQUAL_UINT32(1, uart.GetDroppedBytes());
+
+    // Overwriting the released half must not corrupt the bytes still being sent
+    TEST_ASSERT_EQUAL_INT(2, DrainDma());
+    TEST_ASSERT_TRUE(sim::UartOutput(huart2) == first + refill);
+}
+
+void test_back_to_back_half_and_complete() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    std::string expected;
+
+    // Half and complete delivered in one go, for even and odd transfer lengths
+    for (std::size_t length : {1U, 2U, 3U, 255U, 300U, 511U}) {
+        const std::string bytes = Pattern(length, length);
+        Write(uart, bytes);
+        expected += bytes;
+        TEST_ASSERT_TRUE(sim::CompleteUartDma(huart2));
+        DrainDma();  // A transfer that reached the end of the ring chains the wrapped rest
+    }
+
+    TEST_ASSERT_TRUE(sim::UartOutput(huart2) == expected);
+    TEST_ASSERT_EQUAL_UINT32(0, uart.GetDroppedBytes());
+    TEST_ASSERT_TRUE(uart.Flush(0));
+}
+
+void test_write_while_in_flight_is_chained() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    Write(uart, "abc");
+
+    // The channel is busy: the bytes wait in the ring rather than restarting the DMA
+    Write(uart, "def");
+    TEST_ASSERT_FALSE(uart.Flush(0));
+    TEST_ASSERT_TRUE(sim::HalfCompleteUartDma(huart2));
+    Write(uart, "ghi");
+    TEST_ASSERT_EQUAL_UINT32(0, uart.GetDroppedBytes());
+
+    TEST_ASSERT_TRUE(sim::CompleteUartDma(huart2));
+    TEST_ASSERT_EQUAL_STRING("abc", sim::UartOutput(huart2).c_str());
+    TEST_ASSERT_EQUAL_INT(1, DrainDma());
+    TEST_ASSERT_EQUAL_STRING("abcdefghi", sim::UartOutput(huart2).c_str());
+    TEST_ASSERT_TRUE(uart.Flush(0));
+}
+
+void test_flush_waits_for_interrupts() {
+    hal::Uart uart(huart2, hal::UartMode::Dma);
+    sim::SetUartDmaAutoComplete(huart2, true);
+    const std::string bytes = Pattern(kRing, 6);
+
+    // Completions arrive at interrupt points, as Flush() polls the tick
+    Write(uart, bytes);
+    Write(uart, bytes.substr(0, 100));
+    TEST_ASSERT_TRUE(uart.Flush(10));
+    TEST_ASSERT_TRUE(sim::UartOutput(huart2) == bytes + bytes.substr(0, 100));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_write_starts_one_transfer);
+    RUN_TEST(test_wrap_around_splits_into_two_transfers);
+    RUN_TEST(test_full_ring_drops_the_excess);
+    RUN_TEST(test_half_complete_releases_first_half);
+    RUN_TEST(test_back_to_back_half_and_complete);
+    RUN_TEST(test_write_while_in_flight_is_chained);
+    RUN_TEST(test_flush_waits_for_interrupts);
+    return UNITY_END();
+}
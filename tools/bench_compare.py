@@ -0,0 +1,75 @@
+"""Compares two benchmark reports (the BENCH,... lines printed by awb::RunBenchmarks()).
+
+Any other console output in the captures is ignored, including deferred log
+frames (AWB_LOG_DEFERRED) that share a line with a result. Exits with status 1 if a
+benchmark's median got slower by more than the threshold, so it can gate CI.
+
+Usage:
+    python tools/bench_compare.py baseline.txt current.txt
+    python tools/bench_compare.py baseline.txt current.txt --threshold 5
+"""
+
+import argparse
+import sys
+
+PREFIX = "BENCH,"
+FIELDS = ("name", "unit", "iterations", "min", "median", "max")
+
+
+def read_report(path):
+    """Returns {name: row} for every result line in a capture."""
+    results = {}
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            start = line.find(PREFIX)
+            if start < 0:
+                continue
+            line = line[start:].strip()
+
+            row = dict(zip(FIELDS, line[len(PREFIX) :].split(",")))
+            if len(row) != len(FIELDS) or row["name"] == "name":
+                continue  # header or truncated line
+
+            for key in ("iterations", "min", "median", "max"):
+                row[key] = int(row[key])
+            results[row["name"]] = row
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="capture from the reference build")
+    parser.add_argument("current", help="capture from the build under test")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed median slowdown in percent")
+    args = parser.parse_args()
+
+    baseline = read_report(args.baseline)
+    current = read_report(args.current)
+
+    regressions = 0
+    print(f"{'benchmark':<24} {'unit':>6} {'base':>8} {'now':>8} {'delta':>8}")
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in current:
+            print(f"{name:<24} {'':>6} {baseline[name]['median']:>8} {'-':>8}  removed")
+            continue
+        if name not in baseline:
+            print(f"{name:<24} {current[name]['unit']:>6} {'-':>8} {current[name]['median']:>8}  new")
+            continue
+
+        old, new = baseline[name], current[name]
+        if old["unit"] != new["unit"]:
+            print(f"{name:<24} unit changed ({old['unit']} -> {new['unit']}), not compared")
+            continue
+
+        delta = 100.0 * (new["median"] - old["median"]) / max(old["median"], 1)
+        flag = ""
+        if delta > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<24} {new['unit']:>6} {old['median']:>8} {new['median']:>8} {delta:>+7.1f}%{flag}")
+
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+"""Host-side decoder for deferred (AWB_LOG_DEFERRED) log output.
+
+Reads the `.awb_log_fmt` section out of the firmware ELF, then decodes the
+binary frames emitted by AWB_LOGF() back into text. Bytes outside a frame are
+regular Logger text and are passed through unchanged.
+
+Usage:
+    python tools/log_decoder.py firmware.elf --port /dev/ttyACM0
+    python tools/log_decoder.py firmware.elf < capture.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FMT_SECTION = ".awb_log_fmt"
+FRAME_MARKER = 0xFF
+HEADER_SIZE = 4
+
+# printf conversion: flags, width, precision, length modifier, conversion
+SPEC_RE = re.compile(r"%([-+ #0]*)(\d+)?(?:\.(\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXeEfgGcsp%])")
+
+
+def read_format_section(elf_path):
+    """Returns the raw bytes of the format-string section (ELF32, little-endian)."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF" or elf[4] != 1:
+        raise ValueError(f"{elf_path} is not a 32-bit ELF file")
+
+    e_shoff, = struct.unpack_from("<I", elf, 0x20)
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+
+    def section(index):
+        # name, type, flags, addr, offset, size
+        return struct.unpack_from("<IIIIII", elf, e_shoff + index * e_shentsize)
+
+    strtab = section(e_shstrndx)
+    for i in range(e_shnum):
+        name_off, _, _, _, offset, size = section(i)
+        start = strtab[4] + name_off
+        name = elf[start : elf.index(b"\0", start)].decode()
+        if name == FMT_SECTION:
+            return elf[offset : offset + size]
+
+    raise ValueError(f"{elf_path} has no {FMT_SECTION} section (built without AWB_LOG_DEFERRED?)")
+
+
+def format_record(fmt, payload):
+    """Expands one printf-style format string using the encoded argument bytes."""
+    out = []
+    pos = 0
+    last = 0
+
+    for m in SPEC_RE.finditer(fmt):
+        out.append(fmt[last : m.start()])
+        last = m.end()
+        flags, width, precision, length, conv = m.groups()
+
+        if conv == "%":
+            out.append("%")
+            continue
+
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+        try:
+            if conv == "s":
+                n = payload[pos]
+                if pos + 1 + n > len(payload):
+                    raise IndexError
+                value = payload[pos + 1 : pos + 1 + n].decode(errors="replace")
+                pos += 1 + n
+                out.append((spec + "s") % value)
+            elif conv in "eEfgG":
+                value, = struct.unpack_from("<d", payload, pos)
+                pos += 8
+                out.append((spec + conv) % value)
+            else:
+                wide = length in ("ll", "j")
+                signed = conv in "di"
+                code = ("<q" if signed else "<Q") if wide else ("<i" if signed else "<I")
+                value, = struct.unpack_from(code, payload, pos)
+                pos += 8 if wide else 4
+                if conv == "p":
+                    out.append(f"0x{value:08x}")
+                elif conv == "c":
+                    out.append((spec + "c") % chr(value & 0xFF))
+                else:
+                    out.append((spec + ("d" if conv in "iu" else conv)) % value)
+        except (IndexError, struct.error):
+            out.append("<truncated>")
+            return "".join(out)
+
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode_stream(read_byte, formats, write):
+    """Decodes frames from a byte source until it is exhausted."""
+    while True:
+        b = read_byte()
+        if b is None:
+            return
+        if b != FRAME_MARKER:
+            write(chr(b))
+            continue
+
+        header = [read_byte() for _ in range(HEADER_SIZE - 1)]
+        if None in header:
+            return
+        fmt_id = header[0] | (header[1] << 8)
+        payload = bytes(read_byte() or 0 for _ in range(header[2]))
+
+        if fmt_id >= len(formats):
+            write(f"<unknown log id {fmt_id}>\r\n")
+            continue
+        fmt = formats[fmt_id : formats.index(b"\0", fmt_id)].decode(errors="replace")
+        write(format_record(fmt, payload))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF built with AWB_LOG_DEFERRED")
+    parser.add_argument("--port", help="serial port to read from (default: stdin)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    formats = read_format_section(args.elf)
+
+    if args.port:
+        import serial  # pyserial ships with PlatformIO
+
+        source = serial.Serial(args.port, args.baud)
+    else:
+        source = sys.stdin.buffer
+
+    def read_byte():
+        data = source.read(1)
+        return data[0] if data else None
+
+    def write(text):
+        sys.stdout.write(text)
+        sys.stdout.flush()
+
+    try:
+        decode_stream(read_byte, formats, write)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,214 @@
+"""Host-side decoder for binary telemetry (include/util/telemetry.hpp).
+
+Picks the COBS-framed telemetry packets out of the console stream, checks their
+CRC-16 and sequence numbers, and prints the samples as teleplot lines
+(`>name:timestamp_ms:value`). Everything else (Logger text and deferred
+AWB_LOGF frames) is passed through unchanged, so the output can be piped into
+log_decoder.py.
+
+When reading a serial port, the schema is requested ("schema" console command)
+at startup and whenever samples arrive before one. CRC failures and lost
+packets are counted on stderr.
+
+Usage:
+    python tools/telemetry_decoder.py --port /dev/ttyACM0
+    python tools/telemetry_decoder.py --port /dev/ttyACM0 | python tools/log_decoder.py firmware.elf
+    python tools/telemetry_decoder.py < capture.bin
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+DELIMITER = 0x00
+LOG_FRAME_MARKER = 0xFF  # Deferred log frame: [0xFF][id lo][id hi][length][payload]
+LOG_HEADER_SIZE = 4
+
+VERSION = 1
+SCHEMA_PACKET = 0x01
+SAMPLES_PACKET = 0x02
+MAX_FRAME_SIZE = 260  # COBS of the largest packet plus its CRC, with margin
+SCHEMA_RETRY_S = 1.0
+
+TYPES = {1: "<h", 2: "<i"}  # SignalType -> struct code
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as awb::Crc16()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Reverses awb::CobsEncode(); returns None for a malformed frame."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1 : i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    """Turns packets into teleplot lines and keeps link statistics."""
+
+    def __init__(self, write, request_schema=None):
+        self.write = write
+        self.request_schema = request_schema
+        self.signals = None  # [(name, struct code)]
+        self.period_ms = 0
+        self.next_sequence = None
+        self.last_request = None
+        self.packets = 0
+        self.crc_errors = 0
+        self.lost = 0
+
+    def packet(self, frame):
+        data = cobs_decode(frame)
+        if data is None or len(data) < 3:
+            self.crc_errors += 1
+            return
+        body, crc = data[:-2], struct.unpack_from("<H", data, len(data) - 2)[0]
+        if crc16(body) != crc:
+            self.crc_errors += 1
+            return
+        self.packets += 1
+
+        if body[0] == SCHEMA_PACKET:
+            self.schema(body)
+        elif body[0] == SAMPLES_PACKET:
+            self.samples(body)
+
+    def schema(self, body):
+        version, self.period_ms, rows, count = struct.unpack_from("<BHBB", body, 1)
+        if version != VERSION:
+            sys.stderr.write(f"[telemetry] unsupported schema version {version}\n")
+            return
+        signals = []
+        pos = 6
+        for _ in range(count):
+            kind, length = body[pos], body[pos + 1]
+            name = body[pos + 2 : pos + 2 + length].decode(errors="replace")
+            pos += 2 + length
+            signals.append((name, TYPES.get(kind)))
+        self.signals = signals
+        self.next_sequence = None
+        names = ", ".join(name for name, _ in signals)
+        sys.stderr.write(f"[telemetry] schema: {names} every {self.period_ms} ms, {rows} rows/packet\n")
+
+    def samples(self, body):
+        if self.signals is None or None in (code for _, code in self.signals):
+            now = time.monotonic()
+            if self.request_schema and (self.last_request is None or now - self.last_request > SCHEMA_RETRY_S):
+                self.last_request = now
+                self.request_schema()
+            return
+
+        sequence, tick, rows = struct.unpack_from("<HIB", body, 1)
+        if self.next_sequence is not None and sequence != self.next_sequence:
+            self.lost += (sequence - self.next_sequence) & 0xFFFF
+        self.next_sequence = (sequence + 1) & 0xFFFF
+
+        pos = 8
+        lines = []
+        try:
+            for row in range(rows):
+                timestamp = tick + row * self.period_ms
+                for name, code in self.signals:
+                    value, = struct.unpack_from(code, body, pos)
+                    pos += struct.calcsize(code)
+                    lines.append(f">{name}:{timestamp}:{value}\r\n")
+        except struct.error:
+            # The CRC passed, so the schema is stale (firmware changed); ask again
+            self.signals = None
+            return
+        self.write("".join(lines).encode())
+
+    def summary(self):
+        return f"[telemetry] packets={self.packets} crc_errors={self.crc_errors} lost={self.lost}\n"
+
+
+def decode_stream(read_byte, decoder, passthrough):
+    """Splits a byte source into packets and pass-through bytes until it is exhausted."""
+    frame = None  # Bytes of the packet being received, or None outside one
+    while True:
+        b = read_byte()
+        if b is None:
+            return
+
+        if frame is not None:
+            if b != DELIMITER:
+                frame.append(b)
+                if len(frame) > MAX_FRAME_SIZE:
+                    # Not a packet after all (or a lost delimiter): give the bytes back
+                    passthrough(bytes(frame))
+                    frame = None
+            elif frame:
+                decoder.packet(bytes(frame))
+                frame = None
+            # else: an opening delimiter right after a closing one
+            continue
+
+        if b == DELIMITER:
+            frame = bytearray()
+        elif b == LOG_FRAME_MARKER:
+            # Deferred log payloads may hold zeros; copy the frame whole
+            header = [read_byte() for _ in range(LOG_HEADER_SIZE - 1)]
+            if None in header:
+                return
+            payload = bytes(read_byte() or 0 for _ in range(header[2]))
+            passthrough(bytes([b] + header) + payload)
+        else:
+            passthrough(bytes([b]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", help="serial port to read from (default: stdin)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    out = sys.stdout.buffer
+
+    def write(data):
+        out.write(data)
+        out.flush()
+
+    request_schema = None
+    if args.port:
+        import serial  # pyserial ships with PlatformIO
+
+        source = serial.Serial(args.port, args.baud)
+
+        def request_schema():
+            source.write(b"schema\n")
+
+        request_schema()
+    else:
+        source = sys.stdin.buffer
+
+    def read_byte():
+        data = source.read(1)
+        return data[0] if data else None
+
+    decoder = Decoder(write, request_schema)
+    try:
+        decode_stream(read_byte, decoder, write)
+    except KeyboardInterrupt:
+        pass
+    sys.stderr.write(decoder.summary())
+
+
+if __name__ == "__main__":
+    main()